@@ -0,0 +1,284 @@
+// 后端对比基准：同一台机器上分别以旧版 PollServer、epoll 与 io_uring 后端启动服务器，每个客户端逐个发送请求，
+// 比较吞吐、延迟分位数以及服务器线程每个请求的系统调用次数。
+// 旧版服务器每个响应之后关闭连接，它的客户端每个请求新建一个连接，延迟包含建立连接，作为改造之前的基线
+// 构建：cmake -S . -B build -DCMAKE_BUILD_TYPE=Release && cmake --build build --target http-backend-benchmark
+// 运行：./build/http-backend-benchmark [客户端数] [每个客户端的请求数]
+// 系统调用通过 raw_syscalls:sys_enter 跟踪点计数，需要可读的 tracefs 与 perf_event_paranoid 允许，否则显示 n/a
+#include <algorithm>
+#include <arpa/inet.h>
+#include <atomic>
+#include <cctype>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <linux/perf_event.h>
+#include <memory>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <string>
+#include <string_view>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+#include "HttpServer.h"
+#include "PollServer.h"
+#include "spdlog/spdlog.h"
+
+namespace {
+    using v1_taskbar_manager::PollServer;
+    using v2_taskbar_manager::HttpServer;
+    using v2_taskbar_manager::HttpServerOptions;
+
+    constexpr char kHtml[] = "<!DOCTYPE html><html><body>benchmark</body></html>";
+
+    enum class Backend { Poll, Epoll, IoUring };
+
+    constexpr std::string_view kRequest = "GET / HTTP/1.1\r\nHost: 127.0.0.1\r\n\r\n";
+
+    struct Result {
+        double seconds = 0;
+        size_t requests = 0;
+        long long syscalls = -1;
+        std::vector<uint64_t> latencies;
+    };
+
+    /**
+     * @brief 打开统计本线程及之后创建的线程的系统调用次数的计数器
+     * @return int 计数器描述符，不可用时返回 -1
+     * @note inherit 只覆盖打开之后创建的线程，客户端线程需要在此之前创建；
+     * 子线程的计数在线程退出时才累加到父计数器，因此要在服务器停止之后读取
+     */
+    int OpenSyscallCounter() {
+        unsigned long long id = 0;
+        for (const char *path : {"/sys/kernel/tracing/events/raw_syscalls/sys_enter/id",
+                                 "/sys/kernel/debug/tracing/events/raw_syscalls/sys_enter/id"}) {
+            if (FILE *file = std::fopen(path, "r")) {
+                const int matched = std::fscanf(file, "%llu", &id);
+                std::fclose(file);
+                if (matched == 1) {
+                    break;
+                }
+            }
+        }
+        if (id == 0) {
+            return -1;
+        }
+        perf_event_attr attr{};
+        attr.type = PERF_TYPE_TRACEPOINT;
+        attr.size = sizeof(attr);
+        attr.config = id;
+        attr.inherit = 1;
+        return static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+    }
+
+    int Connect(const int port) {
+        const int socket = ::socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+        constexpr int noDelay = 1;
+        setsockopt(socket, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        address.sin_port = htons(port);
+        if (connect(socket, reinterpret_cast<sockaddr *>(&address), sizeof(address)) < 0) {
+            close(socket);
+            return -1;
+        }
+        return socket;
+    }
+
+    /**
+     * @brief 读取一个完整的响应
+     * @return 连接被关闭或响应格式错误时返回 false
+     */
+    bool ReadResponse(const int socket, std::string &buffer) {
+        buffer.clear();
+        size_t total = std::string::npos;
+        char chunk[4096];
+        while (total == std::string::npos || buffer.size() < total) {
+            const ssize_t count = recv(socket, chunk, sizeof(chunk), 0);
+            if (count <= 0) {
+                return false;
+            }
+            buffer.append(chunk, static_cast<size_t>(count));
+            if (total == std::string::npos) {
+                const size_t headerEnd = buffer.find("\r\n\r\n");
+                const size_t lengthAt = buffer.find("Content-Length: ");
+                if (headerEnd == std::string::npos) {
+                    continue;
+                }
+                if (lengthAt == std::string::npos || lengthAt > headerEnd) {
+                    return false;
+                }
+                total = headerEnd + 4 + std::strtoull(buffer.c_str() + lengthAt + 16, nullptr, 10);
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief 启动服务器并运行一轮
+     * @param backend 旧版 PollServer，或新版服务器的 epoll、io_uring 后端
+     * @param connections 客户端数
+     * @param requestsPerConnection 每个客户端的请求数；PollServer 的客户端每个请求新建一个连接
+     */
+    Result Run(const Backend backend, const size_t connections, const size_t requestsPerConnection) {
+        const bool reconnect = backend == Backend::Poll;
+        std::atomic<int> port{0};
+        std::atomic<bool> failed{false};
+        std::vector<std::vector<uint64_t>> latencies(connections);
+        std::vector<std::thread> clients;
+        for (size_t i = 0; i < connections; i++) {
+            clients.emplace_back([&, i] {
+                while (port.load() == 0) {
+                    std::this_thread::yield();
+                }
+                int socket = reconnect ? -1 : Connect(port.load());
+                if (!reconnect && socket < 0) {
+                    failed = true;
+                    return;
+                }
+                std::string buffer;
+                latencies[i].reserve(requestsPerConnection);
+                for (size_t n = 0; n < requestsPerConnection; n++) {
+                    const auto begin = std::chrono::steady_clock::now();
+                    if (reconnect && (socket = Connect(port.load())) < 0) {
+                        failed = true;
+                        break;
+                    }
+                    if (send(socket, kRequest.data(), kRequest.size(), MSG_NOSIGNAL) < 0 ||
+                        !ReadResponse(socket, buffer)) {
+                        failed = true;
+                        break;
+                    }
+                    latencies[i].push_back(static_cast<uint64_t>(
+                        std::chrono::duration_cast<std::chrono::nanoseconds>(
+                            std::chrono::steady_clock::now() - begin).count()));
+                    if (reconnect) {
+                        close(socket);
+                        socket = -1;
+                    }
+                }
+                if (socket >= 0) {
+                    close(socket);
+                }
+            });
+        }
+
+        // 客户端线程已经创建，之后打开的计数器只统计服务器线程与本线程
+        const int counter = OpenSyscallCounter();
+        HttpServerOptions options;
+        options.workerThreads = 1;
+        options.useIoUring = backend == Backend::IoUring;
+        options.maxRequestsPerConnection = requestsPerConnection;
+        std::unique_ptr<PollServer> pollServer;
+        std::unique_ptr<HttpServer> server;
+        int actualPort;
+        if (backend == Backend::Poll) {
+            pollServer = std::make_unique<PollServer>(kHtml, options);
+            actualPort = pollServer->Start(0);
+        } else {
+            server = std::make_unique<HttpServer>(options);
+            actualPort = server->Start(kHtml, 0);
+        }
+        if (actualPort < 0) {
+            std::fprintf(stderr, "服务器启动失败\n");
+            std::exit(1);
+        }
+
+        const auto begin = std::chrono::steady_clock::now();
+        port = actualPort;
+        for (std::thread &client : clients) {
+            client.join();
+        }
+        Result result;
+        result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+        if (pollServer) {
+            pollServer->Stop();
+        } else {
+            server->Stop();
+        }
+        if (failed) {
+            std::fprintf(stderr, "请求失败\n");
+            std::exit(1);
+        }
+
+        if (counter >= 0) {
+            long long value = 0;
+            if (read(counter, &value, sizeof(value)) == sizeof(value)) {
+                result.syscalls = value;
+            }
+            close(counter);
+        }
+        for (const std::vector<uint64_t> &items : latencies) {
+            result.latencies.insert(result.latencies.end(), items.begin(), items.end());
+        }
+        std::sort(result.latencies.begin(), result.latencies.end());
+        result.requests = result.latencies.size();
+        return result;
+    }
+
+    double Percentile(const std::vector<uint64_t> &sorted, const double p) {
+        if (sorted.empty()) {
+            return 0;
+        }
+        const auto index = std::min(sorted.size() - 1, static_cast<size_t>(p * static_cast<double>(sorted.size())));
+        return static_cast<double>(sorted[index]) / 1000.0;
+    }
+
+    void Print(const char *name, const Result &result) {
+        char syscalls[32] = "n/a";
+        if (result.syscalls >= 0) {
+            std::snprintf(syscalls, sizeof(syscalls), "%.2f",
+                          static_cast<double>(result.syscalls) / static_cast<double>(result.requests));
+        }
+        std::printf("%-10s %10zu %12.0f %10.1f %10.1f %10.1f %14s\n", name, result.requests,
+                    static_cast<double>(result.requests) / result.seconds, Percentile(result.latencies, 0.5),
+                    Percentile(result.latencies, 0.99), Percentile(result.latencies, 0.999), syscalls);
+    }
+
+    /**
+     * @brief 解析命令行中的数量参数
+     * @param text 参数文本
+     * @param value 解析结果
+     * @return 不是十进制正整数或超出范围时返回 false
+     */
+    bool ParseCount(const char *text, size_t &value) {
+        if (!std::isdigit(static_cast<unsigned char>(text[0]))) {
+            return false;
+        }
+        errno = 0;
+        char *end = nullptr;
+        const unsigned long long parsed = std::strtoull(text, &end, 10);
+        if (*end != '\0' || errno == ERANGE || parsed == 0 || parsed > SIZE_MAX) {
+            return false;
+        }
+        value = static_cast<size_t>(parsed);
+        return true;
+    }
+}
+
+int main(const int argc, char **argv) {
+    size_t connections = 8;
+    size_t requests = 20000;
+    if (argc > 3 || (argc > 1 && !ParseCount(argv[1], connections)) ||
+        (argc > 2 && !ParseCount(argv[2], requests))) {
+        std::fprintf(stderr, "用法: %s [客户端数] [每个客户端的请求数]，均为正整数\n", argv[0]);
+        return 1;
+    }
+    spdlog::set_level(spdlog::level::warn);
+
+    std::printf("%zu 个客户端，每个客户端 %zu 个请求，服务器 1 个工作线程；poll 为旧版服务器，每个请求新建连接\n",
+                connections, requests);
+    std::printf("%-10s %10s %12s %10s %10s %10s %14s\n", "backend", "requests", "req/s", "p50 us", "p99 us",
+                "p99.9 us", "syscalls/req");
+    Print("poll", Run(Backend::Poll, connections, requests));
+    Print("epoll", Run(Backend::Epoll, connections, requests));
+    Print("io_uring", Run(Backend::IoUring, connections, requests));
+    return 0;
+}
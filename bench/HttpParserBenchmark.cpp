@@ -0,0 +1,144 @@
+// 请求解析微基准：比较旧的 find + istringstream 解析方式与增量解析器的单次请求开销
+// 构建：cmake -S . -B build -DCMAKE_BUILD_TYPE=Release && cmake --build build --target http-parser-benchmark
+// 运行：./build/http-parser-benchmark [迭代次数]
+#include <cctype>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+#include <string_view>
+
+#include "HttpRequestParser.h"
+
+namespace {
+    using v2_taskbar_manager::HttpParseResult;
+    using v2_taskbar_manager::HttpRequestParser;
+
+    // WebView2 打开页面时发出的典型请求
+    constexpr std::string_view kRequest =
+            "GET /index.html HTTP/1.1\r\n"
+            "Host: 127.0.0.1:51234\r\n"
+            "Connection: keep-alive\r\n"
+            "sec-ch-ua: \"Microsoft Edge WebView2\";v=\"141\", \"Chromium\";v=\"141\"\r\n"
+            "sec-ch-ua-mobile: ?0\r\n"
+            "sec-ch-ua-platform: \"Windows\"\r\n"
+            "Upgrade-Insecure-Requests: 1\r\n"
+            "User-Agent: Mozilla/5.0 (Windows NT 10.0; Win64; x64) AppleWebKit/537.36 (KHTML, like Gecko) "
+            "Chrome/141.0.0.0 Safari/537.36 Edg/141.0.0.0\r\n"
+            "Accept: text/html,application/xhtml+xml,application/xml;q=0.9,image/avif,image/webp,*/*;q=0.8\r\n"
+            "Sec-Fetch-Site: none\r\n"
+            "Sec-Fetch-Mode: navigate\r\n"
+            "Sec-Fetch-Dest: document\r\n"
+            "Accept-Encoding: gzip, deflate, br, zstd\r\n"
+            "Accept-Language: zh-CN,zh;q=0.9,en;q=0.8\r\n"
+            "If-None-Match: \"ae6831fed4f78bab-gzip\"\r\n"
+            "\r\n";
+
+    // 防止编译器把结果当作无用计算优化掉
+    volatile size_t sink;
+
+    /**
+     * @brief 旧的解析方式：追加到 std::string，查找请求头结尾，用 istringstream 拆分请求行，逐行查找头部
+     */
+    void ParseLegacy(const std::string_view chunk, std::string &requestData) {
+        requestData.append(chunk.data(), chunk.size());
+        const size_t headerEnd = requestData.find("\r\n\r\n");
+        if (headerEnd == std::string::npos) {
+            return;
+        }
+        const size_t lineEnd = requestData.find("\r\n");
+        const std::string requestLine = requestData.substr(0, lineEnd);
+        std::istringstream iss(requestLine);
+        std::string method, path, protocol;
+        iss >> method >> path >> protocol;
+
+        std::string_view headers = std::string_view(requestData).substr(lineEnd + 2, headerEnd - lineEnd);
+        size_t found = 0;
+        while (!headers.empty()) {
+            const size_t end = headers.find("\r\n");
+            if (headers.substr(0, end).rfind("Connection:", 0) == 0) {
+                found++;
+            }
+            headers = end == std::string_view::npos ? std::string_view() : headers.substr(end + 2);
+        }
+        sink = method.size() + path.size() + protocol.size() + found;
+        requestData.erase(0, headerEnd + 4);
+    }
+
+    template <typename Fn>
+    void Run(const char *name, const size_t iterations, Fn &&fn) {
+        // 预热，使缓冲区容量与分支预测进入稳定状态
+        for (size_t i = 0; i < iterations / 10; i++) {
+            fn();
+        }
+        const auto begin = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < iterations; i++) {
+            fn();
+        }
+        const auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - begin);
+        std::printf("%-36s %10.1f ns/request %10.1f MB/s\n", name, elapsed.count() / iterations,
+                    kRequest.size() * iterations / (elapsed.count() / 1e9) / 1e6);
+    }
+
+    /**
+     * @brief 解析命令行中的数量参数
+     * @param text 参数文本
+     * @param value 解析结果
+     * @return 不是十进制正整数或超出范围时返回 false
+     */
+    bool ParseCount(const char *text, size_t &value) {
+        if (!std::isdigit(static_cast<unsigned char>(text[0]))) {
+            return false;
+        }
+        errno = 0;
+        char *end = nullptr;
+        const unsigned long long parsed = std::strtoull(text, &end, 10);
+        if (*end != '\0' || errno == ERANGE || parsed == 0 || parsed > SIZE_MAX) {
+            return false;
+        }
+        value = static_cast<size_t>(parsed);
+        return true;
+    }
+}
+
+int main(int argc, char **argv) {
+    size_t iterations = 1000000;
+    if (argc > 2 || (argc > 1 && !ParseCount(argv[1], iterations))) {
+        std::fprintf(stderr, "用法: %s [迭代次数]，迭代次数为正整数\n", argv[0]);
+        return 1;
+    }
+    std::printf("request size: %zu bytes, iterations: %zu\n", kRequest.size(), iterations);
+
+    std::string requestData;
+    Run("legacy (single recv)", iterations, [&] {
+        ParseLegacy(kRequest, requestData);
+    });
+
+    Run("legacy (3 recv chunks)", iterations, [&] {
+        ParseLegacy(kRequest.substr(0, 100), requestData);
+        ParseLegacy(kRequest.substr(100, 300), requestData);
+        ParseLegacy(kRequest.substr(400), requestData);
+    });
+
+    HttpRequestParser parser;
+    Run("parser (single recv, in place)", iterations, [&] {
+        parser.Reset();
+        if (parser.Parse(kRequest) == HttpParseResult::Complete) {
+            sink = parser.Request().Header("Connection").size() + parser.Request().path.size();
+        }
+    });
+
+    // 分块到达时解析器从上次停止的位置继续，每个字节只扫描一次
+    Run("parser (3 recv chunks, resumed)", iterations, [&] {
+        parser.Reset();
+        parser.Parse(kRequest.substr(0, 100));
+        parser.Parse(kRequest.substr(0, 400));
+        if (parser.Parse(kRequest) == HttpParseResult::Complete) {
+            sink = parser.Request().Header("Connection").size() + parser.Request().path.size();
+        }
+    });
+    return 0;
+}
@@ -0,0 +1,759 @@
+// 负载生成基准：在进程内以回环地址的临时端口启动 HttpServer，按配置的连接数、管线深度、请求组合与是否保持连接施加负载，
+// 报告吞吐与延迟分位数，并与保存的基线比较，便于每次修改服务器之后在 Linux CI 上测量
+// 构建：cmake -S . -B build -DCMAKE_BUILD_TYPE=Release && cmake --build build --target http-load-benchmark
+// 运行：./build/http-load-benchmark [--选项=值 ...]，--help 列出全部选项
+// 闭环负载下每个连接收到响应后立即补发请求，保持 depth 个请求在途；开环负载按 rate 的固定速率发送，
+// 延迟从计划发送的时刻算起，服务器变慢时排队的时间也计入延迟（不受协调遗漏影响）。
+// 延迟记录在对数分桶的直方图中（与 HdrHistogram 相同的分桶方式，相对误差小于 1%）。
+// 指定 --baseline 时吞吐下降或 p50 上升超过 tolerance 则以 2 退出；尾部延迟在共享的 CI 机器上波动较大，只报告变化
+#include <algorithm>
+#include <arpa/inet.h>
+#include <array>
+#include <atomic>
+#include <cctype>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <fcntl.h>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <random>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+#include "HttpServer.h"
+#include "spdlog/spdlog.h"
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+    using v2_taskbar_manager::HttpApiRequest;
+    using v2_taskbar_manager::HttpServer;
+    using v2_taskbar_manager::HttpServerOptions;
+
+    struct Config {
+        size_t connections = 64;
+        size_t depth = 1;
+        bool keepAlive = true;
+        bool openLoop = false;
+        double rate = 20000;
+        double duration = 5;
+        double warmup = 1;
+        std::string mix = "GET /=8,GET /missing=1,GET /api/ping=1";
+        size_t bodySize = 2048;
+        bool useIoUring = false;
+        size_t workers = 1;
+        size_t clientThreads = 2;
+        std::string baseline;
+        std::string saveBaseline;
+        double tolerance = 0.15;
+
+        /**
+         * @brief 影响结果的配置，写入基线，比较时不一致则不判定
+         */
+        std::string Describe() const {
+            std::ostringstream stream;
+            stream << "connections=" << connections << " depth=" << depth << " keep-alive=" << (keepAlive ? "on" : "off")
+                   << " mode=" << (openLoop ? "open" : "closed");
+            if (openLoop) {
+                stream << " rate=" << rate;
+            }
+            stream << " mix=" << mix << " body-size=" << bodySize << " backend=" << (useIoUring ? "uring" : "epoll")
+                   << " workers=" << workers;
+            return stream.str();
+        }
+    };
+
+    /**
+     * @brief 对数分桶的延迟直方图（纳秒）
+     * @note 小于 256 的值各占一个桶；更大的值按 2 的幂分段，每段再线性分为 128 个桶，
+     * 桶宽与值之比不超过 1/128，记录与合并都是 O(1) 且不分配内存
+     */
+    class LatencyHistogram {
+        static constexpr int kSubBits = 7;
+        static constexpr uint64_t kLinear = uint64_t{1} << (kSubBits + 1);
+        static constexpr size_t kBuckets = kLinear + (64 - kSubBits - 1) * (kLinear / 2);
+
+        std::array<uint64_t, kBuckets> counts{};
+        uint64_t total = 0;
+        uint64_t max = 0;
+        long double sum = 0;
+
+        static size_t Index(const uint64_t value) {
+            if (value < kLinear) {
+                return static_cast<size_t>(value);
+            }
+            const int magnitude = 63 - __builtin_clzll(value);
+            const int shift = magnitude - kSubBits;
+            const uint64_t sub = value >> shift;
+            return static_cast<size_t>(kLinear + static_cast<uint64_t>(magnitude - kSubBits - 1) * (kLinear / 2) +
+                                       (sub - kLinear / 2));
+        }
+
+        // 桶内最大的值，分位数按它报告，不会低估延迟
+        static uint64_t UpperBound(const size_t index) {
+            if (index < kLinear) {
+                return index;
+            }
+            const uint64_t offset = index - kLinear;
+            const int shift = static_cast<int>(offset / (kLinear / 2)) + 1;
+            const uint64_t sub = offset % (kLinear / 2) + kLinear / 2;
+            return ((sub + 1) << shift) - 1;
+        }
+
+    public:
+        void Record(const uint64_t nanoseconds) {
+            counts[Index(nanoseconds)]++;
+            total++;
+            max = std::max(max, nanoseconds);
+            sum += nanoseconds;
+        }
+
+        void Merge(const LatencyHistogram &other) {
+            for (size_t i = 0; i < kBuckets; i++) {
+                counts[i] += other.counts[i];
+            }
+            total += other.total;
+            max = std::max(max, other.max);
+            sum += other.sum;
+        }
+
+        uint64_t Count() const { return total; }
+
+        double MaxMicroseconds() const { return static_cast<double>(max) / 1000.0; }
+
+        double MeanMicroseconds() const { return total == 0 ? 0 : static_cast<double>(sum / total) / 1000.0; }
+
+        double PercentileMicroseconds(const double percentile) const {
+            if (total == 0) {
+                return 0;
+            }
+            const auto rank = static_cast<uint64_t>(std::ceil(percentile / 100.0 * static_cast<double>(total)));
+            uint64_t seen = 0;
+            for (size_t i = 0; i < kBuckets; i++) {
+                seen += counts[i];
+                if (seen >= std::max<uint64_t>(rank, 1)) {
+                    return static_cast<double>(std::min(UpperBound(i), max)) / 1000.0;
+                }
+            }
+            return static_cast<double>(max) / 1000.0;
+        }
+    };
+
+    struct ThreadResult {
+        LatencyHistogram latencies;
+        uint64_t status2xx = 0;
+        uint64_t status4xx = 0;
+        uint64_t status5xx = 0;
+        uint64_t errors = 0;
+        uint64_t connects = 0;
+    };
+
+    struct Connection {
+        int socket = -1;
+        std::string recvBuffer;
+        std::string sendBuffer;
+        size_t sendOffset = 0;
+        bool wantWrite = false;
+        // 在途请求的开始时刻，开环负载下为计划发送的时刻
+        std::deque<Clock::time_point> inflight;
+        Clock::time_point nextSend;
+        size_t nextRequest = 0;
+    };
+
+    /**
+     * @brief 解析 "方法 路径=权重,..." 形式的请求组合，按权重展开并以固定种子打乱，各连接从不同位置循环使用
+     */
+    std::vector<std::string> BuildRequests(const Config &config, const int port) {
+        std::vector<std::string> sequence;
+        std::stringstream items(config.mix);
+        for (std::string item; std::getline(items, item, ',');) {
+            const size_t equals = item.rfind('=');
+            const size_t space = item.find(' ');
+            if (space == std::string::npos || space > equals) {
+                std::fprintf(stderr, "无法解析请求组合中的 \"%s\"\n", item.c_str());
+                std::exit(1);
+            }
+            const std::string method = item.substr(0, space);
+            const std::string path = equals == std::string::npos ? item.substr(space + 1)
+                                                                  : item.substr(space + 1, equals - space - 1);
+            const size_t weight = equals == std::string::npos ? 1 : std::strtoul(item.c_str() + equals + 1, nullptr, 10);
+            // API 只接受 Host 为本机地址与监听端口的请求
+            std::string request =
+                method + " " + path + " HTTP/1.1\r\nHost: 127.0.0.1:" + std::to_string(port) + "\r\n";
+            if (method != "GET" && method != "HEAD") {
+                request += "Content-Length: 0\r\n";
+            }
+            if (!config.keepAlive) {
+                request += "Connection: close\r\n";
+            }
+            request += "\r\n";
+            sequence.insert(sequence.end(), weight, request);
+        }
+        if (sequence.empty()) {
+            std::fprintf(stderr, "请求组合为空\n");
+            std::exit(1);
+        }
+        std::shuffle(sequence.begin(), sequence.end(), std::mt19937(1));
+        return sequence;
+    }
+
+    int Connect(const int port) {
+        const int socket = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, IPPROTO_TCP);
+        constexpr int noDelay = 1;
+        setsockopt(socket, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        address.sin_port = htons(port);
+        if (connect(socket, reinterpret_cast<sockaddr *>(&address), sizeof(address)) < 0) {
+            close(socket);
+            return -1;
+        }
+        fcntl(socket, F_SETFL, fcntl(socket, F_GETFL) | O_NONBLOCK);
+        return socket;
+    }
+
+    /**
+     * @brief 一个负载线程驱动的一组连接
+     */
+    class LoadThread {
+        const Config &config;
+        const std::vector<std::string> &requests;
+        const int port;
+        const Clock::time_point measureFrom;
+        const Clock::time_point deadline;
+        const Clock::duration interval;
+        int epollFd;
+        bool noPwait2 = false;
+        std::vector<Connection> connections;
+
+    public:
+        ThreadResult result;
+
+        LoadThread(const Config &config, const std::vector<std::string> &requests, const int port,
+                   const size_t count, const size_t firstIndex, const Clock::time_point start,
+                   const Clock::time_point measureFrom, const Clock::time_point deadline)
+            : config(config), requests(requests), port(port), measureFrom(measureFrom), deadline(deadline),
+              interval(std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(
+                  static_cast<double>(config.connections) / config.rate))),
+              epollFd(epoll_create1(EPOLL_CLOEXEC)), connections(count) {
+            for (size_t i = 0; i < count; i++) {
+                Connection &connection = connections[i];
+                connection.nextRequest = (firstIndex + i) % requests.size();
+                // 开环负载下各连接的发送时刻均匀错开，避免同时到达
+                connection.nextSend = start + interval * static_cast<long>(firstIndex + i) /
+                                                  static_cast<long>(config.connections);
+            }
+        }
+
+        ~LoadThread() {
+            for (const Connection &connection : connections) {
+                if (connection.socket >= 0) {
+                    close(connection.socket);
+                }
+            }
+            close(epollFd);
+        }
+
+        void Run() {
+            for (Connection &connection : connections) {
+                Open(connection);
+            }
+            epoll_event events[64];
+            while (true) {
+                const Clock::time_point now = Clock::now();
+                if (now >= deadline) {
+                    return;
+                }
+                Clock::time_point wakeAt = deadline;
+                for (Connection &connection : connections) {
+                    Issue(connection, now);
+                    if (config.openLoop && connection.inflight.size() < Depth()) {
+                        wakeAt = std::min(wakeAt, connection.nextSend);
+                    }
+                }
+                const int count = Wait(events, 64, wakeAt);
+                for (int i = 0; i < count; i++) {
+                    Connection &connection = *static_cast<Connection *>(events[i].data.ptr);
+                    if (events[i].events & EPOLLOUT) {
+                        Flush(connection);
+                    }
+                    if (connection.socket >= 0 && (events[i].events & (EPOLLIN | EPOLLERR | EPOLLHUP))) {
+                        Receive(connection);
+                    }
+                }
+            }
+        }
+
+    private:
+        /**
+         * @brief 等待事件直到 wakeAt，最长 100 毫秒
+         * @note 开环负载的发送间隔常常不足 1 毫秒，优先使用纳秒精度的 epoll_pwait2（Linux 5.11），
+         * 不可用时退回 epoll_wait 并向上取整到毫秒，宁可晚发也不忙等占用服务器的 CPU
+         */
+        int Wait(epoll_event *events, const int capacity, const Clock::time_point wakeAt) {
+            const auto wait = std::clamp<Clock::duration>(wakeAt - Clock::now(), Clock::duration::zero(),
+                                                          std::chrono::milliseconds(100));
+            const auto nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(wait).count();
+#ifdef SYS_epoll_pwait2
+            if (!noPwait2) {
+                const timespec timeout{static_cast<time_t>(nanoseconds / 1000000000),
+                                       static_cast<long>(nanoseconds % 1000000000)};
+                const int count = epoll_pwait2(epollFd, events, capacity, &timeout, nullptr);
+                if (count >= 0 || errno != ENOSYS) {
+                    return count;
+                }
+                noPwait2 = true;
+            }
+#endif
+            return epoll_wait(epollFd, events, capacity, static_cast<int>((nanoseconds + 999999) / 1000000));
+        }
+
+        // 不保持连接时每个连接只能有一个在途请求
+        size_t Depth() const { return config.keepAlive ? config.depth : 1; }
+
+        void Open(Connection &connection) {
+            connection.socket = Connect(port);
+            connection.recvBuffer.clear();
+            connection.sendBuffer.clear();
+            connection.sendOffset = 0;
+            connection.wantWrite = false;
+            connection.inflight.clear();
+            if (connection.socket < 0) {
+                result.errors++;
+                return;
+            }
+            result.connects++;
+            epoll_event event{};
+            event.events = EPOLLIN;
+            event.data.ptr = &connection;
+            epoll_ctl(epollFd, EPOLL_CTL_ADD, connection.socket, &event);
+        }
+
+        void Reopen(Connection &connection) {
+            if (connection.socket >= 0) {
+                close(connection.socket);
+            }
+            Open(connection);
+        }
+
+        /**
+         * @brief 补足在途请求：闭环负载补到 depth 个，开环负载发送所有已到计划时刻的请求
+         */
+        void Issue(Connection &connection, const Clock::time_point now) {
+            if (connection.socket < 0) {
+                Reopen(connection);
+                if (connection.socket < 0) {
+                    return;
+                }
+            }
+            bool issued = false;
+            while (connection.inflight.size() < Depth()) {
+                Clock::time_point start = now;
+                if (config.openLoop) {
+                    if (connection.nextSend > now) {
+                        break;
+                    }
+                    start = connection.nextSend;
+                    connection.nextSend += interval;
+                }
+                connection.sendBuffer += requests[connection.nextRequest];
+                connection.nextRequest = (connection.nextRequest + 1) % requests.size();
+                connection.inflight.push_back(start);
+                issued = true;
+            }
+            if (issued) {
+                Flush(connection);
+            }
+        }
+
+        void Flush(Connection &connection) {
+            while (connection.sendOffset < connection.sendBuffer.size()) {
+                const ssize_t count = send(connection.socket, connection.sendBuffer.data() + connection.sendOffset,
+                                           connection.sendBuffer.size() - connection.sendOffset, MSG_NOSIGNAL);
+                if (count < 0) {
+                    if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                        Watch(connection, true);
+                    } else {
+                        Fail(connection);
+                    }
+                    return;
+                }
+                connection.sendOffset += static_cast<size_t>(count);
+            }
+            connection.sendBuffer.clear();
+            connection.sendOffset = 0;
+            Watch(connection, false);
+        }
+
+        void Watch(Connection &connection, const bool write) {
+            if (connection.wantWrite == write) {
+                return;
+            }
+            connection.wantWrite = write;
+            epoll_event event{};
+            event.events = write ? EPOLLIN | EPOLLOUT : EPOLLIN;
+            event.data.ptr = &connection;
+            epoll_ctl(epollFd, EPOLL_CTL_MOD, connection.socket, &event);
+        }
+
+        void Fail(Connection &connection) {
+            result.errors += std::max<size_t>(connection.inflight.size(), 1);
+            Reopen(connection);
+        }
+
+        void Receive(Connection &connection) {
+            char buffer[16384];
+            while (true) {
+                const ssize_t count = recv(connection.socket, buffer, sizeof(buffer), 0);
+                if (count < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+                    return;
+                }
+                if (count <= 0) {
+                    // 服务器关闭了连接：没有在途请求时是正常的连接回收
+                    if (connection.inflight.empty()) {
+                        Reopen(connection);
+                    } else {
+                        Fail(connection);
+                    }
+                    return;
+                }
+                connection.recvBuffer.append(buffer, static_cast<size_t>(count));
+                if (!ParseResponses(connection)) {
+                    return;
+                }
+            }
+        }
+
+        /**
+         * @brief 取出接收缓冲区中所有完整的响应
+         * @return 连接是否仍可继续使用
+         */
+        bool ParseResponses(Connection &connection) {
+            size_t offset = 0;
+            while (true) {
+                const std::string_view data = std::string_view(connection.recvBuffer).substr(offset);
+                const size_t headerEnd = data.find("\r\n\r\n");
+                if (headerEnd == std::string_view::npos) {
+                    break;
+                }
+                const std::string_view header = data.substr(0, headerEnd);
+                const size_t lengthAt = header.find("Content-Length: ");
+                const size_t length =
+                    lengthAt == std::string_view::npos ? 0 : std::strtoull(header.data() + lengthAt + 16, nullptr, 10);
+                if (data.size() < headerEnd + 4 + length) {
+                    break;
+                }
+                if (connection.inflight.empty() || header.size() < 12) {
+                    Fail(connection);
+                    return false;
+                }
+                const Clock::time_point now = Clock::now();
+                const Clock::time_point start = connection.inflight.front();
+                connection.inflight.pop_front();
+                if (start >= measureFrom && now < deadline) {
+                    result.latencies.Record(static_cast<uint64_t>(
+                        std::chrono::duration_cast<std::chrono::nanoseconds>(now - start).count()));
+                    switch (header[9]) {
+                        case '2': result.status2xx++; break;
+                        case '4': result.status4xx++; break;
+                        case '5': result.status5xx++; break;
+                        default: result.errors++; break;
+                    }
+                }
+                offset += headerEnd + 4 + length;
+                if (!config.keepAlive || header.find("Connection: close") != std::string_view::npos) {
+                    Reopen(connection);
+                    return false;
+                }
+            }
+            connection.recvBuffer.erase(0, offset);
+            return true;
+        }
+    };
+
+    std::map<std::string, std::string> ReadBaseline(const std::string &path) {
+        std::map<std::string, std::string> values;
+        std::ifstream file(path);
+        for (std::string line; std::getline(file, line);) {
+            if (const size_t colon = line.find(": "); !line.empty() && line[0] != '#' && colon != std::string::npos) {
+                values[line.substr(0, colon)] = line.substr(colon + 2);
+            }
+        }
+        return values;
+    }
+
+    void PrintUsage(std::FILE *stream) {
+        const Config defaults;
+        std::fprintf(stream, "选项（--名称=值）：\n"
+                             "  --connections=%zu       并发连接数\n"
+                             "  --depth=%zu             每个连接的管线深度（在途请求数），不保持连接时固定为 1\n"
+                             "  --keep-alive=on|off    是否保持连接，off 时每个请求使用新连接\n"
+                             "  --mode=closed|open     闭环（收到响应后补发）或开环（固定速率）\n"
+                             "  --rate=%.0f          开环负载的总请求速率（每秒）\n"
+                             "  --duration=%.0f          测量时长（秒）\n"
+                             "  --warmup=%.0f            预热时长（秒），期间的请求不计入结果\n"
+                             "  --mix=\"%s\"\n"
+                             "                         请求组合，\"方法 路径=权重\" 以逗号分隔；/api/ping 返回一个小的 JSON\n"
+                             "  --body-size=%zu       首页的大小（字节）\n"
+                             "  --backend=epoll|uring  服务器后端\n"
+                             "  --workers=%zu           服务器 I/O 线程数\n"
+                             "  --client-threads=%zu    负载线程数\n"
+                             "  --baseline=<文件>       与保存的基线比较\n"
+                             "  --save-baseline=<文件>  把本次结果保存为基线\n"
+                             "  --tolerance=%.2f       吞吐下降或 p50 上升超过该比例时视为退化\n",
+                             defaults.connections, defaults.depth, defaults.rate, defaults.duration, defaults.warmup,
+                             defaults.mix.c_str(), defaults.bodySize, defaults.workers, defaults.clientThreads,
+                             defaults.tolerance);
+    }
+
+    /**
+     * @brief 解析十进制的计数
+     * @param text 参数值
+     * @param value [输出] 解析结果
+     * @param allowZero 是否接受 0
+     * @return 不是完整的十进制数、超出范围或不接受的 0 时返回 false
+     */
+    bool ParseCount(const std::string &text, size_t &value, const bool allowZero) {
+        if (text.empty() || !std::isdigit(static_cast<unsigned char>(text[0]))) {
+            return false;
+        }
+        errno = 0;
+        char *end = nullptr;
+        const unsigned long long parsed = std::strtoull(text.c_str(), &end, 10);
+        if (*end != '\0' || errno == ERANGE || (parsed == 0 && !allowZero) || parsed > SIZE_MAX) {
+            return false;
+        }
+        value = static_cast<size_t>(parsed);
+        return true;
+    }
+
+    /**
+     * @brief 解析有限的非负小数（秒数、速率、比例）
+     * @param text 参数值
+     * @param value [输出] 解析结果
+     * @param allowZero 是否接受 0
+     * @return 不是完整的数、不是有限值、为负数或不接受的 0 时返回 false
+     */
+    bool ParseNumber(const std::string &text, double &value, const bool allowZero) {
+        if (text.empty() || !(std::isdigit(static_cast<unsigned char>(text[0])) || text[0] == '.')) {
+            return false;
+        }
+        char *end = nullptr;
+        const double parsed = std::strtod(text.c_str(), &end);
+        if (*end != '\0' || !std::isfinite(parsed) || (parsed == 0 && !allowZero)) {
+            return false;
+        }
+        value = parsed;
+        return true;
+    }
+
+    Config ParseArguments(const int argc, char **argv) {
+        Config config;
+        for (int i = 1; i < argc; i++) {
+            const std::string argument = argv[i];
+            if (argument == "--help" || argument == "-h") {
+                PrintUsage(stdout);
+                std::exit(0);
+            }
+            const size_t equals = argument.find('=');
+            if (argument.rfind("--", 0) != 0 || equals == std::string::npos) {
+                std::fprintf(stderr, "无法识别的参数 %s，--help 列出全部选项\n", argument.c_str());
+                std::exit(1);
+            }
+            const std::string name = argument.substr(2, equals - 2);
+            const std::string value = argument.substr(equals + 1);
+            // 连接数、深度、速率、时长与负载线程数必须为正；body-size、warmup、tolerance 可以为 0，workers 为 0 时按核心数
+            bool valid = true;
+            if (name == "connections") {
+                valid = ParseCount(value, config.connections, false);
+            } else if (name == "depth") {
+                valid = ParseCount(value, config.depth, false);
+            } else if (name == "keep-alive") {
+                valid = value == "on" || value == "off";
+                config.keepAlive = value != "off";
+            } else if (name == "mode") {
+                valid = value == "closed" || value == "open";
+                config.openLoop = value == "open";
+            } else if (name == "rate") {
+                valid = ParseNumber(value, config.rate, false);
+            } else if (name == "duration") {
+                valid = ParseNumber(value, config.duration, false);
+            } else if (name == "warmup") {
+                valid = ParseNumber(value, config.warmup, true);
+            } else if (name == "mix") {
+                config.mix = value;
+            } else if (name == "body-size") {
+                valid = ParseCount(value, config.bodySize, true);
+            } else if (name == "backend") {
+                valid = value == "epoll" || value == "uring";
+                config.useIoUring = value == "uring";
+            } else if (name == "workers") {
+                valid = ParseCount(value, config.workers, true);
+            } else if (name == "client-threads") {
+                valid = ParseCount(value, config.clientThreads, false);
+            } else if (name == "baseline") {
+                config.baseline = value;
+            } else if (name == "save-baseline") {
+                config.saveBaseline = value;
+            } else if (name == "tolerance") {
+                valid = ParseNumber(value, config.tolerance, true);
+            } else {
+                std::fprintf(stderr, "无法识别的选项 --%s，--help 列出全部选项\n", name.c_str());
+                std::exit(1);
+            }
+            if (!valid) {
+                std::fprintf(stderr, "选项 --%s 的值 \"%s\" 无效\n", name.c_str(), value.c_str());
+                PrintUsage(stderr);
+                std::exit(1);
+            }
+        }
+        config.clientThreads = std::min(config.clientThreads, config.connections);
+        return config;
+    }
+}
+
+int main(const int argc, char **argv) {
+    const Config config = ParseArguments(argc, argv);
+    spdlog::set_level(spdlog::level::warn);
+
+    HttpServerOptions options;
+    options.workerThreads = config.workers;
+    options.useIoUring = config.useIoUring;
+    options.connectionPoolSize = std::max(options.connectionPoolSize, config.connections * 2);
+    // 保持连接的测量不应被连接回收打断
+    options.maxRequestsPerConnection = size_t{1} << 30;
+    HttpServer server(options);
+    server.AddApi("GET", "/api/ping", [](const HttpApiRequest &, std::string &body) {
+        body = R"({"ok":true})";
+        return 200;
+    });
+    std::string html = "<!DOCTYPE html><html><body>";
+    html.append(config.bodySize > html.size() + 14 ? config.bodySize - html.size() - 14 : 0, 'x');
+    html += "</body></html>";
+    const int port = server.Start(html, 0);
+    if (port < 0) {
+        std::fprintf(stderr, "服务器启动失败\n");
+        return 1;
+    }
+
+    const std::vector<std::string> requests = BuildRequests(config, port);
+    const Clock::time_point start = Clock::now() + std::chrono::milliseconds(50);
+    const Clock::time_point measureFrom =
+        start + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(config.warmup));
+    const Clock::time_point deadline =
+        measureFrom + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(config.duration));
+
+    std::vector<std::unique_ptr<LoadThread>> loads;
+    size_t assigned = 0;
+    for (size_t i = 0; i < config.clientThreads; i++) {
+        const size_t count = config.connections / config.clientThreads + (i < config.connections % config.clientThreads);
+        loads.push_back(
+            std::make_unique<LoadThread>(config, requests, port, count, assigned, start, measureFrom, deadline));
+        assigned += count;
+    }
+    std::vector<std::thread> threads;
+    for (const auto &load : loads) {
+        threads.emplace_back([&load, start] {
+            std::this_thread::sleep_until(start);
+            load->Run();
+        });
+    }
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+    server.Stop();
+
+    ThreadResult total;
+    for (const auto &load : loads) {
+        total.latencies.Merge(load->result.latencies);
+        total.status2xx += load->result.status2xx;
+        total.status4xx += load->result.status4xx;
+        total.status5xx += load->result.status5xx;
+        total.errors += load->result.errors;
+        total.connects += load->result.connects;
+    }
+    loads.clear();
+
+    const double throughput = static_cast<double>(total.latencies.Count()) / config.duration;
+    std::printf("%s\n", config.Describe().c_str());
+    std::printf("%.1f 秒内完成 %llu 个请求，%.0f req/s，建立 %llu 个连接\n", config.duration,
+                static_cast<unsigned long long>(total.latencies.Count()), throughput,
+                static_cast<unsigned long long>(total.connects));
+    std::printf("状态码 2xx %llu，4xx %llu，5xx %llu，错误 %llu\n", static_cast<unsigned long long>(total.status2xx),
+                static_cast<unsigned long long>(total.status4xx), static_cast<unsigned long long>(total.status5xx),
+                static_cast<unsigned long long>(total.errors));
+    std::printf("%10s %10s %10s %10s %10s %10s %10s %10s\n", "mean us", "p50 us", "p75 us", "p90 us", "p99 us",
+                "p99.9 us", "p99.99 us", "max us");
+    std::printf("%10.1f %10.1f %10.1f %10.1f %10.1f %10.1f %10.1f %10.1f\n", total.latencies.MeanMicroseconds(),
+                total.latencies.PercentileMicroseconds(50), total.latencies.PercentileMicroseconds(75),
+                total.latencies.PercentileMicroseconds(90), total.latencies.PercentileMicroseconds(99),
+                total.latencies.PercentileMicroseconds(99.9), total.latencies.PercentileMicroseconds(99.99),
+                total.latencies.MaxMicroseconds());
+
+    if (!config.saveBaseline.empty()) {
+        std::ofstream file(config.saveBaseline);
+        file << "# http-load-benchmark 基线，由 --save-baseline 生成，只在同一台机器上比较才有意义\n";
+        file << "config: " << config.Describe() << "\n";
+        file << "throughput: " << throughput << "\n";
+        file << "p50: " << total.latencies.PercentileMicroseconds(50) << "\n";
+        file << "p99: " << total.latencies.PercentileMicroseconds(99) << "\n";
+        file << "p99.9: " << total.latencies.PercentileMicroseconds(99.9) << "\n";
+        if (!file) {
+            std::fprintf(stderr, "无法写入基线 %s\n", config.saveBaseline.c_str());
+            return 1;
+        }
+        std::printf("基线已保存到 %s\n", config.saveBaseline.c_str());
+    }
+
+    if (total.errors > 0 || total.latencies.Count() == 0) {
+        std::fprintf(stderr, "存在失败的请求\n");
+        return 1;
+    }
+
+    if (!config.baseline.empty()) {
+        const std::map<std::string, std::string> baseline = ReadBaseline(config.baseline);
+        const auto found = baseline.find("config");
+        if (found == baseline.end()) {
+            std::fprintf(stderr, "无法读取基线 %s\n", config.baseline.c_str());
+            return 1;
+        }
+        if (found->second != config.Describe()) {
+            std::printf("基线的配置不同（%s），不做比较\n", found->second.c_str());
+            return 0;
+        }
+        const double baseThroughput = std::strtod(baseline.at("throughput").c_str(), nullptr);
+        auto change = [&](const char *name, const double percentile) {
+            const double base = std::strtod(baseline.at(name).c_str(), nullptr);
+            const double value = total.latencies.PercentileMicroseconds(percentile);
+            std::printf("  %-6s %10.1f us -> %10.1f us  %+6.1f%%\n", name, base, value, (value - base) / base * 100);
+            return (value - base) / base;
+        };
+        const double throughputChange = (throughput - baseThroughput) / baseThroughput;
+        std::printf("与基线相比：\n  %-6s %10.0f /s  -> %10.0f /s   %+6.1f%%\n", "req/s", baseThroughput, throughput,
+                    throughputChange * 100);
+        const double p50Change = change("p50", 50);
+        change("p99", 99);
+        change("p99.9", 99.9);
+        if (throughputChange < -config.tolerance || p50Change > config.tolerance) {
+            std::printf("超出容差 %.0f%%，判定为性能退化\n", config.tolerance * 100);
+            return 2;
+        }
+    }
+    return 0;
+}
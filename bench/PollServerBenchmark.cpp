@@ -0,0 +1,230 @@
+// 旧版服务器扩展性基准：先建立若干个不发送数据的空闲连接，再逐个建立新连接请求首页，
+// 观察请求延迟是否随空闲连接数增长（select 每轮都要重建并扫描全部套接字，就绪通知只处理就绪的连接）
+// 构建：cmake -S . -B build -DCMAKE_BUILD_TYPE=Release && cmake --build build --target http-poll-benchmark
+// 运行：./build/http-poll-benchmark [每轮的请求数] [空闲连接数...]
+// 另外报告没有连接时服务线程在 1 秒内被唤醒的次数，应当为 0
+#include <algorithm>
+#include <arpa/inet.h>
+#include <cctype>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <dirent.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <string>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+#include "PollServer.h"
+#include "spdlog/spdlog.h"
+
+namespace {
+    using v1_taskbar_manager::PollServer;
+    using v2_taskbar_manager::HttpServerOptions;
+
+    constexpr char kRequest[] = "GET / HTTP/1.1\r\nHost: 127.0.0.1\r\n\r\n";
+
+    int Connect(const int port) {
+        const int socket = ::socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+        constexpr int noDelay = 1;
+        setsockopt(socket, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        address.sin_port = htons(port);
+        if (connect(socket, reinterpret_cast<sockaddr *>(&address), sizeof(address)) < 0) {
+            close(socket);
+            return -1;
+        }
+        return socket;
+    }
+
+    /**
+     * @brief 发送一个请求并读取响应直到服务器关闭连接
+     * @return 收到的字节数，失败返回 0
+     */
+    size_t Request(const int port) {
+        const int socket = Connect(port);
+        if (socket < 0) {
+            return 0;
+        }
+        size_t total = 0;
+        if (send(socket, kRequest, sizeof(kRequest) - 1, MSG_NOSIGNAL) > 0) {
+            char buffer[4096];
+            for (ssize_t count; (count = recv(socket, buffer, sizeof(buffer), 0)) > 0;) {
+                total += static_cast<size_t>(count);
+            }
+        }
+        close(socket);
+        return total;
+    }
+
+    /**
+     * @brief 统计除主线程外所有线程的主动上下文切换次数，服务线程每次从等待中返回都会计入一次
+     */
+    long long BackgroundContextSwitches() {
+        long long total = 0;
+        const pid_t self = static_cast<pid_t>(syscall(SYS_gettid));
+        DIR *tasks = opendir("/proc/self/task");
+        if (tasks == nullptr) {
+            return -1;
+        }
+        while (const dirent *entry = readdir(tasks)) {
+            if (entry->d_name[0] == '.' || std::atoi(entry->d_name) == self) {
+                continue;
+            }
+            const std::string path = std::string("/proc/self/task/") + entry->d_name + "/status";
+            if (FILE *file = std::fopen(path.c_str(), "r")) {
+                char line[256];
+                while (std::fgets(line, sizeof(line), file) != nullptr) {
+                    long long value = 0;
+                    if (std::sscanf(line, "voluntary_ctxt_switches: %lld", &value) == 1) {
+                        total += value;
+                    }
+                }
+                std::fclose(file);
+            }
+        }
+        closedir(tasks);
+        return total;
+    }
+
+    double Percentile(const std::vector<double> &sorted, const double p) {
+        if (sorted.empty()) {
+            return 0;
+        }
+        return sorted[std::min(sorted.size() - 1, static_cast<size_t>(p * static_cast<double>(sorted.size())))];
+    }
+
+    /**
+     * @brief 保持 idle 个空闲连接，逐个发送 requests 个请求
+     * @return 是否成功
+     */
+    bool Run(const size_t idle, const size_t requests) {
+        HttpServerOptions options;
+        options.connectionPoolSize = idle + 16;
+        // 空闲连接在测量期间不能因等待第一个字节超时而被关闭
+        options.firstByteTimeout = std::chrono::hours(1);
+        PollServer server("<!DOCTYPE html><html><body>benchmark</body></html>", options);
+        const int port = server.Start(0);
+        if (port < 0) {
+            std::fprintf(stderr, "服务器启动失败\n");
+            return false;
+        }
+
+        if (idle == 0) {
+            // 等待服务线程进入第一次等待，它在那之前的切换不计入
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            const long long before = BackgroundContextSwitches();
+            std::this_thread::sleep_for(std::chrono::seconds(1));
+            const long long after = BackgroundContextSwitches();
+            std::printf("没有连接时服务线程 1 秒内被唤醒 %lld 次\n", after - before);
+        }
+
+        std::vector<int> sockets;
+        sockets.reserve(idle);
+        for (size_t i = 0; i < idle; i++) {
+            const int socket = Connect(port);
+            if (socket < 0) {
+                std::fprintf(stderr, "建立第 %zu 个空闲连接失败\n", i + 1);
+                break;
+            }
+            sockets.push_back(socket);
+        }
+        // 确认服务线程已经接受了全部空闲连接，之后的请求才不会与接受空闲连接交错
+        Request(port);
+
+        std::vector<double> latencies;
+        latencies.reserve(requests);
+        const auto begin = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < requests; i++) {
+            const auto start = std::chrono::steady_clock::now();
+            if (Request(port) == 0) {
+                std::fprintf(stderr, "请求失败\n");
+                return false;
+            }
+            latencies.push_back(
+                std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count());
+        }
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+        std::sort(latencies.begin(), latencies.end());
+        std::printf("%10zu %10zu %12.0f %10.1f %10.1f %10.1f\n", sockets.size(), requests,
+                    static_cast<double>(requests) / seconds, Percentile(latencies, 0.5), Percentile(latencies, 0.99),
+                    Percentile(latencies, 0.999));
+
+        server.Stop();
+        for (const int socket : sockets) {
+            close(socket);
+        }
+        return true;
+    }
+
+    /**
+     * @brief 解析命令行中的数量参数
+     * @param text 参数文本
+     * @param value 解析结果
+     * @param allowZero 是否接受 0
+     * @return 不是十进制非负整数、超出范围或在不接受时为 0 时返回 false
+     */
+    bool ParseCount(const char *text, size_t &value, const bool allowZero = false) {
+        if (!std::isdigit(static_cast<unsigned char>(text[0]))) {
+            return false;
+        }
+        errno = 0;
+        char *end = nullptr;
+        const unsigned long long parsed = std::strtoull(text, &end, 10);
+        if (*end != '\0' || errno == ERANGE || parsed > SIZE_MAX || (parsed == 0 && !allowZero)) {
+            return false;
+        }
+        value = static_cast<size_t>(parsed);
+        return true;
+    }
+}
+
+int main(const int argc, char **argv) {
+    size_t requests = 5000;
+    std::vector<size_t> idleCounts;
+    bool valid = argc < 2 || ParseCount(argv[1], requests);
+    for (int i = 2; valid && i < argc; i++) {
+        size_t idle = 0;
+        valid = ParseCount(argv[i], idle, true);
+        idleCounts.push_back(idle);
+    }
+    if (!valid) {
+        std::fprintf(stderr, "用法: %s [每轮的请求数] [空闲连接数...]，请求数为正整数，空闲连接数为非负整数\n",
+                     argv[0]);
+        return 1;
+    }
+    if (idleCounts.empty()) {
+        idleCounts = {0, 100, 1000, 4000};
+    }
+    spdlog::set_level(spdlog::level::warn);
+
+    // 每个空闲连接在本进程中占用客户端与服务端两个描述符
+    rlimit limit{};
+    getrlimit(RLIMIT_NOFILE, &limit);
+    limit.rlim_cur = limit.rlim_max;
+    setrlimit(RLIMIT_NOFILE, &limit);
+    const size_t maxIdle = limit.rlim_cur > 128 ? (limit.rlim_cur - 128) / 2 : 0;
+
+    std::printf("每轮逐个建立 %zu 个连接请求首页，服务器每个响应之后关闭连接\n", requests);
+    std::printf("%10s %10s %12s %10s %10s %10s\n", "idle", "requests", "req/s", "p50 us", "p99 us", "p99.9 us");
+    for (const size_t idle : idleCounts) {
+        if (idle > maxIdle) {
+            std::fprintf(stderr, "描述符上限只允许 %zu 个空闲连接，跳过 %zu\n", maxIdle, idle);
+            continue;
+        }
+        if (!Run(idle, requests)) {
+            return 1;
+        }
+    }
+    return 0;
+}
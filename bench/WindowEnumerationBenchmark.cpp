@@ -0,0 +1,353 @@
+// 窗口枚举基准：在 SyntheticWindowSource 生成的窗口集合上测量任务栏过滤、元数据读取、JSON 生成与增量计算
+// 写法与输出沿用 Google Benchmark（BENCHMARK 注册、for (auto _ : state)、--benchmark_filter、--benchmark_min_time），
+// 但不依赖它；以后引入 Google Benchmark 时只需删掉文件开头的最小实现
+// 构建：cmake -S . -B build -DCMAKE_BUILD_TYPE=Release && cmake --build build --target window-enumeration-benchmark
+// 运行：./build/window-enumeration-benchmark --benchmark_filter=Diff --benchmark_min_time=1
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <map>
+#include <memory>
+#include <regex>
+#include <string>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include "ProcessInfoCache.h"
+#include "SyntheticWindowSource.h"
+#include "TaskbarWindows.h"
+#include "WindowSnapshotHistory.h"
+#include "WindowTable.h"
+
+namespace {
+    // Google Benchmark 的最小子集：计时、迭代次数自适应、Arg 参数与用户计数器
+    class State {
+    public:
+        State(const int64_t argument, const size_t iterations) : argument(argument), iterations(iterations) {
+        }
+
+        struct Iterator {
+            State *state;
+            size_t remaining;
+
+            bool operator!=(const Iterator &) {
+                if (remaining != 0) {
+                    return true;
+                }
+                state->PauseTiming();
+                return false;
+            }
+
+            void operator++() { remaining--; }
+
+            int operator*() const { return 0; }
+        };
+
+        Iterator begin() {
+            ResumeTiming();
+            return {this, iterations};
+        }
+
+        Iterator end() { return {this, 0}; }
+
+        int64_t range(size_t = 0) const { return argument; }
+
+        size_t iterations_count() const { return iterations; }
+
+        void PauseTiming() {
+            wall += std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+            cpu += static_cast<double>(std::clock() - cpuStart) / CLOCKS_PER_SEC;
+        }
+
+        void ResumeTiming() {
+            wallStart = std::chrono::steady_clock::now();
+            cpuStart = std::clock();
+        }
+
+        void SetItemsProcessed(const int64_t items) { itemsProcessed = items; }
+
+        std::map<std::string, double> counters;
+        double wall = 0;
+        double cpu = 0;
+        int64_t itemsProcessed = 0;
+
+    private:
+        int64_t argument;
+        size_t iterations;
+        std::chrono::steady_clock::time_point wallStart;
+        std::clock_t cpuStart = 0;
+    };
+
+    using Function = void (*)(State &state);
+
+    class Registration {
+    public:
+        Registration(const char *name, const Function function) : name(name), function(function) {
+        }
+
+        Registration *Arg(const int64_t argument) {
+            arguments.push_back(argument);
+            return this;
+        }
+
+        std::string name;
+        Function function;
+        std::vector<int64_t> arguments;
+    };
+
+    std::vector<std::unique_ptr<Registration>> &Registry() {
+        static std::vector<std::unique_ptr<Registration>> registry;
+        return registry;
+    }
+
+    Registration *Register(const char *name, const Function function) {
+        Registry().push_back(std::make_unique<Registration>(name, function));
+        return Registry().back().get();
+    }
+
+#define BENCHMARK(function) [[maybe_unused]] Registration *const registration_##function = Register(#function, function)
+
+    // 与 Google Benchmark 相同，以 k、M、G 为单位输出速率
+    std::string HumanReadable(double value) {
+        const char *unit = "";
+        for (const char *next : {"k", "M", "G"}) {
+            if (value < 1000) {
+                break;
+            }
+            value /= 1000;
+            unit = next;
+        }
+        char text[32];
+        std::snprintf(text, sizeof(text), "%.4g%s", value, unit);
+        return text;
+    }
+
+    // 防止编译器把结果当作无用计算优化掉
+    volatile size_t sink;
+
+    void DoNotOptimize(const size_t value) {
+        sink = value;
+    }
+
+    /**
+     * @brief 运行一个基准，迭代次数从 1 开始增长，直到计时达到 minTime
+     */
+    void RunBenchmark(const Registration &registration, const int64_t argument, const double minTime) {
+        size_t iterations = 1;
+        while (true) {
+            State state(argument, iterations);
+            registration.function(state);
+            const bool enough = state.wall >= minTime || iterations >= 1000000000;
+            if (!enough) {
+                // 按已经测得的速度预估，每轮最多放大 10 倍
+                const double estimate = state.wall > 0 ? minTime * 1.4 / state.wall * iterations : iterations * 10.0;
+                iterations = std::max(iterations + 1, std::min(iterations * 10, static_cast<size_t>(estimate)));
+                continue;
+            }
+            char name[96];
+            std::snprintf(name, sizeof(name), "%s/%lld", registration.name.c_str(), static_cast<long long>(argument));
+            std::printf("%-36s %12.0f ns %12.0f ns %10zu", name, state.wall * 1e9 / iterations,
+                        state.cpu * 1e9 / iterations, iterations);
+            if (state.itemsProcessed > 0) {
+                std::printf(" items_per_second=%s/s", HumanReadable(state.itemsProcessed / state.wall).c_str());
+            }
+            for (const auto &[counter, value] : state.counters) {
+                std::printf(" %s=%.4g", counter.c_str(), value);
+            }
+            std::printf("\n");
+            return;
+        }
+    }
+}
+
+namespace {
+    using v1_taskbar_manager::ProcessInfoCache;
+    using v1_taskbar_manager::SyntheticWindowOptions;
+    using v1_taskbar_manager::SyntheticWindowSource;
+    using v1_taskbar_manager::TaskbarWindows;
+    using v1_taskbar_manager::WindowDelta;
+    using v1_taskbar_manager::WindowHandle;
+    using v1_taskbar_manager::WindowRecord;
+    using v1_taskbar_manager::WindowSnapshotHistory;
+    using v1_taskbar_manager::WindowTable;
+
+    // 顶层窗口数取自 Arg，进程数约为窗口数的 1/20，不超过进程信息缓存的默认容量
+    SyntheticWindowOptions Options(const int64_t windowCount) {
+        SyntheticWindowOptions options;
+        options.windowCount = static_cast<size_t>(windowCount);
+        options.processCount = std::clamp<size_t>(options.windowCount / 20, 1, 200);
+        return options;
+    }
+
+    // 只做任务栏过滤，不读取标题以外的元数据
+    void BM_Filter(State &state) {
+        SyntheticWindowSource source(Options(state.range(0)));
+        size_t shown = 0;
+        for ([[maybe_unused]] auto _ : state) {
+            shown = 0;
+            source.EnumerateTopLevel([&](const WindowHandle handle) {
+                shown += TaskbarWindows::ShouldShowInTaskbar(source, handle);
+                return true;
+            });
+            DoNotOptimize(shown);
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations_count() * source.Size()));
+        state.counters["shown"] = static_cast<double>(shown);
+    }
+
+    // 过滤并读取元数据，每个窗口都重新读取进程名（没有进程信息缓存时的做法）
+    void BM_GetTaskbarWindows(State &state) {
+        SyntheticWindowSource source(Options(state.range(0)));
+        for ([[maybe_unused]] auto _ : state) {
+            DoNotOptimize(TaskbarWindows::GetTaskbarWindows(source).size());
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations_count() * source.Size()));
+        state.counters["opens/iter"] = static_cast<double>(source.ProcessOpens()) / state.iterations_count();
+    }
+
+    // 过滤并读取元数据，进程名经由 ProcessInfoCache
+    void BM_GetTaskbarWindowsCached(State &state) {
+        SyntheticWindowSource source(Options(state.range(0)));
+        ProcessInfoCache processes(source);
+        for ([[maybe_unused]] auto _ : state) {
+            DoNotOptimize(TaskbarWindows::GetTaskbarWindows(source, &processes).size());
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations_count() * source.Size()));
+        state.counters["opens/iter"] = static_cast<double>(source.ProcessOpens()) / state.iterations_count();
+    }
+
+    // getWindows 返回完整列表的做法：与 WindowManager::WindowToJson 相同，逐个窗口构造 nlohmann::json
+    void BM_JsonBuild(State &state) {
+        SyntheticWindowSource source(Options(state.range(0)));
+        const std::vector<WindowRecord> windows = TaskbarWindows::GetTaskbarWindows(source);
+        for ([[maybe_unused]] auto _ : state) {
+            nlohmann::json data = nlohmann::json::array();
+            for (const WindowRecord &record : windows) {
+                nlohmann::json windowJson;
+                windowJson["title"] = record.title.empty() ? "(无标题)" : record.title;
+                windowJson["handle"] = record.handleText;
+                data.push_back(std::move(windowJson));
+            }
+            DoNotOptimize(data.dump().size());
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations_count() * windows.size()));
+    }
+
+    // 推送窗口列表的做法：重建 WindowTable 后直接序列化
+    void BM_JsonBuildTable(State &state) {
+        SyntheticWindowSource source(Options(state.range(0)));
+        const std::vector<WindowRecord> windows = TaskbarWindows::GetTaskbarWindows(source);
+        WindowTable table;
+        std::string json;
+        for ([[maybe_unused]] auto _ : state) {
+            table.Clear();
+            table.Reserve(windows.size());
+            for (const WindowRecord &record : windows) {
+                table.Append(record);
+            }
+            json.clear();
+            table.AppendJson(json);
+            DoNotOptimize(json.size());
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations_count() * windows.size()));
+    }
+
+    // 每轮按 churnRate 修改窗口后，计算与上一版本的增量；修改与枚举不计时
+    void BM_Diff(State &state) {
+        SyntheticWindowSource source(Options(state.range(0)));
+        ProcessInfoCache processes(source);
+        WindowSnapshotHistory history;
+        std::vector<WindowRecord> windows = TaskbarWindows::GetTaskbarWindows(source, &processes);
+        uint64_t version = 0;
+        history.Remember(version, windows);
+        WindowDelta delta;
+        size_t changes = 0;
+        for ([[maybe_unused]] auto _ : state) {
+            state.PauseTiming();
+            source.Churn();
+            windows = TaskbarWindows::GetTaskbarWindows(source, &processes);
+            state.ResumeTiming();
+            history.Diff(version, windows, delta);
+            changes += delta.added.size() + delta.changed.size() + delta.removed.size();
+            state.PauseTiming();
+            history.Remember(++version, windows);
+            state.ResumeTiming();
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations_count() * windows.size()));
+        state.counters["changes/iter"] = static_cast<double>(changes) / state.iterations_count();
+    }
+
+    BENCHMARK(BM_Filter)->Arg(100)->Arg(1000)->Arg(5000);
+    BENCHMARK(BM_GetTaskbarWindows)->Arg(100)->Arg(1000)->Arg(5000);
+    BENCHMARK(BM_GetTaskbarWindowsCached)->Arg(100)->Arg(1000)->Arg(5000);
+    BENCHMARK(BM_JsonBuild)->Arg(100)->Arg(1000)->Arg(5000);
+    BENCHMARK(BM_JsonBuildTable)->Arg(100)->Arg(1000)->Arg(5000);
+    BENCHMARK(BM_Diff)->Arg(100)->Arg(1000)->Arg(5000);
+
+    /**
+     * @brief 解析 --benchmark_min_time 的秒数，与 Google Benchmark 相同可以带 s 后缀
+     * @return 不是完整的数、不是有限的正数时返回 false
+     */
+    bool ParseMinTime(std::string text, double &value) {
+        if (!text.empty() && text.back() == 's') {
+            text.pop_back();
+        }
+        if (text.empty() || !(std::isdigit(static_cast<unsigned char>(text[0])) || text[0] == '.')) {
+            return false;
+        }
+        char *end = nullptr;
+        const double parsed = std::strtod(text.c_str(), &end);
+        if (*end != '\0' || !std::isfinite(parsed) || parsed <= 0) {
+            return false;
+        }
+        value = parsed;
+        return true;
+    }
+
+    void PrintUsage(const char *program) {
+        std::fprintf(stderr, "用法: %s [--benchmark_filter=<正则表达式>] [--benchmark_min_time=<正数秒>]\n", program);
+    }
+}
+
+int main(int argc, char **argv) {
+    std::regex filter(".*");
+    double minTime = 0.5;
+    for (int i = 1; i < argc; i++) {
+        const std::string argument = argv[i];
+        if (argument.rfind("--benchmark_filter=", 0) == 0) {
+            try {
+                filter = std::regex(argument.substr(19));
+            } catch (const std::regex_error &e) {
+                std::fprintf(stderr, "无效的正则表达式 %s: %s\n", argument.substr(19).c_str(), e.what());
+                PrintUsage(argv[0]);
+                return 1;
+            }
+        } else if (argument.rfind("--benchmark_min_time=", 0) == 0) {
+            if (!ParseMinTime(argument.substr(21), minTime)) {
+                std::fprintf(stderr, "无效的最短时间 %s\n", argument.substr(21).c_str());
+                PrintUsage(argv[0]);
+                return 1;
+            }
+        } else {
+            std::fprintf(stderr, "unknown argument: %s\n", argument.c_str());
+            PrintUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    std::printf("%-36s %15s %15s %10s\n", "Benchmark", "Time", "CPU", "Iterations");
+    for (const std::unique_ptr<Registration> &registration : Registry()) {
+        for (const int64_t argument : registration->arguments) {
+            const std::string name = registration->name + "/" + std::to_string(argument);
+            if (std::regex_search(name, filter)) {
+                RunBenchmark(*registration, argument, minTime);
+            }
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,138 @@
+// 窗口注册表场景：用 ScriptedWindowEventSource 在 Linux 上按顺序驱动 WindowRegistry，逐步检查窗口的先后顺序与版本号，
+// 覆盖创建、改名、隐藏与显示、销毁、重复与过时的事件，以及丢失事件之后由 Resync 恢复
+// 构建：cmake -S . -B build && cmake --build build --target window-registry-scenario
+// 运行：./build/window-registry-scenario，全部检查通过时以 0 退出，否则列出不符的步骤并以 1 退出
+#include <cstdint>
+#include <cstdio>
+#include <initializer_list>
+#include <string>
+#include <vector>
+
+#include "ScriptedWindowEventSource.h"
+#include "WindowRegistry.h"
+
+namespace {
+    using v1_taskbar_manager::ScriptedWindowEventSource;
+    using v1_taskbar_manager::WindowEvent;
+    using v1_taskbar_manager::WindowEventKind;
+    using v1_taskbar_manager::WindowHandle;
+    using v1_taskbar_manager::WindowRecord;
+    using v1_taskbar_manager::WindowRegistry;
+
+    size_t failures = 0;
+
+    WindowRecord MakeWindow(std::string title) {
+        WindowRecord record;
+        record.title = std::move(title);
+        record.className = "ScenarioWindow";
+        record.processId = 4242;
+        record.processName = "scenario.exe";
+        return record;
+    }
+
+    std::string Describe(const std::vector<std::string> &titles) {
+        std::string text = "[";
+        for (size_t i = 0; i < titles.size(); i++) {
+            text += i > 0 ? ", " : "";
+            text += titles[i];
+        }
+        return text + "]";
+    }
+
+    /**
+     * @brief 检查注册表中窗口的标题（按先后顺序）与版本号
+     * @param step 步骤说明
+     * @param registry 窗口注册表
+     * @param titles 期望的标题顺序
+     * @param version 期望的版本号
+     */
+    void Expect(const char *step, const WindowRegistry &registry, const std::initializer_list<const char *> titles,
+                const uint64_t version) {
+        std::vector<std::string> actual;
+        for (const WindowRecord &record : registry.Windows()) {
+            actual.push_back(record.title);
+        }
+        const std::vector<std::string> expected(titles.begin(), titles.end());
+        const bool ok = actual == expected && registry.Version() == version;
+        std::printf("%-4s %-28s %s v%llu\n", ok ? "ok" : "FAIL", step, Describe(actual).c_str(),
+                    static_cast<unsigned long long>(registry.Version()));
+        if (!ok) {
+            std::printf("     期望 %s v%llu\n", Describe(expected).c_str(), static_cast<unsigned long long>(version));
+            failures++;
+        }
+    }
+
+    void Check(const char *step, const bool condition) {
+        std::printf("%-4s %s\n", condition ? "ok" : "FAIL", step);
+        if (!condition) {
+            failures++;
+        }
+    }
+}
+
+int main() {
+    ScriptedWindowEventSource source;
+    // 启动之前已经存在的窗口由启动时的枚举读入，此时没有订阅者，事件不会投递
+    const WindowHandle a = source.Create(MakeWindow("A"));
+    const WindowHandle b = source.Create(MakeWindow("B"));
+    source.Create(MakeWindow("hidden"), false);
+    source.Create(MakeWindow(""));
+
+    WindowRegistry registry(source);
+    Check("订阅事件源", registry.Start());
+    Expect("启动时枚举", registry, {"A", "B"}, 1);
+    Check("句柄文本", registry.Find(a) != nullptr && registry.Find(a)->handleText == "0x10000");
+
+    const WindowHandle c = source.Create(MakeWindow("C"));
+    Expect("创建追加在末尾", registry, {"A", "B", "C"}, 2);
+
+    source.Rename(b, "B2");
+    Expect("改名原位更新", registry, {"A", "B2", "C"}, 3);
+    source.Rename(b, "B2");
+    Expect("相同标题不增加版本", registry, {"A", "B2", "C"}, 3);
+    source.SetMinimized(c, true);
+    Expect("最小化原位更新", registry, {"A", "B2", "C"}, 4);
+
+    source.Hide(a);
+    Expect("隐藏移除", registry, {"B2", "C"}, 5);
+    source.Show(a);
+    Expect("重新显示追加在末尾", registry, {"B2", "C", "A"}, 6);
+    source.Rename(a, "");
+    Expect("失去标题移除", registry, {"B2", "C"}, 7);
+    source.Rename(a, "A");
+    Expect("恢复标题追加在末尾", registry, {"B2", "C", "A"}, 8);
+
+    source.Destroy(c);
+    Expect("销毁移除", registry, {"B2", "A"}, 9);
+
+    // 重复、过时与未知窗口的事件不改变模型
+    source.Emit(WindowEvent{WindowEventKind::Destroyed, c});
+    source.Emit(WindowEvent{WindowEventKind::Destroyed, 0xDEAD0});
+    Expect("多余的销毁事件", registry, {"B2", "A"}, 9);
+    source.Emit(WindowEvent{WindowEventKind::Shown, c});
+    source.Emit(WindowEvent{WindowEventKind::NameChanged, 0xDEAD0});
+    Expect("已销毁窗口的过时事件", registry, {"B2", "A"}, 9);
+    source.Emit(WindowEvent{WindowEventKind::Created, b});
+    Expect("已存在窗口的重复创建事件", registry, {"B2", "A"}, 9);
+
+    // 丢失的事件：事件源的状态已经变化，模型保持原样，直到 Resync
+    source.Destroy(b, false);
+    source.Rename(a, "A2", false);
+    source.Create(MakeWindow("D"), true, false);
+    Expect("丢失事件之后模型不变", registry, {"B2", "A"}, 9);
+    registry.Resync();
+    Expect("Resync 恢复且只增加一次版本", registry, {"A2", "D"}, 10);
+    registry.Resync();
+    Expect("没有变化时 Resync 不增加版本", registry, {"A2", "D"}, 10);
+
+    registry.Stop();
+    source.Create(MakeWindow("E"));
+    Expect("停止之后不再接收事件", registry, {"A2", "D"}, 10);
+
+    if (failures > 0) {
+        std::printf("%zu 项检查不符\n", failures);
+        return 1;
+    }
+    std::printf("全部检查通过\n");
+    return 0;
+}
@@ -0,0 +1,245 @@
+// 窗口表基准：在合成的 5000 个窗口上比较逐窗口保存字符串的 WindowRecord 列表与列式窗口表（WindowTable）的
+// 常驻内存、重建耗时与序列化耗时
+// 构建：cmake -S . -B build -DCMAKE_BUILD_TYPE=Release && cmake --build build --target window-table-benchmark
+// 运行：./build/window-table-benchmark [窗口数] [轮数]
+#include <cctype>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include "WindowTable.h"
+
+namespace {
+    using v1_taskbar_manager::WindowHandle;
+    using v1_taskbar_manager::WindowRecord;
+    using v1_taskbar_manager::WindowTable;
+
+    // 全局 operator new 的计数，用于统计常驻内存与分配次数
+    size_t liveBytes = 0;
+    size_t allocations = 0;
+
+    // 防止编译器把结果当作无用计算优化掉
+    volatile size_t sink;
+
+    // 枚举得到的一行原始数据，字符串由生成器持有，相当于 EnumWindows 回调中的缓冲区
+    struct RawWindow {
+        WindowHandle handle;
+        std::string title;
+        std::string className;
+        uint32_t processId;
+        std::string processName;
+        bool isMinimized;
+        bool isMaximized;
+    };
+
+    /**
+     * @brief 生成确定性的窗口集合：15 种类名、300 个进程共 20 种映像名，标题混合中英文且大多不重复
+     */
+    std::vector<RawWindow> GenerateWindows(const size_t count) {
+        static const char *const classNames[] = {
+            "Chrome_WidgetWin_1", "CabinetWClass", "Notepad", "ConsoleWindowClass", "OpusApp", "XLMAIN",
+            "PPTFrameClass", "MozillaWindowClass", "SunAwtFrame", "Qt5152QWindowIcon", "WindowsForms10.Window.8.app",
+            "HwndWrapper[DefaultDomain;;]", "TscShellContainerClass", "VirtualConsoleClass", "CASCADIA_HOSTING_WINDOW_CLASS",
+        };
+        static const char *const processNames[] = {
+            "chrome.exe", "msedge.exe", "explorer.exe", "notepad.exe", "WINWORD.EXE", "EXCEL.EXE", "POWERPNT.EXE",
+            "firefox.exe", "idea64.exe", "clion64.exe", "Code.exe", "WindowsTerminal.exe", "mstsc.exe", "WeChat.exe",
+            "QQ.exe", "DingTalk.exe", "Feishu.exe", "Typora.exe", "obs64.exe", "vlc.exe",
+        };
+        static const char *const titlePrefixes[] = {
+            "新建文本文档", "季度报告", "Pull request #", "README.md - taskbar-manager", "下载", "会议纪要",
+            "Inbox - Outlook", "設定", "Документ", "main.cpp - CLion",
+        };
+        constexpr size_t classCount = sizeof(classNames) / sizeof(classNames[0]);
+        constexpr size_t processCount = sizeof(processNames) / sizeof(processNames[0]);
+        constexpr size_t prefixCount = sizeof(titlePrefixes) / sizeof(titlePrefixes[0]);
+
+        uint64_t state = 0x2545F4914F6CDD1DULL;
+        const auto next = [&state] {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            return state;
+        };
+        std::vector<RawWindow> windows;
+        windows.reserve(count);
+        for (size_t i = 0; i < count; i++) {
+            RawWindow window;
+            window.handle = 0x10000 + i * 0x1A;
+            // 同一进程的窗口使用相同的映像名与相近的类名
+            window.processId = 1000 + static_cast<uint32_t>(next() % 300) * 4;
+            window.processName = processNames[window.processId / 4 % processCount];
+            window.className = classNames[(window.processId / 4 + next() % 3) % classCount];
+            window.title = std::string(titlePrefixes[next() % prefixCount]) + " " + std::to_string(next() % 100000) +
+                           " - " + window.processName;
+            window.isMinimized = next() % 4 == 0;
+            window.isMaximized = !window.isMinimized && next() % 3 == 0;
+            windows.push_back(std::move(window));
+        }
+        return windows;
+    }
+
+    std::string HandleText(const WindowHandle handle) {
+        char text[32];
+        const int length = std::snprintf(text, sizeof(text), "0x%llX", static_cast<unsigned long long>(handle));
+        return std::string(text, length);
+    }
+
+    // 原来的做法：每个窗口一个 WindowRecord，五个字符串各自分配
+    void BuildRecords(const std::vector<RawWindow> &raw, std::vector<WindowRecord> &records) {
+        records.clear();
+        records.reserve(raw.size());
+        for (const RawWindow &window : raw) {
+            WindowRecord record;
+            record.handle = window.handle;
+            record.handleText = HandleText(window.handle);
+            record.title = window.title;
+            record.className = window.className;
+            record.processId = window.processId;
+            record.processName = window.processName;
+            record.isMinimized = window.isMinimized;
+            record.isMaximized = window.isMaximized;
+            records.push_back(std::move(record));
+        }
+    }
+
+    void BuildTable(const std::vector<RawWindow> &raw, WindowTable &table) {
+        table.Clear();
+        table.Reserve(raw.size());
+        for (const RawWindow &window : raw) {
+            table.Append(window.handle, window.title, window.className, window.processId, window.processName,
+                         window.isMinimized, window.isMaximized);
+        }
+    }
+
+    // 与 WindowManager::WindowToJson 相同，经由 nlohmann::json 对象再 dump
+    std::string SerializeRecords(const std::vector<WindowRecord> &records) {
+        nlohmann::json windows = nlohmann::json::array();
+        for (const WindowRecord &record : records) {
+            nlohmann::json windowJson;
+            windowJson["title"] = record.title.empty() ? "(无标题)" : record.title;
+            windowJson["handle"] = record.handleText;
+            windows.push_back(std::move(windowJson));
+        }
+        return windows.dump();
+    }
+
+    template <typename Fn>
+    void Run(const char *name, const size_t rounds, const size_t count, Fn &&fn) {
+        fn();
+        const size_t allocationsBefore = allocations;
+        const auto begin = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < rounds; i++) {
+            fn();
+        }
+        const auto elapsed = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - begin);
+        std::printf("%-36s %10.1f us/refresh %8.1f ns/window %10.1f allocs/refresh\n", name,
+                    elapsed.count() / rounds, elapsed.count() * 1000 / rounds / count,
+                    static_cast<double>(allocations - allocationsBefore) / rounds);
+    }
+
+    /**
+     * @brief 解析命令行中的数量参数
+     * @param text 参数文本
+     * @param value 解析结果
+     * @return 不是十进制正整数或超出范围时返回 false
+     */
+    bool ParseCount(const char *text, size_t &value) {
+        if (!std::isdigit(static_cast<unsigned char>(text[0]))) {
+            return false;
+        }
+        errno = 0;
+        char *end = nullptr;
+        const unsigned long long parsed = std::strtoull(text, &end, 10);
+        if (*end != '\0' || errno == ERANGE || parsed == 0 || parsed > SIZE_MAX) {
+            return false;
+        }
+        value = static_cast<size_t>(parsed);
+        return true;
+    }
+}
+
+// 每块内存前保存请求的大小，释放时从常驻字节数中扣除
+void *operator new(const size_t size) {
+    auto *block = static_cast<size_t *>(std::malloc(size + sizeof(std::max_align_t)));
+    if (block == nullptr) {
+        throw std::bad_alloc();
+    }
+    *block = size;
+    liveBytes += size;
+    allocations++;
+    return reinterpret_cast<char *>(block) + sizeof(std::max_align_t);
+}
+
+void operator delete(void *pointer) noexcept {
+    if (pointer == nullptr) {
+        return;
+    }
+    auto *block = reinterpret_cast<size_t *>(static_cast<char *>(pointer) - sizeof(std::max_align_t));
+    liveBytes -= *block;
+    std::free(block);
+}
+
+void operator delete(void *pointer, size_t) noexcept {
+    operator delete(pointer);
+}
+
+int main(int argc, char **argv) {
+    size_t count = 5000;
+    size_t rounds = 200;
+    if (argc > 3 || (argc > 1 && !ParseCount(argv[1], count)) || (argc > 2 && !ParseCount(argv[2], rounds))) {
+        std::fprintf(stderr, "用法: %s [窗口数] [轮数]，均为正整数\n", argv[0]);
+        return 1;
+    }
+    const std::vector<RawWindow> raw = GenerateWindows(count);
+    std::printf("windows: %zu, rounds: %zu\n", count, rounds);
+
+    size_t before = liveBytes;
+    std::vector<WindowRecord> records;
+    BuildRecords(raw, records);
+    const size_t recordBytes = liveBytes - before;
+
+    before = liveBytes;
+    WindowTable table;
+    BuildTable(raw, table);
+    const size_t tableBytes = liveBytes - before;
+    std::printf("resident: records %zu KB (%.1f B/window), table %zu KB (%.1f B/window), %.1fx smaller\n",
+                recordBytes / 1024, static_cast<double>(recordBytes) / count, tableBytes / 1024,
+                static_cast<double>(tableBytes) / count, static_cast<double>(recordBytes) / tableBytes);
+
+    std::string tableJson;
+    table.AppendJson(tableJson);
+    if (SerializeRecords(records) != tableJson) {
+        std::printf("serialized output differs\n");
+        return 1;
+    }
+
+    // 重建时两种表示都复用上一次的容量，与注册表每个版本重建一次的用法相同
+    Run("build records", rounds, count, [&] { BuildRecords(raw, records); sink = records.size(); });
+    Run("build table", rounds, count, [&] { BuildTable(raw, table); sink = table.Size(); });
+    Run("serialize records (nlohmann)", rounds, count, [&] { sink = SerializeRecords(records).size(); });
+    Run("serialize table", rounds, count, [&] {
+        tableJson.clear();
+        table.AppendJson(tableJson);
+        sink = tableJson.size();
+    });
+    Run("build + serialize records", rounds, count, [&] {
+        BuildRecords(raw, records);
+        sink = SerializeRecords(records).size();
+    });
+    Run("build + serialize table", rounds, count, [&] {
+        BuildTable(raw, table);
+        tableJson.clear();
+        table.AppendJson(tableJson);
+        sink = tableJson.size();
+    });
+    return 0;
+}
@@ -0,0 +1,17 @@
+# 以 gzip 格式压缩单个资源文件，由构建步骤调用：
+# cmake -DINPUT=<源文件> -DOUTPUT=<压缩文件> -P CompressResource.cmake
+cmake_minimum_required(VERSION 3.19)
+
+if (NOT INPUT OR NOT OUTPUT)
+    message(FATAL_ERROR "INPUT and OUTPUT must be specified.")
+endif ()
+
+get_filename_component(OUTPUT_DIR "${OUTPUT}" DIRECTORY)
+file(MAKE_DIRECTORY "${OUTPUT_DIR}")
+file(ARCHIVE_CREATE
+        OUTPUT "${OUTPUT}"
+        PATHS "${INPUT}"
+        FORMAT raw
+        COMPRESSION GZip
+        COMPRESSION_LEVEL 9
+)
@@ -2,12 +2,16 @@
 #include <winsock2.h>
 #include <windows.h>
 #include <memory>
+#include <string>
 #include <thread>
 
+#include "CommandDispatcher.h"
 #include "GlobalHotKeyManager.h"
 #include "HttpServer.h"
 #include "TrayManager.h"
 #include "WebViewController.h"
+#include "Win32WindowEventSource.h"
+#include "WindowRegistry.h"
 
 namespace v1_taskbar_manager {
     class Application {
@@ -33,12 +37,23 @@ namespace v1_taskbar_manager {
 
         void SetupSpdlog();
 
+        void RegisterApis();
+
+        void PublishWindows();
+
+        void PublishEvent(const std::string &name, const nlohmann::json &data);
+
         void Cleanup();
 
         HWND hWnd = nullptr;
         int hotKeyId = 0;
         std::unique_ptr<v2_taskbar_manager::HttpServer> httpServer;
+        std::unique_ptr<Win32WindowEventSource> windowEventSource;
+        std::unique_ptr<WindowRegistry> windowRegistry;
+        // 最近一次发布到广播中心的窗口注册表版本，未变化时不再发布
+        uint64_t publishedWindowsVersion = 0;
         std::shared_ptr<GlobalHotKeyManager> globalHotKeyManager;
+        std::unique_ptr<CommandDispatcher> commandDispatcher;
         std::unique_ptr<TrayManager> trayManager;
         std::unique_ptr<WebViewController> webViewController;
         HANDLE mutex = nullptr;
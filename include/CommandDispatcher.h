@@ -0,0 +1,61 @@
+#pragma once
+#include <windows.h>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+
+#include "GlobalHotKeyManager.h"
+#include "WindowRegistry.h"
+#include "WindowSnapshotHistory.h"
+#include <nlohmann/json.hpp>
+
+namespace v1_taskbar_manager {
+    /**
+     * @brief 命令的执行结果，对应消息协议中的 result
+     */
+    struct CommandResult {
+        int code;
+        std::string msg;
+        nlohmann::json data;
+
+        nlohmann::json ToJson() const { return {{"code", code}, {"msg", msg}, {"data", data}}; }
+    };
+
+    /**
+     * @brief 窗口与热键命令的分发层，WebView2 消息与 HTTP API 共用
+     * @note 命令会操作窗口与热键，必须在 UI 线程上执行；其他线程通过 Post 把命令投递到 UI 线程，
+     * 结果在 UI 线程上交给回调，投递方不等待。停止 HTTP 服务之前先调用 Stop，尚未执行的命令立即以空结果回调
+     */
+    class CommandDispatcher {
+    public:
+        // 命令的结果，为空表示分发层已停止，命令没有执行
+        using Callback = std::function<void(std::optional<CommandResult> result)>;
+
+        CommandDispatcher(HWND hWnd, const std::weak_ptr<GlobalHotKeyManager> &globalHotKeyManager,
+                          const WindowRegistry &windowRegistry);
+
+        CommandResult Dispatch(const std::string &cmd, const nlohmann::json &args) const;
+
+        void Post(std::string cmd, nlohmann::json args, Callback callback) const;
+
+        void HandleInvokeMessage(LPARAM lParam) const;
+
+        void Stop();
+
+    private:
+        struct PendingCommand;
+
+        HWND hWnd;
+        std::weak_ptr<GlobalHotKeyManager> globalHotKeyManager;
+        const WindowRegistry &windowRegistry;
+        // 返回过的窗口列表，用于计算增量，只在 UI 线程上访问
+        mutable WindowSnapshotHistory windowHistory;
+        // Stop 之后不再接受新的命令，投递在锁内进行，Stop 清理消息队列之后不会再出现新的命令
+        mutable std::mutex postMutex;
+        mutable bool stopping = false;
+
+        nlohmann::json WindowsToJson(const nlohmann::json &args) const;
+    };
+}
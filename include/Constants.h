@@ -3,6 +3,8 @@
 
 // 消息定义
 #define WM_TRAY_ICON (WM_USER + 1)
+// 其他线程投递到 UI 线程执行的命令，lParam 为 CommandDispatcher 分配的待执行命令
+#define WM_DISPATCH_COMMAND (WM_USER + 2)
 
 // 托盘菜单ID
 #define ID_TRAY_ABOUT 1001
@@ -10,6 +12,15 @@
 #define ID_TRAY_ENABLE_HOTKEY 1003
 #define ID_TRAY_LOCAL_APP_DATA 1004
 
+// 定时器ID
+#define ID_TIMER_PUBLISH_WINDOWS 2001
+
+// 有 WebSocket 客户端时检查窗口注册表并推送变化的间隔（毫秒），合并这段时间内的多次窗口事件
+inline constexpr unsigned int WINDOW_PUBLISH_INTERVAL = 500;
+
+// HTTP API 等待 UI 线程执行命令的最长时间（毫秒），超时响应 503
+inline constexpr unsigned int COMMAND_INVOKE_TIMEOUT = 3000;
+
 // 窗口类名和标题
 inline constexpr auto szWindowClass = L"TaskbarManager";
 inline constexpr auto szTitle = L"Windows 任务栏窗口管理器";
@@ -18,4 +29,7 @@ inline constexpr auto szTitle = L"Windows 任务栏窗口管理器";
 inline constexpr std::wstring_view APP_IDENTIFIER = L"TaskbarManager";
 
 // 程序目录下如果包含了此文件夹，会优先使用此文件夹下的WebView2 Runtime
-inline constexpr std::wstring_view WEBVIEW2_RUNTIME_PATH = L"webview2_runtime";
\ No newline at end of file
+inline constexpr std::wstring_view WEBVIEW2_RUNTIME_PATH = L"webview2_runtime";
+
+// 程序目录下如果包含了此文件夹，内嵌资源之外的路径会从此文件夹中查找，便于发布拆分后的前端资源
+inline constexpr std::wstring_view ASSET_ROOT_PATH = L"web";
@@ -0,0 +1,126 @@
+#pragma once
+#include <atomic>
+#include <sys/types.h>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#include "HttpBackend.h"
+#include "HttpConnection.h"
+#include "ObjectPool.h"
+#include "TimerWheel.h"
+
+namespace v2_taskbar_manager {
+    /**
+     * @brief 基于 epoll 的 Linux 后端
+     * @note 与 IocpBackend 共用 HttpConnection 状态机，用于在 Linux 上压测与回归测试请求处理路径。
+     * 每个工作线程拥有独立的监听套接字（SO_REUSEPORT）与 epoll 实例，连接只在一个线程内处理，无需加锁
+     */
+    class EpollBackend final : public HttpBackend {
+        struct EpollContext {
+            int socket = -1;
+            char recvData[2048];
+            bool wantWrite = false;
+            // 已关闭、等待本轮事件处理完毕后归还到池中，同一轮中该连接的其余事件直接跳过
+            bool closed = false;
+            // 等待请求数据（或等待 API 结果）时的超时定时器，发送响应期间不计时
+            TimerNode timer;
+
+            HttpConnection connection;
+
+            explicit EpollContext(const HttpServerOptions &options) : connection(options) { timer.owner = this; }
+        };
+
+        struct EventLoop {
+            int listenSocket = -1;
+            int epollFd = -1;
+            int wakeupFd = -1;
+            // 池耗尽时暂停接受连接，新连接留在内核的监听队列中
+            bool acceptPaused = false;
+            // 因文件描述符耗尽而暂停时恢复接受的时刻，未设置时为默认值
+            std::chrono::steady_clock::time_point acceptRetryAt{};
+            // 已开始停止：监听套接字已关闭，响应发送完毕的连接不再等待下一个请求
+            bool draining = false;
+            size_t drainConnections = 0;
+            // 其他线程发布的数据使这些推送会话有数据待发送、其他线程完成了这些 API 响应，通过 wakeupFd 唤醒事件循环处理
+            std::mutex readyMutex;
+            std::vector<std::shared_ptr<StreamSession>> readySessions;
+            std::vector<std::shared_ptr<HttpApiReply>> readyReplies;
+            std::thread thread;
+            std::unordered_set<EpollContext *> contexts;
+            // 本轮关闭的连接，处理完 epoll_wait 返回的全部事件之后才归还，避免后续事件访问已被复用的上下文
+            std::vector<EpollContext *> closedContexts;
+            ObjectPool<EpollContext> pool;
+            TimerWheel timers;
+            // 按 HttpWaitPhase 分类的超时关闭次数，由 GetStats 在其他线程读取
+            std::atomic<uint64_t> timeouts[3]{};
+            std::atomic<uint64_t> acceptsWithData{0};
+            std::atomic<uint64_t> connectionsRejected{0};
+            std::atomic<uint64_t> connectionsDeferred{0};
+
+            EventLoop(size_t poolCapacity, std::chrono::steady_clock::duration tick)
+                : pool(poolCapacity), timers(tick) {}
+        };
+
+        const HttpRequestHandler &handler;
+        const HttpServerOptions &options;
+        std::atomic<bool> isRunning{false};
+        // 由 Stop 设置，事件循环看到之后开始停止，直到连接全部关闭或到达期限
+        std::atomic<bool> draining{false};
+        std::chrono::steady_clock::time_point drainDeadline;
+        std::vector<std::unique_ptr<EventLoop>> loops;
+
+        int OpenLoop(EventLoop &loop, int port) const;
+
+        void AcceptConnections(EventLoop &loop);
+
+        ssize_t HandleReadable(EventLoop &loop, EpollContext *context);
+
+        void HandleWritable(EventLoop &loop, EpollContext *context);
+
+        static ssize_t SendPending(EpollContext *context);
+
+        void Dispatch(EventLoop &loop, EpollContext *context, HttpAction action);
+
+        void UpgradeContext(EventLoop &loop, EpollContext *context);
+
+        void WaitReply(EventLoop &loop, EpollContext *context);
+
+        void FinishReply(EventLoop &loop, EpollContext *context);
+
+        void HandleStream(EventLoop &loop, EpollContext *context, uint32_t events);
+
+        static bool FlushStream(EventLoop &loop, EpollContext *context);
+
+        void FlushReadySessions(EventLoop &loop);
+
+        static void SetInterest(const EventLoop &loop, const EpollContext *context, uint32_t events);
+
+        static void SetAcceptPaused(EventLoop &loop, bool paused);
+
+        static void PauseAcceptOnShortage(EventLoop &loop, int error);
+
+        static void CloseContext(EventLoop &loop, EpollContext *context);
+
+        static void ReleaseClosedContexts(EventLoop &loop);
+
+        void BeginDrain(EventLoop &loop);
+
+        static void CloseLoop(EventLoop &loop);
+
+        void CloseExpiredConnections(EventLoop &loop);
+
+        void WorkerThread(EventLoop &loop);
+
+    public:
+        EpollBackend(const HttpRequestHandler &handler, const HttpServerOptions &options);
+
+        int Start(int port) override;
+
+        HttpShutdownReport Stop() override;
+
+        HttpServerStats GetStats() const override;
+    };
+}
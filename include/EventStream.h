@@ -0,0 +1,98 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "StreamSession.h"
+
+namespace v2_taskbar_manager {
+    class EventStreamHub;
+
+    // 事件 ID "<epoch>-<sequence>" 的两部分：发布事件的进程的纪元与进程内从 1 开始的序号
+    struct EventId {
+        uint64_t epoch = 0;
+        uint64_t sequence = 0;
+    };
+
+    /**
+     * @brief 一个 Server-Sent Events 客户端的发送队列
+     * @note 事件在发布时已编码为 text/event-stream 格式，排队只是追加字节；
+     * 排队的事件达到环形缓冲区的容量时结束这个流，客户端重连后用 Last-Event-ID 从缓冲区中补齐
+     */
+    class EventStreamSession final : public StreamSession {
+    public:
+        EventStreamSession(EventStreamHub &hub, std::optional<EventId> lastEventId);
+
+        void Subscribe(void *owner, Notify notify) override;
+
+    private:
+        friend class EventStreamHub;
+
+        EventStreamHub *hub;
+        std::optional<EventId> lastEventId;
+        std::string queued;
+        size_t queuedEvents = 0;
+
+        void Unsubscribe() override;
+
+        bool HasPendingLocked() const override;
+
+        void FillLocked() override;
+
+        void ClearLocked() override;
+    };
+
+    /**
+     * @brief Server-Sent Events 的广播中心
+     * @note 最近的事件保存在固定容量的环形缓冲区中，事件 ID 由进程的纪元与从 1 开始递增的序号组成；
+     * 带 Last-Event-ID 重连的客户端先收到缓冲区中更新的事件，缺口超出缓冲区或 ID 来自其他进程时先收到一个 reset 事件
+     */
+    class EventStreamHub {
+    public:
+        explicit EventStreamHub(size_t capacity, size_t maxPendingBytes = SIZE_MAX);
+
+        EventStreamHub(const EventStreamHub &) = delete;
+
+        EventStreamHub &operator=(const EventStreamHub &) = delete;
+
+        uint64_t Publish(std::string_view event, std::string_view data);
+
+        void Subscribe(EventStreamSession &session, void *owner, StreamSession::Notify notify);
+
+        void CloseAll();
+
+        size_t SessionCount() const;
+
+        uint64_t Events() const { return events.load(std::memory_order_relaxed); }
+
+        uint64_t Overflows() const { return overflows.load(std::memory_order_relaxed); }
+
+        uint64_t Epoch() const { return epoch; }
+
+    private:
+        friend class EventStreamSession;
+
+        mutable std::mutex mutex;
+        // 按 (id - 1) % capacity 存放编码后的事件
+        std::vector<std::string> ring;
+        size_t maxPendingBytes;
+        // 进程的纪元，重启之后序号从 1 重新开始，纪元不同的 Last-Event-ID 不能与缓冲区中的序号比较
+        const uint64_t epoch;
+        uint64_t nextId = 1;
+        std::vector<std::shared_ptr<EventStreamSession>> sessions;
+        std::atomic<uint64_t> events{0};
+        std::atomic<uint64_t> overflows{0};
+
+        uint64_t OldestIdLocked() const;
+
+        void Remove(const EventStreamSession *session);
+    };
+
+    std::optional<EventId> ParseLastEventId(std::string_view value);
+}
@@ -0,0 +1,40 @@
+#pragma once
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace v2_taskbar_manager {
+    /**
+     * @brief 延迟完成的 API 响应，处理函数可以在任意线程上完成它
+     * @note 处理函数返回时尚未完成的响应由连接持有，连接进入等待状态，I/O 线程不阻塞；
+     * 后端通过 Watch 登记唤醒方式，Complete 在完成的线程上（持有 mutex）调用一次通知，
+     * 后端在 I/O 线程上用 Take 取出结果继续处理连接。连接关闭时 Detach，之后的完成被丢弃
+     */
+    class HttpApiReply : public std::enable_shared_from_this<HttpApiReply> {
+    public:
+        using Notify = std::function<void(HttpApiReply &)>;
+
+        bool Complete(int status, std::string body);
+
+        bool IsCompleted() const;
+
+        bool Watch(void *owner, Notify notify);
+
+        void *Owner() const;
+
+        int Take(std::string &body);
+
+        void Detach();
+
+    private:
+        mutable std::mutex mutex;
+        void *owner = nullptr;
+        Notify notify;
+        bool completed = false;
+        // 连接已关闭或已取出结果，不再接受完成
+        bool detached = false;
+        int status = 0;
+        std::string body;
+    };
+}
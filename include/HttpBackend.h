@@ -0,0 +1,30 @@
+#pragma once
+#include "HttpServerStats.h"
+
+namespace v2_taskbar_manager {
+    /**
+     * @brief 可插拔的完成端口/事件循环后端
+     * @note 后端只负责套接字与 I/O 调度，请求的解析与响应由 HttpConnection 完成，
+     * 这样同一套请求处理代码可以运行在 IOCP（Windows）与 epoll（Linux）之上
+     */
+    class HttpBackend {
+    public:
+        virtual ~HttpBackend() = default;
+
+        /**
+         * @brief 在回环地址上开始监听
+         * @param port 端口号，为 0 时由系统分配
+         * @return int 实际监听的端口号，失败返回 -1
+         */
+        virtual int Start(int port) = 0;
+
+        /**
+         * @brief 停止接受新连接，关闭等待请求的连接，进行中的响应在 drainTimeout 内发送完毕后关闭，
+         * 到期后取消其余连接；返回时所有连接上下文都已归还，工作线程都已结束
+         * @return HttpShutdownReport 停止所用的时间与连接的关闭情况
+         */
+        virtual HttpShutdownReport Stop() = 0;
+
+        virtual HttpServerStats GetStats() const = 0;
+    };
+}
@@ -0,0 +1,273 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "EventStream.h"
+#include "HttpApiReply.h"
+#include "HttpRequestParser.h"
+#include "HttpRouter.h"
+#include "HttpServerOptions.h"
+#include "StaticFileCache.h"
+#include "WebSocketHub.h"
+
+namespace v2_taskbar_manager {
+    /**
+     * @brief 一次 I/O 完成之后后端需要执行的动作
+     * @note Upgrade 表示 WebSocket 握手响应或事件流的响应头已发送完毕，后端需要订阅会话，并开始同时接收与推送；
+     * Wait 表示 API 的处理结果尚未完成，后端登记 Reply() 的完成通知，不接收也不发送，通知之后调用 OnReplied
+     */
+    enum class HttpAction { Receive, Send, Close, Upgrade, Wait };
+
+    /**
+     * @brief 一个待发送的响应，由头部与正文两段组成，后端以 scatter/gather 方式一次发送
+     * @note header/body 可以指向处理器启动时预先构建的只读数据，此时不产生任何分配与拷贝；
+     * 动态生成的响应写入 headerBuffer/bodyBuffer，池化的连接复用缓冲区已有的容量；
+     * 资源目录中的文件由 file 持有，fileLength 不为 0 时正文由后端直接从文件零拷贝发送
+     */
+    struct HttpResponse {
+        std::string_view header;
+        std::string_view body;
+        std::string headerBuffer;
+        std::string bodyBuffer;
+        std::shared_ptr<const StaticFile> file;
+        uint64_t fileLength = 0;
+
+        size_t Size() const { return header.size() + body.size() + static_cast<size_t>(fileLength); }
+
+        void Clear() {
+            header = {};
+            body = {};
+            file.reset();
+            fileLength = 0;
+        }
+    };
+
+    /**
+     * @brief 一个内嵌的静态资源，以及构建时生成的预压缩版本
+     * @note 压缩版本为空表示不可用，此时只提供原始内容
+     */
+    struct HttpAsset {
+        std::string path;
+        std::string contentType;
+        std::string identity;
+        std::string gzip;
+        std::string brotli;
+    };
+
+    /**
+     * @brief 交给 API 处理函数的请求，所有字段只在处理期间有效
+     */
+    struct HttpApiRequest {
+        const HttpRequest &request;
+        const HttpRouteParams &params;
+        std::string_view query;
+    };
+
+    /**
+     * @brief API 处理函数，在 I/O 工作线程上调用
+     * @note 把 JSON 正文写入 body（已清空，保留连接上次使用的容量），返回 HTTP 状态码
+     */
+    using HttpApiHandler = std::function<int(const HttpApiRequest &request, std::string &body)>;
+
+    /**
+     * @brief 延迟完成的 API 处理函数，在 I/O 工作线程上调用
+     * @note 处理函数不能等待结果，需要的请求字段复制出来之后立即返回，结果由任意线程调用 reply->Complete 给出；
+     * 超过 apiTimeout 仍未完成时以 503 响应
+     */
+    using HttpDeferredApiHandler =
+        std::function<void(const HttpApiRequest &request, const std::shared_ptr<HttpApiReply> &reply)>;
+
+    // handler 与 deferred 只设置其中一个
+    struct HttpApi {
+        std::string method;
+        std::string pattern;
+        HttpApiHandler handler;
+        HttpDeferredApiHandler deferred;
+    };
+
+    /**
+     * @brief 路由表中的一个端点
+     * @note index 为静态资源或 API 在处理器中的下标，其他端点不使用
+     */
+    struct HttpEndpoint {
+        enum Kind { Asset, WebSocket, EventStream, Api } kind = Asset;
+        size_t index = 0;
+    };
+
+    using HttpRoute = HttpRouteMatch<HttpEndpoint>;
+
+    /**
+     * @brief 与平台无关的请求处理器，根据请求行生成响应
+     * @note 固定的响应（静态资源的各个编码版本、404、501）在构造时一次性生成，405 的 Allow 随路径变化，在处理时生成，所有连接只读共享；
+     * 静态资源、推送端点与 API 在构造时登记到路由表，内嵌资源之外的路径在配置了资源目录时从目录中查找
+     */
+    class HttpRequestHandler {
+    public:
+        HttpRequestHandler(std::vector<HttpAsset> assets, const HttpServerOptions &options,
+                           WebSocketHub *webSocketHub = nullptr, EventStreamHub *eventStreamHub = nullptr,
+                           std::vector<HttpApi> apis = {});
+
+        HttpRoute Route(const HttpRequest &request) const;
+
+        std::shared_ptr<HttpApiReply> Handle(const HttpRequest &request, const HttpRoute &route, bool keepAlive,
+                                             HttpResponse &response) const;
+
+        void FinishApi(int status, bool keepAlive, HttpResponse &response) const;
+
+        void HandleParseError(HttpParseResult result, HttpResponse &response) const;
+
+        void HandleBodyTooLarge(HttpResponse &response) const;
+
+        // 连接数达到上限时发送给新连接的完整响应：503、Retry-After 与 Connection: close，没有正文
+        std::string_view OverloadedResponse() const { return overloaded.closeHeader; }
+
+        std::shared_ptr<WebSocketSession> Upgrade(const HttpRequest &request, HttpResponse &response) const;
+
+        std::shared_ptr<EventStreamSession> OpenEventStream(const HttpRequest &request, HttpResponse &response) const;
+
+        // 后端开始监听之后设置，API、WebSocket 与事件流只接受 Host 为本机地址与该端口的请求
+        void SetListeningPort(int port);
+
+    private:
+        enum Encoding { Identity, Gzip, Brotli, EncodingCount };
+
+        struct PrebuiltResponse {
+            std::string keepAliveHeader;
+            std::string closeHeader;
+            std::string_view body;
+        };
+
+        struct AssetVariant {
+            std::string etag;
+            PrebuiltResponse ok;
+            PrebuiltResponse notModified;
+        };
+
+        struct PrebuiltAsset {
+            // 按 Encoding 索引，不可用的编码版本 etag 为空
+            AssetVariant variants[EncodingCount];
+        };
+
+        std::vector<HttpAsset> assets;
+        std::vector<PrebuiltAsset> prebuiltAssets;
+        std::vector<HttpApi> apis;
+        HttpRouter<HttpEndpoint> router;
+        std::unique_ptr<StaticFileCache> files;
+        WebSocketHub *webSocketHub;
+        std::string webSocketPath;
+        EventStreamHub *eventStreamHub;
+        std::string eventStreamPath;
+        std::string eventStreamHeader;
+        PrebuiltResponse notFound;
+        PrebuiltResponse notImplemented;
+        PrebuiltResponse badRequest;
+        PrebuiltResponse headerTooLarge;
+        PrebuiltResponse bodyTooLarge;
+        PrebuiltResponse forbidden;
+        PrebuiltResponse upgradeRequired;
+        PrebuiltResponse overloaded;
+        // 设置之前为 0，拒绝所有需要校验来源的请求；listeningPortSuffix 为 ":端口"，先于端口写入
+        std::atomic<int> listeningPort{0};
+        std::string listeningPortSuffix;
+
+        bool IsSameOrigin(const HttpRequest &request) const;
+
+        std::shared_ptr<HttpApiReply> HandleApi(const HttpApi &api, const HttpRequest &request, const HttpRoute &route,
+                                                bool keepAlive, HttpResponse &response) const;
+
+        static const AssetVariant &Negotiate(const PrebuiltAsset &asset, std::string_view acceptEncoding);
+
+        static AssetVariant PrebuildVariant(const HttpAsset &asset, std::string_view body, std::string etag,
+                                            std::string_view headers);
+
+        static PrebuiltResponse Prebuild(std::string_view statusLine, std::string_view contentType,
+                                         std::string_view body, std::string_view extraHeaders = {});
+
+        static PrebuiltResponse PrebuildNotModified(std::string_view headers);
+
+        static void Use(const PrebuiltResponse &prebuilt, bool keepAlive, HttpResponse &response);
+
+        static void UseFile(std::shared_ptr<const StaticFile> file, bool notModified, bool keepAlive,
+                            HttpResponse &response);
+
+        static void UseMethodNotAllowed(std::string_view allow, bool keepAlive, HttpResponse &response);
+    };
+
+    /**
+     * @brief 连接等待请求数据时所处的阶段，决定适用的超时
+     */
+    enum class HttpWaitPhase { FirstByte, Header, Idle };
+
+    /**
+     * @brief 与平台无关的连接状态机
+     * @note 只负责请求数据的累积、解析与响应数据的发送进度，真正的 I/O 由各个后端（IOCP、epoll）完成。
+     * 支持 HTTP/1.1 持久连接与管线化：一个请求头之后的剩余数据会作为下一个请求的开始。
+     * 一次接收到完整请求时直接在接收缓冲区上解析，只有跨越多次接收的数据才会被缓存。
+     * WebSocket 握手完成之后，接收的数据按帧解析，推送数据由会话的发送队列提供
+     */
+    class HttpConnection {
+    public:
+        explicit HttpConnection(const HttpServerOptions &options);
+
+        void Reset();
+
+        HttpAction OnReceived(const char *data, size_t length, const HttpRequestHandler &handler);
+
+        HttpAction OnSent(size_t bytes, const HttpRequestHandler &handler);
+
+        HttpWaitPhase WaitPhase() const;
+
+        std::chrono::steady_clock::time_point ReceiveDeadline() const;
+
+        size_t PendingBuffers(std::string_view (&buffers)[2]) const;
+
+        const StaticFile *PendingFile(uint64_t &offset, size_t &length) const;
+
+        size_t PendingSize() const { return response.Size() - sendCount; }
+
+        bool ClosesAfterResponse() const { return !keepAlive; }
+
+        StreamSession *Stream() const { return upgraded ? stream.get() : nullptr; }
+
+        // 等待中的 API 响应，返回 Wait 之后到 OnReplied 之前不为空
+        HttpApiReply *Reply() const { return reply.get(); }
+
+        std::chrono::steady_clock::time_point ReplyDeadline() const { return requestStartedAt + options->apiTimeout; }
+
+        HttpAction OnReplied(const HttpRequestHandler &handler);
+
+        void Close();
+
+    private:
+        const HttpServerOptions *options;
+        HttpRequestParser parser;
+        // 跨越多次接收的请求数据，requestBegin 之前的部分已处理完毕
+        std::string requestData;
+        size_t requestBegin = 0;
+        HttpResponse response;
+        size_t sendCount = 0;
+        size_t requestCount = 0;
+        bool keepAlive = false;
+        std::chrono::steady_clock::time_point acceptedAt;
+        std::chrono::steady_clock::time_point requestStartedAt;
+        std::chrono::steady_clock::time_point lastActivity;
+        // 握手响应（或事件流的响应头）发送完毕之前 upgraded 为 false；webSocket 指向 stream，事件流时为 nullptr
+        std::shared_ptr<StreamSession> stream;
+        WebSocketSession *webSocket = nullptr;
+        bool upgraded = false;
+        std::shared_ptr<HttpApiReply> reply;
+
+        HttpAction OnWebSocketReceived(const char *data, size_t length);
+
+        HttpAction ProcessNextRequest(const HttpRequestHandler &handler);
+
+        HttpAction ProcessRequest(std::string_view buffer, const HttpRequestHandler &handler, size_t &consumed);
+    };
+}
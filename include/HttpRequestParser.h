@@ -0,0 +1,98 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace v2_taskbar_manager {
+    bool EqualsIgnoreCase(std::string_view a, std::string_view b);
+
+    struct HttpHeader {
+        std::string_view name;
+        std::string_view value;
+    };
+
+    /**
+     * @brief 一个已解析的请求，所有字段都指向接收缓冲区，只在处理期间有效
+     */
+    struct HttpRequest {
+        std::string_view method;
+        std::string_view path;
+        std::string_view protocol;
+        const HttpHeader *headers = nullptr;
+        size_t headerCount = 0;
+        // Content-Length 声明的请求体，由连接在请求体接收完整之后设置，解析器不读取请求体
+        std::string_view body;
+
+        std::string_view Header(std::string_view name) const;
+    };
+
+    enum class HttpParseResult {
+        // 请求头尚未完整，需要继续接收数据
+        Incomplete,
+        // 请求头已完整，可以通过 Request() 与 Consumed() 取得结果
+        Complete,
+        // 请求格式错误
+        BadRequest,
+        // 请求头超过大小或数量限制
+        TooLarge
+    };
+
+    /**
+     * @brief 可恢复的增量请求头解析器
+     * @note 解析器不复制、不分配：只记录各个字段在缓冲区中的偏移，数据不完整时记住已扫描的位置，
+     * 下次在追加了数据的同一缓冲区上从该位置继续，因此缓冲区扩容导致地址变化也不影响解析。
+     * 解析完成后 Request() 中的字段指向最后一次传入的缓冲区
+     */
+    class HttpRequestParser {
+    public:
+        static constexpr size_t kMaxHeaderCount = 64;
+
+        explicit HttpRequestParser(size_t maxHeaderSize = 8192);
+
+        void Reset();
+
+        HttpParseResult Parse(std::string_view buffer);
+
+        const HttpRequest &Request() const { return request; }
+
+        size_t Consumed() const { return position; }
+
+    private:
+        enum class State {
+            Method,
+            Path,
+            Protocol,
+            RequestLineEnd,
+            HeaderStart,
+            HeaderName,
+            HeaderValueStart,
+            HeaderValue,
+            HeadersEnd,
+            Done
+        };
+
+        struct Range {
+            uint32_t begin;
+            uint32_t end;
+        };
+
+        struct HeaderRange {
+            Range name;
+            Range value;
+        };
+
+        size_t maxHeaderSize;
+        State state = State::Method;
+        size_t position = 0;
+        size_t tokenBegin = 0;
+        Range method{};
+        Range path{};
+        Range protocol{};
+        HeaderRange headerRanges[kMaxHeaderCount]{};
+        size_t headerCount = 0;
+        HttpHeader headers[kMaxHeaderCount];
+        HttpRequest request;
+
+        HttpParseResult Complete(std::string_view buffer);
+    };
+}
@@ -0,0 +1,231 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace v2_taskbar_manager {
+    /**
+     * @brief 路由匹配时从路径中提取的参数，指向请求路径，只在处理期间有效
+     */
+    struct HttpRouteParams {
+        static constexpr size_t kMaxParams = 4;
+
+        std::string_view names[kMaxParams];
+        std::string_view values[kMaxParams];
+        size_t count = 0;
+
+        std::string_view Get(std::string_view name) const;
+    };
+
+    template <typename Target>
+    struct HttpRouteMatch {
+        // 方法与路径都匹配时指向路由的目标
+        const Target *target = nullptr;
+        // 路径匹配但没有该方法的路由，此时应响应 405
+        bool pathMatched = false;
+        // 路径匹配时该路径上登记的方法，例如 "GET, PUT"，用作 405 响应的 Allow 头部；指向路由表
+        std::string_view allow;
+        HttpRouteParams params;
+        // 去掉查询字符串之后的路径与查询字符串（不含 '?'）
+        std::string_view path;
+        std::string_view query;
+    };
+
+    std::pair<std::string_view, std::string_view> SplitQuery(std::string_view target);
+
+    std::string_view QueryParameter(std::string_view query, std::string_view name);
+
+    /**
+     * @brief 按方法与路径查找目标的路由表
+     * @note 路径按 '/' 分段组织为前缀树，节点存放在连续的数组中。每个节点的静态子节点按段排序、二分查找，
+     * 另有至多一个参数子节点（":name"，匹配一段）与一个通配子节点（"*name"，匹配剩余的全部路径）。
+     * 匹配时静态段优先于参数，参数优先于通配，静态分支走不通时回溯。
+     * 路由在启动时一次性添加，之后只读，多个线程可以同时匹配；匹配不分配内存
+     */
+    template <typename Target>
+    class HttpRouter {
+    public:
+        HttpRouter() : nodes(1) {}
+
+        /**
+         * @brief 添加一个路由
+         * @param method 请求方法，为空时匹配任意方法
+         * @param pattern 以 '/' 开头的路径模式，例如 "/api/windows/:handle"
+         * @param target 匹配时返回的目标
+         * @return 模式不合法、参数过多、与已有的参数名冲突或同一方法重复添加时返回 false
+         */
+        bool Add(std::string_view method, std::string_view pattern, Target target) {
+            if (pattern.empty() || pattern.front() != '/') {
+                return false;
+            }
+            uint32_t node = 0;
+            size_t paramCount = 0;
+            std::string_view rest = pattern.substr(1);
+            bool more = !rest.empty();
+            while (more) {
+                const size_t slash = rest.find('/');
+                const std::string_view segment = rest.substr(0, slash);
+                more = slash != std::string_view::npos;
+                rest = more ? rest.substr(slash + 1) : std::string_view();
+
+                if (!segment.empty() && (segment.front() == ':' || segment.front() == '*')) {
+                    const bool wildcard = segment.front() == '*';
+                    // 通配段必须是最后一段
+                    if (segment.size() == 1 || ++paramCount > HttpRouteParams::kMaxParams || (wildcard && more)) {
+                        return false;
+                    }
+                    uint32_t child = wildcard ? nodes[node].wildcardChild : nodes[node].paramChild;
+                    if (child == kNone) {
+                        // NewNode 可能使节点的引用失效，创建之后再写回父节点
+                        child = NewNode();
+                        nodes[child].paramName = std::string(segment.substr(1));
+                        (wildcard ? nodes[node].wildcardChild : nodes[node].paramChild) = child;
+                    } else if (nodes[child].paramName != segment.substr(1)) {
+                        return false;
+                    }
+                    node = child;
+                } else {
+                    node = StaticChild(node, segment);
+                }
+            }
+
+            std::vector<std::pair<std::string, Target>> &targets = nodes[node].targets;
+            const auto exists = std::find_if(targets.begin(), targets.end(),
+                                             [method](const auto &item) { return item.first == method; });
+            if (exists != targets.end()) {
+                return false;
+            }
+            targets.emplace_back(std::string(method), std::move(target));
+            if (!method.empty()) {
+                std::string &allow = nodes[node].allow;
+                allow.append(allow.empty() ? "" : ", ").append(method);
+            }
+            return true;
+        }
+
+        /**
+         * @brief 查找请求对应的路由
+         * @param method 请求方法
+         * @param requestTarget 请求行中的路径，可以带查询字符串
+         * @return HttpRouteMatch<Target> 没有匹配的路由时 target 为 nullptr
+         */
+        HttpRouteMatch<Target> Match(std::string_view method, std::string_view requestTarget) const {
+            HttpRouteMatch<Target> match;
+            std::tie(match.path, match.query) = SplitQuery(requestTarget);
+            if (match.path.empty() || match.path.front() != '/') {
+                return match;
+            }
+            const uint32_t node = Find(0, match.path.substr(1), !match.path.substr(1).empty(), match.params);
+            if (node == kNone) {
+                return match;
+            }
+            match.pathMatched = true;
+            match.allow = nodes[node].allow;
+            // 与方法完全一致的路由优先于匹配任意方法的路由
+            for (const auto &[targetMethod, target] : nodes[node].targets) {
+                if (targetMethod == method) {
+                    match.target = &target;
+                    return match;
+                }
+            }
+            for (const auto &[targetMethod, target] : nodes[node].targets) {
+                if (targetMethod.empty()) {
+                    match.target = &target;
+                    return match;
+                }
+            }
+            return match;
+        }
+
+    private:
+        static constexpr uint32_t kNone = UINT32_MAX;
+
+        struct Node {
+            // 按段排序的静态子节点
+            std::vector<std::pair<std::string, uint32_t>> children;
+            uint32_t paramChild = kNone;
+            uint32_t wildcardChild = kNone;
+            // 参数节点与通配节点的参数名
+            std::string paramName;
+            // 以该节点结束的路径上按方法注册的目标
+            std::vector<std::pair<std::string, Target>> targets;
+            // targets 中的方法（不含匹配任意方法的空方法），以 ", " 分隔
+            std::string allow;
+        };
+
+        std::vector<Node> nodes;
+
+        uint32_t NewNode() {
+            nodes.emplace_back();
+            return static_cast<uint32_t>(nodes.size() - 1);
+        }
+
+        uint32_t StaticChild(const uint32_t node, const std::string_view segment) {
+            auto &children = nodes[node].children;
+            const auto it = std::lower_bound(children.begin(), children.end(), segment,
+                                             [](const auto &item, std::string_view key) { return item.first < key; });
+            if (it != children.end() && it->first == segment) {
+                return it->second;
+            }
+            const size_t position = it - children.begin();
+            const uint32_t child = NewNode();
+            // NewNode 可能使引用失效，重新取得子节点数组
+            auto &updated = nodes[node].children;
+            updated.insert(updated.begin() + static_cast<std::ptrdiff_t>(position),
+                           std::make_pair(std::string(segment), child));
+            return child;
+        }
+
+        /**
+         * @brief 从 node 开始匹配剩余的路径
+         * @param node 当前节点
+         * @param rest 剩余的路径（不含开头的 '/'）
+         * @param more 是否还有未匹配的段，用于区分 "/a" 与 "/a/"
+         * @param params [输出] 匹配到的参数，回溯时撤销
+         * @return uint32_t 有目标的终止节点，没有匹配时返回 kNone
+         */
+        uint32_t Find(const uint32_t node, const std::string_view rest, const bool more,
+                      HttpRouteParams &params) const {
+            const Node &current = nodes[node];
+            if (!more) {
+                return current.targets.empty() ? kNone : node;
+            }
+            const size_t slash = rest.find('/');
+            const std::string_view segment = rest.substr(0, slash);
+            const bool next = slash != std::string_view::npos;
+            const std::string_view tail = next ? rest.substr(slash + 1) : std::string_view();
+
+            const auto it = std::lower_bound(current.children.begin(), current.children.end(), segment,
+                                             [](const auto &item, std::string_view key) { return item.first < key; });
+            if (it != current.children.end() && it->first == segment) {
+                if (const uint32_t found = Find(it->second, tail, next, params); found != kNone) {
+                    return found;
+                }
+            }
+            if (current.paramChild != kNone && !segment.empty()) {
+                const size_t saved = params.count;
+                Push(params, nodes[current.paramChild].paramName, segment);
+                if (const uint32_t found = Find(current.paramChild, tail, next, params); found != kNone) {
+                    return found;
+                }
+                params.count = saved;
+            }
+            if (current.wildcardChild != kNone && !nodes[current.wildcardChild].targets.empty()) {
+                Push(params, nodes[current.wildcardChild].paramName, rest);
+                return current.wildcardChild;
+            }
+            return kNone;
+        }
+
+        static void Push(HttpRouteParams &params, const std::string &name, const std::string_view value) {
+            params.names[params.count] = name;
+            params.values[params.count] = value;
+            params.count++;
+        }
+    };
+}
@@ -1,15 +1,26 @@
 #pragma once
+#ifdef _WIN32
 #include <winsock2.h>
 #include <mswsock.h>
 #include <windows.h>
+#endif
 #include <atomic>
+#include <memory>
 #include <string>
 #include <thread>
+#include <vector>
 
+#include "EventStream.h"
+#include "HttpBackend.h"
+#include "HttpConnection.h"
+#include "HttpServerOptions.h"
+#include "PollServer.h"
+#include "WebSocketHub.h"
+
+#ifdef _WIN32
 namespace v1_taskbar_manager {
     class HttpServer {
-        std::thread serverThread;
-        std::atomic<bool> shouldStop{false};
+        std::unique_ptr<PollServer> server;
 
     public:
         HttpServer();
@@ -23,34 +34,41 @@ namespace v1_taskbar_manager {
         static int GetPreferredPort();
     };
 }
+#endif
 
 namespace v2_taskbar_manager {
     class HttpServer {
-        struct IOContext {
-            OVERLAPPED overlapped;
-            SOCKET socket = INVALID_SOCKET;
-            WSABUF buffer;
-            char recvData[2048];
-            std::string sendData;
-            size_t sendCount;
-            enum { OP_ACCEPT, OP_RECV, OP_SEND } op;
-
-            std::string requestData;
-            bool headerComplete = false;
-        };
-
-        SOCKET listenSocket = INVALID_SOCKET;
-        std::atomic<bool> isRunning{false};
-        HANDLE completionPort = INVALID_HANDLE_VALUE;
-        LPFN_ACCEPTEX lpFnAcceptEx = nullptr;
-        std::thread worker;
-
-        void PostAccept();
-        void WorkerThread();
+        HttpServerOptions options;
+        // 必须先于后端创建、晚于后端销毁，关闭连接时会话需要从中移除
+        WebSocketHub webSocketHub;
+        EventStreamHub eventStreamHub;
+        std::vector<HttpApi> apis;
+        std::unique_ptr<HttpRequestHandler> handler;
+        std::unique_ptr<HttpBackend> backend;
 
     public:
+        explicit HttpServer(const HttpServerOptions &options = {});
+
+        ~HttpServer();
+
+        void AddApi(std::string method, std::string pattern, HttpApiHandler handler);
+
+        void AddDeferredApi(std::string method, std::string pattern, HttpDeferredApiHandler handler);
+
+#ifdef _WIN32
         int Start();
+#endif
 
-        void Stop();
+        int Start(std::string html, int port);
+
+        int Start(std::vector<HttpAsset> assets, int port);
+
+        HttpShutdownReport Stop();
+
+        HttpServerStats GetStats() const;
+
+        WebSocketHub &GetWebSocketHub() { return webSocketHub; }
+
+        EventStreamHub &GetEventStreamHub() { return eventStreamHub; }
     };
 }
\ No newline at end of file
@@ -0,0 +1,78 @@
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <string>
+#include <thread>
+
+namespace v2_taskbar_manager {
+    /**
+     * @brief 连接数达到上限之后对新连接的处理方式
+     */
+    enum class HttpOverloadPolicy {
+        // 暂停接受，新连接在监听队列中等待，直到有连接关闭
+        Defer,
+        // 继续接受，立即响应 503 与 Retry-After 之后关闭，不占用连接上下文
+        Reject,
+    };
+
+    /**
+     * @brief HTTP 服务器的连接策略配置
+     */
+    struct HttpServerOptions {
+        // 持久连接在两次请求之间允许空闲的最长时间
+        std::chrono::milliseconds idleTimeout{5000};
+        // 连接建立之后等待第一个字节的最长时间
+        std::chrono::milliseconds firstByteTimeout{5000};
+        // 从请求的第一个字节到请求头接收完整的最长时间，不随后续数据延长，用于关闭逐字节发送请求头的连接
+        std::chrono::milliseconds headerTimeout{10000};
+        // 单个持久连接最多处理的请求数，达到上限后响应 Connection: close
+        size_t maxRequestsPerConnection = 100;
+        // 请求行与全部头部的最大字节数，超过时响应 431 并关闭连接
+        size_t maxRequestHeaderSize = 8192;
+        // Content-Length 声明的请求体的最大字节数，超过时响应 413 并关闭连接
+        size_t maxRequestBodySize = 64 * 1024;
+        // 连接上下文池的容量，即同时存在的连接（含等待中的 AcceptEx）上限
+        size_t connectionPoolSize = 1024;
+        // 连接数达到 connectionPoolSize 之后对新连接的处理方式
+        HttpOverloadPolicy overloadPolicy = HttpOverloadPolicy::Defer;
+        // Reject 策略下 503 响应的 Retry-After 秒数
+        std::chrono::seconds overloadRetryAfter{1};
+        // 单个推送连接（WebSocket 控制帧、事件流）允许积压的未发送字节数，超过时结束该连接
+        size_t maxPendingBytes = 1024 * 1024;
+        // 延迟完成的 API 等待处理结果的最长时间，到期后以 503 与 apiTimeoutBody 响应
+        std::chrono::milliseconds apiTimeout{3000};
+        // 延迟完成的 API 超时（或停止时仍未完成）的 JSON 正文
+        std::string apiTimeoutBody = R"({"code":20000,"msg":"处理超时","data":null})";
+        // 停止时等待进行中的响应发送完毕的最长时间，到期后仍未完成的连接被取消
+        std::chrono::milliseconds drainTimeout{1000};
+        // 同时挂起的 AcceptEx 数量，突发的新连接不必等待上一个接受完成之后才被取走（仅 IOCP）
+        size_t acceptDepth = 4;
+        // 接受连接时一并接收第一段请求数据：IOCP 下 AcceptEx 携带接收缓冲区，Linux 下监听套接字设置 TCP_DEFER_ACCEPT
+        bool acceptWithFirstRead = true;
+        // I/O 工作线程数，为 0 时按 CPU 核心数创建
+        size_t workerThreads = 0;
+        // 静态资源目录，为空时只提供内嵌资源；内嵌资源之外的路径从该目录中查找
+        std::filesystem::path assetRoot;
+        // 不小于该大小的文件以 TransmitFile/sendfile 零拷贝发送，较小的文件映射到内存后与头部一起发送
+        size_t zeroCopyThreshold = 64 * 1024;
+        // 静态资源的缓存时间，为 0 时响应 no-cache，浏览器每次都用 ETag 重新验证
+        std::chrono::seconds staticMaxAge{0};
+        // 推送窗口列表变化的 WebSocket 端点，为空时不接受 WebSocket 连接
+        std::string webSocketPath = "/ws";
+        // 推送原生事件的 Server-Sent Events 端点，为空时不提供事件流
+        std::string eventStreamPath = "/events";
+        // 事件流保留的最近事件数，用于 Last-Event-ID 重连补发，也是单个客户端允许积压的事件数上限
+        size_t eventStreamCapacity = 256;
+        // Linux 下使用 io_uring 后端代替 epoll，内核不支持时回退到 epoll
+        bool useIoUring = false;
+
+        size_t ResolveWorkerThreads() const {
+            if (workerThreads > 0) {
+                return workerThreads;
+            }
+            const unsigned int cores = std::thread::hardware_concurrency();
+            return cores > 0 ? cores : 1;
+        }
+    };
+}
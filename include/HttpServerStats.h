@@ -0,0 +1,62 @@
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace v2_taskbar_manager {
+    /**
+     * @brief HTTP 服务器运行时计数器的快照
+     */
+    struct HttpServerStats {
+        // 连接上下文池的容量
+        size_t poolCapacity = 0;
+        // 正在使用的连接上下文数
+        size_t poolInUse = 0;
+        // 同时使用的连接上下文数的峰值
+        size_t poolPeak = 0;
+        // 连接上下文池耗尽的次数
+        uint64_t poolExhausted = 0;
+        // 连接数达到上限时以 503 拒绝的连接数（Reject 策略）
+        uint64_t connectionsRejected = 0;
+        // 连接数达到上限而推迟接受新连接的次数，新连接在监听队列中等待（Defer 策略）
+        uint64_t connectionsDeferred = 0;
+        // 当前挂起的 AcceptEx 数（仅 IOCP）
+        size_t acceptsPending = 0;
+        // 挂起的 AcceptEx 全部被取走的次数，此后到达的连接在监听队列中等待补投（仅 IOCP）
+        uint64_t acceptsDrained = 0;
+        // 接受时已经带有第一段请求数据的连接数（IOCP 与 epoll）
+        uint64_t acceptsWithData = 0;
+        // 监听队列中已完成握手、等待被接受的连接数（仅 Linux）
+        size_t acceptBacklog = 0;
+        // 连接建立之后没有发送任何数据而超时关闭的连接数
+        uint64_t firstByteTimeouts = 0;
+        // 请求头未能在期限内接收完整而超时关闭的连接数
+        uint64_t headerTimeouts = 0;
+        // 持久连接空闲超时关闭的连接数
+        uint64_t idleTimeouts = 0;
+        // 当前订阅的 WebSocket 客户端数
+        size_t webSocketSessions = 0;
+        // 推送给 WebSocket 客户端的变化消息数
+        uint64_t webSocketMessages = 0;
+        // 发送之前被合并掉的变化数
+        uint64_t webSocketCoalesced = 0;
+        // 当前订阅的事件流客户端数
+        size_t eventStreamSessions = 0;
+        // 发布的事件数
+        uint64_t eventStreamEvents = 0;
+        // 积压的事件超过缓冲区容量而被结束的事件流数
+        uint64_t eventStreamOverflows = 0;
+    };
+
+    /**
+     * @brief 一次停止过程的结果
+     */
+    struct HttpShutdownReport {
+        // 从开始停止到所有连接上下文归还、工作线程结束所用的时间
+        std::chrono::milliseconds duration{0};
+        // 开始停止时存在的连接数
+        size_t connections = 0;
+        // 期限到达时仍未完成、被取消的连接数，其余连接在期限内关闭
+        size_t aborted = 0;
+    };
+}
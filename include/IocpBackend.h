@@ -0,0 +1,147 @@
+#pragma once
+#include <winsock2.h>
+#include <mswsock.h>
+#include <windows.h>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#include "HttpBackend.h"
+#include "HttpConnection.h"
+#include "ObjectPool.h"
+#include "TimerWheel.h"
+
+namespace v2_taskbar_manager {
+    class IocpBackend final : public HttpBackend {
+        struct IOContext;
+
+        // 一个挂起的重叠操作，完成时通过 OVERLAPPED 的地址找回所属的上下文
+        struct IOOperation {
+            OVERLAPPED overlapped{};
+            IOContext *context = nullptr;
+            enum { OP_ACCEPT, OP_RECV, OP_SEND, OP_PUSH_WAKE, OP_PUSH_SEND, OP_REPLY_WAKE, OP_REJECT } op = OP_ACCEPT;
+        };
+
+        struct IOContext {
+            // 接受连接、接收与 HTTP 响应的发送
+            IOOperation io;
+            // 推送连接（WebSocket、事件流）上与接收同时挂起的推送；等待 API 结果的连接用它投递完成的唤醒
+            IOOperation push;
+            SOCKET socket = INVALID_SOCKET;
+            WSABUF buffer{};
+            WSABUF pushBuffer{};
+            // 响应的头部与正文分两段发送
+            WSABUF sendBuffers[2]{};
+            // 以 TransmitFile 发送文件时，头部作为文件之前的前缀
+            TRANSMIT_FILE_BUFFERS transmitBuffers{};
+            char recvData[2048];
+
+            // 挂起的 I/O 操作持有一个引用，超时处理时临时持有一个引用，归零时才关闭套接字并释放
+            std::atomic<long> refCount{1};
+            // 等待请求数据时的超时定时器与设置时所处的阶段，受 timerMutex 保护
+            TimerNode timer;
+            HttpWaitPhase waitPhase = HttpWaitPhase::FirstByte;
+            // 等待中的 API 响应，受 timerMutex 保护，超时与停止时由推进时间轮的线程以 apiTimeoutBody 完成
+            std::shared_ptr<HttpApiReply> reply;
+
+            HttpConnection connection;
+
+            explicit IOContext(const HttpServerOptions &options) : connection(options) {
+                io.context = this;
+                push.context = this;
+                timer.owner = this;
+            }
+
+            void Reset(SOCKET acceptSocket);
+        };
+
+        const HttpRequestHandler &handler;
+        const HttpServerOptions &options;
+        SOCKET listenSocket = INVALID_SOCKET;
+        std::atomic<bool> isRunning{false};
+        // 停止期间不再投递 AcceptEx，响应发送完毕的连接不再等待下一个请求；上下文归还时通知 Stop
+        std::atomic<bool> draining{false};
+        std::mutex drainMutex;
+        std::condition_variable drainCondition;
+        HANDLE completionPort = nullptr;
+        LPFN_ACCEPTEX lpFnAcceptEx = nullptr;
+        LPFN_TRANSMITFILE lpFnTransmitFile = nullptr;
+        std::vector<std::thread> workers;
+        // 池耗尽时没有投递的 AcceptEx 数，有上下文归还时补投
+        std::atomic<long> acceptsDeferred{0};
+        std::atomic<long> acceptsPending{0};
+        std::atomic<uint64_t> acceptsDrained{0};
+        std::atomic<uint64_t> acceptsWithData{0};
+        // Reject 策略下池耗尽时在池外挂起的一个 AcceptEx，接受的连接不占用上下文，响应 503 之后关闭
+        IOOperation rejectOperation;
+        SOCKET rejectSocket = INVALID_SOCKET;
+        char rejectAddresses[2 * (sizeof(sockaddr_in) + 16)];
+        std::atomic<bool> rejectPosted{false};
+        std::atomic<uint64_t> connectionsRejected{0};
+        std::atomic<uint64_t> connectionsDeferred{0};
+        // 携带接收缓冲区、尚未完成的 AcceptEx，用于关闭建立连接之后迟迟不发送数据的客户端
+        std::mutex acceptMutex;
+        std::unordered_set<IOContext *> accepting;
+        ObjectPool<IOContext> contextPool;
+        // 所有 Worker 线程共用的超时时间轮，下一次推进的时间（steady_clock 计数）决定由哪个线程推进
+        std::mutex timerMutex;
+        TimerWheel timers;
+        std::atomic<long long> nextTick{0};
+        // 按 HttpWaitPhase 分类的超时关闭次数
+        std::atomic<uint64_t> timeouts[3]{};
+
+        void PostAccept();
+
+        void FinishAccept(IOContext *context);
+
+        void OnAccepted(IOContext *context, DWORD bytes);
+
+        void CloseIdleAccepts();
+
+        void PostReject();
+
+        void OnRejected(bool accepted);
+
+        void PostRecv(IOContext *context);
+
+        void PostSend(IOContext *context);
+
+        void Dispatch(IOContext *context, HttpAction action);
+
+        void UpgradeContext(IOContext *context);
+
+        void WaitReply(IOContext *context);
+
+        void FinishReply(IOContext *context);
+
+        void PostPush(IOContext *context);
+
+        void OnPushed(IOContext *context, DWORD bytes);
+
+        static void AbortStream(IOContext *context);
+
+        static bool TryAddRef(IOContext *context);
+
+        void Release(IOContext *context);
+
+        void ScheduleTimer(IOContext *context);
+
+        void CancelTimer(IOContext *context);
+
+        void CloseExpiredConnections();
+
+        void WorkerThread();
+
+    public:
+        IocpBackend(const HttpRequestHandler &handler, const HttpServerOptions &options);
+
+        int Start(int port) override;
+
+        HttpShutdownReport Stop() override;
+
+        HttpServerStats GetStats() const override;
+    };
+}
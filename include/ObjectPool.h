@@ -0,0 +1,119 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace v2_taskbar_manager {
+    /**
+     * @brief 固定容量的对象池
+     * @note 所有对象存放在一次性分配的连续内存（slab）中，首次使用时才构造，归还后不析构而是放回空闲链表，
+     * 因此对象内部的缓冲区会保留已有容量。池满时 Acquire 返回 nullptr，由调用方决定如何处理
+     */
+    template <typename T>
+    class ObjectPool {
+    public:
+        explicit ObjectPool(size_t capacity)
+            : slab(new Slot[capacity]), capacity(capacity) {
+            freeList.reserve(capacity);
+        }
+
+        ~ObjectPool() {
+            for (size_t i = 0; i < constructed; i++) {
+                std::launder(reinterpret_cast<T *>(&slab[i]))->~T();
+            }
+        }
+
+        ObjectPool(const ObjectPool &) = delete;
+
+        ObjectPool &operator=(const ObjectPool &) = delete;
+
+        /**
+         * @brief 取出一个对象
+         * @param args 仅在槽位第一次使用、需要构造对象时使用的构造参数
+         * @return T* 池已满时返回 nullptr
+         */
+        template <typename... Args>
+        T *Acquire(Args &&...args) {
+            std::lock_guard lock(mutex);
+            T *object = nullptr;
+            if (!freeList.empty()) {
+                object = freeList.back();
+                freeList.pop_back();
+            } else if (constructed < capacity) {
+                object = new (&slab[constructed]) T(std::forward<Args>(args)...);
+                constructed++;
+            } else {
+                exhausted++;
+                return nullptr;
+            }
+            inUse++;
+            if (inUse > peak) {
+                peak = inUse;
+            }
+            return object;
+        }
+
+        /**
+         * @brief 归还一个对象，对象不会被析构
+         * @param object 由 Acquire 取出的对象
+         */
+        void Release(T *object) {
+            std::lock_guard lock(mutex);
+            freeList.push_back(object);
+            inUse--;
+        }
+
+        /**
+         * @brief 对每个已取出、尚未归还的对象调用回调，回调在池的锁内调用，不能再访问池
+         * @note 需要遍历空闲链表，只用于停止等低频的场合
+         */
+        template <typename Fn>
+        void ForEachInUse(Fn &&fn) {
+            std::lock_guard lock(mutex);
+            std::vector<bool> free(constructed);
+            for (T *object : freeList) {
+                free[reinterpret_cast<Slot *>(object) - slab.get()] = true;
+            }
+            for (size_t i = 0; i < constructed; i++) {
+                if (!free[i]) {
+                    fn(std::launder(reinterpret_cast<T *>(&slab[i])));
+                }
+            }
+        }
+
+        size_t Capacity() const { return capacity; }
+
+        size_t InUse() const {
+            std::lock_guard lock(mutex);
+            return inUse;
+        }
+
+        size_t Peak() const {
+            std::lock_guard lock(mutex);
+            return peak;
+        }
+
+        uint64_t Exhausted() const {
+            std::lock_guard lock(mutex);
+            return exhausted;
+        }
+
+    private:
+        struct Slot {
+            alignas(T) unsigned char storage[sizeof(T)];
+        };
+
+        std::unique_ptr<Slot[]> slab;
+        std::vector<T *> freeList;
+        size_t capacity;
+        size_t constructed = 0;
+        size_t inUse = 0;
+        size_t peak = 0;
+        uint64_t exhausted = 0;
+        mutable std::mutex mutex;
+    };
+}
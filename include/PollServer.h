@@ -0,0 +1,124 @@
+#pragma once
+#ifdef _WIN32
+#include <winsock2.h>
+#include <windows.h>
+#endif
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "HttpRequestParser.h"
+#include "HttpRouter.h"
+#include "HttpServerOptions.h"
+#include "ObjectPool.h"
+#include "TimerWheel.h"
+
+namespace v1_taskbar_manager {
+#ifdef _WIN32
+    using PollSocket = SOCKET;
+#else
+    using PollSocket = int;
+#endif
+
+    /**
+     * @brief 旧版服务器的就绪通知引擎：单线程，Windows 下基于 WSAPoll，Linux 下基于 epoll
+     * @note 每个客户端的状态集中在一个侵入式的 Client 中，就绪事件直接给出 Client，不需要按套接字查表；
+     * 没有连接、也没有定时器时无限期等待，Stop 通过唤醒描述符（Linux 下为 eventfd，Windows 下为回环 UDP 套接字）打断等待。
+     * 旧版服务器每个响应之后都关闭连接，只提供首页
+     */
+    class PollServer {
+    public:
+        explicit PollServer(const std::string &html, const v2_taskbar_manager::HttpServerOptions &options = {});
+
+        ~PollServer();
+
+        PollServer(const PollServer &) = delete;
+
+        PollServer &operator=(const PollServer &) = delete;
+
+        int Start(int port);
+
+        void Stop();
+
+    private:
+        struct Client {
+            PollSocket socket;
+            // 在 clients 中的位置，关闭时以末尾元素填补，移除是 O(1)；WSAPoll 的描述符数组与之对齐
+            size_t index = 0;
+            std::string recvBuffer;
+            v2_taskbar_manager::HttpRequestParser parser;
+            // 指向固定的响应报文，为空时还没有收到完整的请求
+            std::string_view response;
+            size_t sent = 0;
+            bool wantWrite = false;
+            // 连接后等待第一个字节、收到第一个字节后等待请求头完整的超时
+            v2_taskbar_manager::TimerNode timer;
+
+            explicit Client(size_t maxHeaderSize) : parser(maxHeaderSize) { timer.owner = this; }
+        };
+
+        struct ReadyEvent {
+            Client *client;
+            bool readable;
+            bool writable;
+            bool error;
+        };
+
+        v2_taskbar_manager::HttpServerOptions options;
+        std::string indexResponse;
+        std::string notFoundResponse;
+        std::string notImplementedResponse;
+        // 路由只登记了 GET，Allow 固定
+        std::string methodNotAllowedResponse;
+        std::string overloadedResponse;
+        v2_taskbar_manager::HttpRouter<std::string_view> router;
+
+        PollSocket listenSocket;
+        std::thread thread;
+        std::atomic<bool> stopRequested{false};
+        bool acceptPaused = false;
+        bool draining = false;
+        std::vector<Client *> clients;
+        std::vector<ReadyEvent> ready;
+        v2_taskbar_manager::ObjectPool<Client> pool;
+        v2_taskbar_manager::TimerWheel timers;
+#ifdef _WIN32
+        // 前两项为监听套接字与唤醒套接字，之后与 clients 一一对应
+        std::vector<WSAPOLLFD> pollFds;
+        SOCKET wakeSocket = INVALID_SOCKET;
+        int wakePort = 0;
+#else
+        int epollFd = -1;
+        int wakeFd = -1;
+#endif
+
+        bool OpenPoller();
+
+        void ClosePoller();
+
+        void Wake();
+
+        bool Wait(int timeout, bool &acceptReady);
+
+        void Run();
+
+        void AcceptClients();
+
+        void RejectClient(PollSocket socket) const;
+
+        void OnReadable(Client *client);
+
+        void OnWritable(Client *client);
+
+        void WatchClient(Client *client, bool write);
+
+        void SetAcceptPaused(bool paused);
+
+        void CloseClient(Client *client);
+
+        void BeginDrain();
+    };
+}
@@ -0,0 +1,81 @@
+#pragma once
+#include <cstdint>
+#include <list>
+#include <string>
+#include <unordered_map>
+
+namespace v1_taskbar_manager {
+    struct ProcessInfo {
+        std::uint32_t processId = 0;
+        // 进程的创建时间（Windows 下为 FILETIME），与 PID 一起标识一个进程，PID 被复用后不同
+        std::uint64_t creationTime = 0;
+        // 可执行文件名（UTF-8），例如 "msedge.exe"
+        std::string name;
+    };
+
+    /**
+     * @brief 打开进程并读取进程信息
+     * @note Open 返回的令牌在 Close 之前保持对进程的引用（Windows 下为进程句柄，持有期间 PID 不会被复用），
+     * HasExited 只检查令牌对应的进程是否已经退出，不重新打开进程
+     */
+    class ProcessInfoSource {
+    public:
+        virtual ~ProcessInfoSource() = default;
+
+        virtual bool Open(std::uint32_t processId, ProcessInfo &info, std::uintptr_t &token) = 0;
+
+        virtual bool HasExited(std::uintptr_t token) = 0;
+
+        virtual void Close(std::uintptr_t token) = 0;
+    };
+
+    struct ProcessInfoCacheStats {
+        std::uint64_t hits = 0;
+        std::uint64_t misses = 0;
+        // 超出容量被淘汰的条目数
+        std::uint64_t evictions = 0;
+        // 进程退出后移除的条目数
+        std::uint64_t exits = 0;
+        size_t size = 0;
+    };
+
+    /**
+     * @brief 以 (PID, 创建时间) 标识进程的进程信息缓存
+     * @note 条目持有进程的引用，期间 PID 不会指向别的进程，因此按 PID 查找，命中时只需确认进程没有退出；
+     * 进程退出后条目在查找或 Sweep 时移除，之后同一 PID 上的新进程以新的创建时间重新读取。
+     * 条目数不超过 capacity，超出时淘汰最久未使用的条目。只在一个线程上使用
+     */
+    class ProcessInfoCache {
+    public:
+        explicit ProcessInfoCache(ProcessInfoSource &source, size_t capacity = 256);
+
+        ~ProcessInfoCache();
+
+        ProcessInfoCache(const ProcessInfoCache &) = delete;
+
+        ProcessInfoCache &operator=(const ProcessInfoCache &) = delete;
+
+        const ProcessInfo *Lookup(std::uint32_t processId);
+
+        size_t Sweep();
+
+        void Clear();
+
+        ProcessInfoCacheStats Stats() const;
+
+    private:
+        struct Entry {
+            ProcessInfo info;
+            std::uintptr_t token = 0;
+        };
+
+        ProcessInfoSource &source;
+        size_t capacity;
+        // 最近使用的条目在前
+        std::list<Entry> entries;
+        std::unordered_map<std::uint32_t, std::list<Entry>::iterator> index;
+        ProcessInfoCacheStats stats;
+
+        void Erase(std::list<Entry>::iterator entry);
+    };
+}
@@ -0,0 +1,52 @@
+#pragma once
+#include <map>
+
+#include "WindowEventSource.h"
+
+namespace v1_taskbar_manager {
+    /**
+     * @brief 由调用方编排的窗口事件源，不依赖 Win32，用于在 Linux 上驱动与验证 WindowRegistry
+     * @note 每个修改窗口的方法默认同时投递对应的事件；notify 为 false 时只修改状态，模拟丢失的事件。
+     * Emit 投递任意事件，包括与状态不符的重复或过时事件
+     */
+    class ScriptedWindowEventSource : public WindowEventSource {
+    public:
+        WindowHandle Create(WindowRecord record, bool shown = true, bool notify = true);
+
+        void Destroy(WindowHandle handle, bool notify = true);
+
+        void Show(WindowHandle handle, bool notify = true);
+
+        void Hide(WindowHandle handle, bool notify = true);
+
+        void Rename(WindowHandle handle, std::string title, bool notify = true);
+
+        void SetMinimized(WindowHandle handle, bool minimized, bool notify = true);
+
+        void Emit(const WindowEvent &event) const;
+
+        size_t DescribeCalls() const { return describeCalls; }
+
+        std::vector<WindowRecord> Snapshot() override;
+
+        bool Describe(WindowHandle handle, WindowRecord &record) override;
+
+        bool Subscribe(Sink sink) override;
+
+        void Unsubscribe() override;
+
+    private:
+        struct Window {
+            WindowRecord record;
+            bool shown = false;
+        };
+
+        // 按句柄排列，句柄按创建顺序递增，与 EnumWindows 的顺序无关
+        std::map<WindowHandle, Window> windows;
+        WindowHandle nextHandle = 0x10000;
+        Sink sink;
+        size_t describeCalls = 0;
+
+        void Notify(WindowEventKind kind, WindowHandle handle, bool notify) const;
+    };
+}
@@ -0,0 +1,71 @@
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace v2_taskbar_manager {
+    /**
+     * @brief 资源目录中一个已打开的文件以及预先构建的响应头部
+     * @note 小文件映射到内存，正文直接指向映射视图；大文件只保留句柄，由后端以 TransmitFile/sendfile 零拷贝发送。
+     * 响应通过 shared_ptr 持有文件，缓存淘汰或文件更新时正在发送的连接不受影响
+     */
+    struct StaticFile {
+#ifdef _WIN32
+        void *handle = nullptr;
+        void *mapping = nullptr;
+#else
+        int fd = -1;
+#endif
+        const char *view = nullptr;
+        uint64_t size = 0;
+        std::filesystem::file_time_type lastWriteTime;
+        std::string etag;
+        std::string keepAliveHeader;
+        std::string closeHeader;
+        std::string notModifiedKeepAliveHeader;
+        std::string notModifiedCloseHeader;
+
+        StaticFile() = default;
+
+        ~StaticFile();
+
+        StaticFile(const StaticFile &) = delete;
+
+        StaticFile &operator=(const StaticFile &) = delete;
+
+        bool IsMapped() const { return view != nullptr; }
+
+        std::string_view Content() const { return IsMapped() ? std::string_view(view, size) : std::string_view(); }
+    };
+
+    /**
+     * @brief 资源目录的打开文件与内存映射缓存
+     * @note 同一文件只打开、映射一次，所有连接共享；超过检查间隔后才重新读取文件属性，文件变化时重新打开
+     */
+    class StaticFileCache {
+    public:
+        StaticFileCache(std::filesystem::path root, std::string cacheControl, size_t zeroCopyThreshold);
+
+        std::shared_ptr<const StaticFile> Lookup(std::string_view path);
+
+    private:
+        struct Entry {
+            std::shared_ptr<const StaticFile> file;
+            std::chrono::steady_clock::time_point checkedAt;
+        };
+
+        std::filesystem::path root;
+        std::string cacheControl;
+        size_t zeroCopyThreshold;
+        std::mutex mutex;
+        std::unordered_map<std::string, Entry> entries;
+
+        std::shared_ptr<const StaticFile> Open(const std::filesystem::path &fullPath, std::string_view path) const;
+    };
+}
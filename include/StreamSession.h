@@ -0,0 +1,61 @@
+#pragma once
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+namespace v2_taskbar_manager {
+    /**
+     * @brief 握手之后由服务端持续推送数据的连接（WebSocket、Server-Sent Events）的发送队列
+     * @note 发布线程排队数据、接收路径追加控制数据、后端发送数据三方可能位于不同线程，共享状态由 mutex 保护。
+     * 同一时间只有一个发送者：BeginWrite 返回 true 的一方独占 writing，直到 OnWritten 返回 false。
+     * 派生类决定排队数据的形式，并在 FillLocked 中把它编码到 writing
+     */
+    class StreamSession : public std::enable_shared_from_this<StreamSession> {
+    public:
+        using Notify = std::function<void(StreamSession &)>;
+
+        virtual ~StreamSession() = default;
+
+        virtual void Subscribe(void *owner, Notify notify) = 0;
+
+        bool BeginWrite();
+
+        std::string_view Unsent() const { return std::string_view(writing).substr(written); }
+
+        bool OnWritten(size_t bytes);
+
+        bool IsCloseSent() const { return closeSent; }
+
+        void *Owner() const;
+
+        void Detach();
+
+    protected:
+        mutable std::mutex mutex;
+        void *owner = nullptr;
+        Notify notify;
+        bool sending = false;
+        bool notified = false;
+        // 已排队最后的数据，发送完毕之后由后端关闭连接，不再接受新的数据
+        bool closing = false;
+
+        // 以下只由当前发送者访问
+        std::string writing;
+        size_t written = 0;
+        bool closeInWriting = false;
+        bool closeSent = false;
+
+        virtual void Unsubscribe() = 0;
+
+        virtual bool HasPendingLocked() const = 0;
+
+        virtual void FillLocked() = 0;
+
+        virtual void ClearLocked() = 0;
+
+        void NotifyLocked();
+    };
+}
@@ -0,0 +1,34 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace v1_taskbar_manager {
+    /**
+     * @brief 去重的 UTF-8 字符串池
+     * @note 字符串首尾相接存放在同一块内存中，以下标引用；查找表使用开放寻址，只保存下标。
+     * Clear 保留已有容量，每次刷新重建时不再分配内存
+     */
+    class StringPool {
+    public:
+        uint32_t Intern(std::string_view value);
+
+        std::string_view Get(uint32_t id) const {
+            return std::string_view(text).substr(offsets[id], offsets[id + 1] - offsets[id]);
+        }
+
+        size_t Size() const { return offsets.size() - 1; }
+
+        void Clear();
+
+    private:
+        std::string text;
+        // 第 i 个字符串位于 [offsets[i], offsets[i + 1])
+        std::vector<uint32_t> offsets{0};
+        // 查找表，保存下标加一，0 表示空槽位
+        std::vector<uint32_t> slots;
+
+        void Grow();
+    };
+}
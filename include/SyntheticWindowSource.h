@@ -0,0 +1,120 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "ProcessInfoCache.h"
+#include "WindowSource.h"
+
+namespace v1_taskbar_manager {
+    struct SyntheticWindowOptions {
+        // 相同的种子与参数生成相同的窗口集合与变化序列
+        std::uint64_t seed = 1;
+        size_t windowCount = 1000;
+        size_t processCount = 100;
+        // 以下比例按窗口独立抽样
+        double hiddenRatio = 0.3;
+        double toolWindowRatio = 0.1;
+        double appWindowRatio = 0.05;
+        double noActivateRatio = 0.05;
+        // 有拥有者窗口的比例，拥有者是先生成的某个窗口
+        double ownedRatio = 0.15;
+        double untitledRatio = 0.05;
+        // Windows.UI.Core.CoreWindow 与 ApplicationFrameWindow 的比例
+        double systemClassRatio = 0.03;
+        double minimizedRatio = 0.2;
+        double maximizedRatio = 0.2;
+        // 标题混合中日韩、西里尔、阿拉伯、希腊文字与表情符号，为 false 时只用 ASCII
+        bool mixedScripts = true;
+        // 每次 Churn 变化的窗口比例：一半替换为新窗口，其余一半改标题，一半切换最小化
+        double churnRate = 0.01;
+    };
+
+    /**
+     * @brief 在内存中生成的确定性窗口集合，不依赖 Win32
+     * @note 同时作为进程信息源，配合 ProcessInfoCache 压测元数据读取；Open 与 ProcessName 的调用次数
+     * 对应真实环境中打开进程的次数。只在一个线程上使用
+     */
+    class SyntheticWindowSource : public WindowSource, public ProcessInfoSource {
+    public:
+        explicit SyntheticWindowSource(const SyntheticWindowOptions &options = {});
+
+        size_t Churn();
+
+        size_t Size() const { return windows.size(); }
+
+        size_t ProcessOpens() const { return processOpens; }
+
+        bool EnumerateTopLevel(const Visitor &visitor) override;
+
+        bool IsWindow(WindowHandle handle) override;
+
+        bool IsVisible(WindowHandle handle) override;
+
+        bool Styles(WindowHandle handle, std::uint32_t &style, std::uint32_t &exStyle) override;
+
+        WindowHandle Parent(WindowHandle handle) override;
+
+        WindowHandle Owner(WindowHandle handle) override;
+
+        WindowHandle Desktop() override { return kDesktop; }
+
+        size_t TitleLength(WindowHandle handle) override;
+
+        std::string Title(WindowHandle handle) override;
+
+        std::string ClassName(WindowHandle handle) override;
+
+        bool IsMinimized(WindowHandle handle) override;
+
+        bool IsMaximized(WindowHandle handle) override;
+
+        std::uint32_t ProcessId(WindowHandle handle) override;
+
+        std::string ProcessName(std::uint32_t processId) override;
+
+        bool Open(std::uint32_t processId, ProcessInfo &info, std::uintptr_t &token) override;
+
+        bool HasExited(std::uintptr_t token) override;
+
+        void Close(std::uintptr_t token) override;
+
+    private:
+        static constexpr WindowHandle kDesktop = 0x10010;
+
+        struct Window {
+            WindowHandle handle = 0;
+            WindowHandle owner = 0;
+            std::uint32_t style = 0;
+            std::uint32_t exStyle = 0;
+            std::uint32_t processId = 0;
+            // 下标指向 classNames
+            std::uint32_t className = 0;
+            bool visible = true;
+            bool minimized = false;
+            bool maximized = false;
+            std::string title;
+        };
+
+        SyntheticWindowOptions options;
+        std::uint64_t state;
+        // 按 Z 序排列
+        std::vector<Window> windows;
+        // 句柄到 windows 中位置的索引
+        std::unordered_map<WindowHandle, size_t> index;
+        WindowHandle nextHandle = 0x20000;
+        size_t titleSerial = 0;
+        size_t processOpens = 0;
+
+        std::uint64_t Next();
+
+        bool Chance(double ratio);
+
+        const Window *Find(WindowHandle handle) const;
+
+        Window MakeWindow(size_t position);
+
+        std::string MakeTitle();
+    };
+}
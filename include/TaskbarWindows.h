@@ -0,0 +1,22 @@
+#pragma once
+#include <vector>
+
+#include "ProcessInfoCache.h"
+#include "WindowEventSource.h"
+#include "WindowSource.h"
+
+namespace v1_taskbar_manager {
+    /**
+     * @brief 任务栏窗口的枚举与过滤，只依赖 WindowSource，与平台无关
+     */
+    class TaskbarWindows {
+    public:
+        static std::vector<WindowRecord> GetTaskbarWindows(WindowSource &source,
+                                                           ProcessInfoCache *processes = nullptr);
+
+        static bool QueryWindow(WindowSource &source, WindowHandle handle, WindowRecord &record,
+                                ProcessInfoCache *processes = nullptr);
+
+        static bool ShouldShowInTaskbar(WindowSource &source, WindowHandle handle);
+    };
+}
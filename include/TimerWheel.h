@@ -0,0 +1,184 @@
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace v2_taskbar_manager {
+    /**
+     * @brief 嵌入在连接上下文中的定时器节点
+     */
+    struct TimerNode {
+        TimerNode *prev = nullptr;
+        TimerNode *next = nullptr;
+        uint64_t expiry = 0;
+        // 定时器所属的对象，到期回调中据此找回连接上下文
+        void *owner = nullptr;
+
+        bool IsScheduled() const { return prev != nullptr; }
+    };
+
+    /**
+     * @brief 分层时间轮
+     * @note 4 层、每层 64 个槽位，第 0 层每个槽位对应一个 tick，上层每个槽位覆盖下层一整圈。
+     * 定时器以侵入式双向链表挂在槽位上，设置、取消都是 O(1)；上层槽位到期时才把其中的定时器逐个下放（cascade）。
+     * 不是线程安全的，由调用方保证同一时间只有一个线程访问
+     */
+    class TimerWheel {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        explicit TimerWheel(const Clock::duration tick, const Clock::time_point now = Clock::now())
+            : tick(tick), origin(now) {
+            for (auto &level : slots) {
+                for (TimerNode &slot : level) {
+                    slot.prev = &slot;
+                    slot.next = &slot;
+                }
+            }
+        }
+
+        TimerWheel(const TimerWheel &) = delete;
+
+        TimerWheel &operator=(const TimerWheel &) = delete;
+
+        /**
+         * @brief 设置（或重新设置）定时器
+         * @param node 定时器节点，已设置时先取消
+         * @param deadline 截止时间，向上取整到 tick，因此不会提前到期；超出时间轮范围（64^4 个 tick）的按范围上限到期
+         */
+        void Schedule(TimerNode *node, const Clock::time_point deadline) {
+            Cancel(node);
+            const auto elapsed = deadline - origin;
+            uint64_t expiry = elapsed.count() <= 0 ? 0 : static_cast<uint64_t>((elapsed + tick - Clock::duration(1)) / tick);
+            if (expiry <= current) {
+                expiry = current + 1;
+            }
+            node->expiry = expiry;
+            Link(node);
+            count++;
+        }
+
+        /**
+         * @brief 取消定时器，未设置时什么也不做
+         */
+        void Cancel(TimerNode *node) {
+            if (!node->IsScheduled()) {
+                return;
+            }
+            node->prev->next = node->next;
+            node->next->prev = node->prev;
+            node->prev = nullptr;
+            node->next = nullptr;
+            count--;
+        }
+
+        /**
+         * @brief 推进时间轮，对每个到期的定时器调用回调
+         * @param now 当前时间
+         * @param onExpired 回调，参数为已经从时间轮中摘下的节点，回调中可以重新设置或取消任意定时器
+         * @return size_t 到期的定时器数
+         */
+        template <typename Fn>
+        size_t Advance(const Clock::time_point now, Fn &&onExpired) {
+            const auto elapsed = now - origin;
+            const uint64_t target = elapsed.count() <= 0 ? 0 : static_cast<uint64_t>(elapsed / tick);
+            // 没有定时器时直接跳到目标位置，长时间空闲之后不需要逐个 tick 追赶
+            if (count == 0) {
+                current = target > current ? target : current;
+                return 0;
+            }
+
+            size_t expired = 0;
+            while (current < target) {
+                current++;
+                // 第 0 层转完一圈时，依次把上层当前槽位中的定时器下放
+                for (size_t level = 1; level < kLevels && (current & LevelMask(level - 1)) == 0; level++) {
+                    Cascade(level, SlotIndex(current, level));
+                }
+
+                TimerNode &slot = slots[0][SlotIndex(current, 0)];
+                while (slot.next != &slot) {
+                    TimerNode *node = slot.next;
+                    Cancel(node);
+                    expired++;
+                    onExpired(node);
+                }
+            }
+            return expired;
+        }
+
+        /**
+         * @brief 摘下所有定时器，对每个定时器调用回调，用于停止时结束所有等待中的连接
+         * @param onCancelled 回调，参数为已经从时间轮中摘下的节点，回调中不能重新设置定时器
+         * @return size_t 摘下的定时器数
+         */
+        template <typename Fn>
+        size_t CancelAll(Fn &&onCancelled) {
+            size_t cancelled = 0;
+            for (auto &level : slots) {
+                for (TimerNode &slot : level) {
+                    while (slot.next != &slot) {
+                        TimerNode *node = slot.next;
+                        Cancel(node);
+                        cancelled++;
+                        onCancelled(node);
+                    }
+                }
+            }
+            return cancelled;
+        }
+
+        size_t Size() const { return count; }
+
+        Clock::duration Tick() const { return tick; }
+
+    private:
+        static constexpr size_t kLevelBits = 6;
+        static constexpr size_t kSlots = size_t{1} << kLevelBits;
+        static constexpr size_t kLevels = 4;
+
+        Clock::duration tick;
+        Clock::time_point origin;
+        uint64_t current = 0;
+        size_t count = 0;
+        // 每个槽位的哨兵节点
+        TimerNode slots[kLevels][kSlots];
+
+        static uint64_t LevelMask(const size_t level) {
+            return (uint64_t{1} << (kLevelBits * (level + 1))) - 1;
+        }
+
+        static size_t SlotIndex(const uint64_t expiry, const size_t level) {
+            return static_cast<size_t>((expiry >> (kLevelBits * level)) & (kSlots - 1));
+        }
+
+        /**
+         * @brief 按到期时间与当前时间的距离选择层级与槽位，超出最高层范围的截断到最高层
+         */
+        void Link(TimerNode *node) {
+            uint64_t delta = node->expiry - current;
+            size_t level = 0;
+            while (level + 1 < kLevels && delta > LevelMask(level)) {
+                level++;
+            }
+            if (delta > LevelMask(kLevels - 1)) {
+                node->expiry = current + LevelMask(kLevels - 1);
+            }
+            TimerNode &slot = slots[level][SlotIndex(node->expiry, level)];
+            node->prev = slot.prev;
+            node->next = &slot;
+            slot.prev->next = node;
+            slot.prev = node;
+        }
+
+        void Cascade(const size_t level, const size_t index) {
+            TimerNode &slot = slots[level][index];
+            while (slot.next != &slot) {
+                TimerNode *node = slot.next;
+                node->prev->next = node->next;
+                node->next->prev = node->prev;
+                Link(node);
+            }
+        }
+    };
+}
@@ -0,0 +1,214 @@
+#pragma once
+#include <atomic>
+#include <linux/io_uring.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/uio.h>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#include "HttpBackend.h"
+#include "HttpConnection.h"
+#include "ObjectPool.h"
+#include "TimerWheel.h"
+
+namespace v2_taskbar_manager {
+    /**
+     * @brief 基于 io_uring 的 Linux 完成模型后端
+     * @note 与 IocpBackend 相同的完成模型：每个 I/O 以 UringOperation 提交，完成时通过 user_data 找回连接上下文，
+     * 同一连接同一时刻只挂起一个请求方向的操作；与 EpollBackend 相同的线程模型：每个工作线程拥有独立的
+     * 监听套接字（SO_REUSEPORT）与 io_uring 实例，连接只在一个线程内处理，无需加锁。
+     * 直接使用 io_uring_setup/io_uring_enter/io_uring_register 系统调用，不依赖 liburing
+     */
+    class UringBackend final : public HttpBackend {
+        struct UringContext;
+
+        // 一个已提交的操作，地址作为 user_data，完成时找回所属的上下文
+        struct UringOperation {
+            UringContext *context = nullptr;
+            enum { OP_ACCEPT, OP_WAKEUP, OP_TIMEOUT, OP_RECV, OP_SEND, OP_SPLICE, OP_PUSH, OP_CLOSE } op = OP_RECV;
+        };
+
+        struct UringContext {
+            int socket = -1;
+            // 接收与 HTTP 响应的发送
+            UringOperation io;
+            // 大文件以 splice 从文件送入管道，再由 io 从管道送入套接字
+            UringOperation splice;
+            // 推送连接（WebSocket、事件流）上与接收同时挂起的推送
+            UringOperation push;
+            UringOperation close;
+            iovec sendVectors[2]{};
+            msghdr message{};
+            // splice 使用的管道，第一次发送大文件时创建，随上下文复用
+            int pipe[2] = {-1, -1};
+            // 尚未完成的操作数，关闭时等待归零再提交关闭
+            int pending = 0;
+            // splice 发送的字节数，从管道送入套接字不足这个长度时管道中会残留数据，只能关闭连接
+            size_t spliceLength = 0;
+            bool ioPending = false;
+            bool pushPending = false;
+            bool closing = false;
+            bool closeSubmitted = false;
+            // 等待请求数据（或等待 API 结果）时的超时定时器，发送响应期间不计时
+            TimerNode timer;
+
+            HttpConnection connection;
+
+            explicit UringContext(const HttpServerOptions &options) : connection(options) {
+                io.context = this;
+                splice.context = this;
+                push.context = this;
+                close.context = this;
+                timer.owner = this;
+            }
+
+            ~UringContext();
+
+            void Reset(int acceptSocket);
+        };
+
+        // 映射到用户态的提交队列与完成队列
+        struct Ring {
+            int fd = -1;
+            void *sqRing = nullptr;
+            size_t sqRingSize = 0;
+            void *cqRing = nullptr;
+            size_t cqRingSize = 0;
+            io_uring_sqe *sqes = nullptr;
+            size_t sqesSize = 0;
+            unsigned *sqHead = nullptr;
+            unsigned *sqTail = nullptr;
+            unsigned *sqArray = nullptr;
+            unsigned sqMask = 0;
+            unsigned sqEntries = 0;
+            unsigned *cqHead = nullptr;
+            unsigned *cqTail = nullptr;
+            unsigned cqMask = 0;
+            io_uring_cqe *cqes = nullptr;
+            // 已写入提交队列、尚未通过 io_uring_enter 提交的数量
+            unsigned unsubmitted = 0;
+        };
+
+        struct EventLoop {
+            int listenSocket = -1;
+            int wakeupFd = -1;
+            Ring ring;
+            // 注册到内核的接收缓冲区环，接收完成时由内核从中选取缓冲区，连接不需要各自持有接收缓冲区
+            io_uring_buf_ring *bufferRing = nullptr;
+            size_t bufferRingSize = 0;
+            char *buffers = nullptr;
+            uint16_t bufferTail = 0;
+            UringOperation acceptOperation;
+            UringOperation wakeupOperation;
+            UringOperation timeoutOperation;
+            uint64_t wakeupValue = 0;
+            __kernel_timespec timeout{};
+            bool acceptArmed = false;
+            // 池耗尽时取消多次接受，新连接留在内核的监听队列中；取消生效前已接受的一个连接暂存在这里
+            bool acceptPaused = false;
+            int parkedSocket = -1;
+            // 因文件描述符耗尽而暂停时恢复接受的时刻，未设置时为默认值
+            std::chrono::steady_clock::time_point acceptRetryAt{};
+            // 已开始停止：多次接受已取消、监听套接字已关闭，响应发送完毕的连接不再等待下一个请求
+            bool draining = false;
+            size_t drainConnections = 0;
+            bool timeoutArmed = false;
+            // 其他线程发布的数据使这些推送会话有数据待发送、其他线程完成了这些 API 响应，通过 wakeupFd 唤醒事件循环处理
+            std::mutex readyMutex;
+            std::vector<std::shared_ptr<StreamSession>> readySessions;
+            std::vector<std::shared_ptr<HttpApiReply>> readyReplies;
+            std::thread thread;
+            std::unordered_set<UringContext *> contexts;
+            ObjectPool<UringContext> pool;
+            TimerWheel timers;
+            // 按 HttpWaitPhase 分类的超时关闭次数，由 GetStats 在其他线程读取
+            std::atomic<uint64_t> timeouts[3]{};
+            std::atomic<uint64_t> connectionsRejected{0};
+            std::atomic<uint64_t> connectionsDeferred{0};
+
+            EventLoop(size_t poolCapacity, std::chrono::steady_clock::duration tick)
+                : pool(poolCapacity), timers(tick) {}
+        };
+
+        const HttpRequestHandler &handler;
+        const HttpServerOptions &options;
+        std::atomic<bool> isRunning{false};
+        // 由 Stop 设置，事件循环看到之后开始停止，直到连接全部关闭或到达期限
+        std::atomic<bool> draining{false};
+        std::chrono::steady_clock::time_point drainDeadline;
+        std::vector<std::unique_ptr<EventLoop>> loops;
+
+        int OpenLoop(EventLoop &loop, int port) const;
+
+        static bool SetupRing(Ring &ring, unsigned entries, unsigned completionEntries);
+
+        static bool SetupBuffers(EventLoop &loop);
+
+        static io_uring_sqe *NextSqe(Ring &ring);
+
+        static int Enter(Ring &ring, unsigned waitCount);
+
+        static void RecycleBuffer(EventLoop &loop, uint16_t bufferId);
+
+        static void ArmAccept(EventLoop &loop);
+
+        static void ArmWakeup(EventLoop &loop);
+
+        static void ArmTimeout(EventLoop &loop);
+
+        static void SubmitCancel(EventLoop &loop, const UringOperation &operation);
+
+        void HandleCompletion(EventLoop &loop, const io_uring_cqe &cqe);
+
+        void HandleAccept(EventLoop &loop, const io_uring_cqe &cqe);
+
+        static void OpenContext(EventLoop &loop, UringContext *context, int socket);
+
+        void HandleContextCompletion(EventLoop &loop, UringContext *context, int op, const io_uring_cqe &cqe);
+
+        static void SubmitRecv(EventLoop &loop, UringContext *context);
+
+        static void SubmitSend(EventLoop &loop, UringContext *context);
+
+        static void SubmitPush(EventLoop &loop, UringContext *context);
+
+        void Dispatch(EventLoop &loop, UringContext *context, HttpAction action);
+
+        static void UpgradeContext(EventLoop &loop, UringContext *context);
+
+        void WaitReply(EventLoop &loop, UringContext *context);
+
+        void FinishReply(EventLoop &loop, UringContext *context);
+
+        void FlushReadySessions(EventLoop &loop);
+
+        static void CloseContext(EventLoop &loop, UringContext *context);
+
+        static void SubmitClose(EventLoop &loop, UringContext *context);
+
+        static void ReleaseContext(EventLoop &loop, UringContext *context);
+
+        void BeginDrain(EventLoop &loop);
+
+        static void CloseLoop(EventLoop &loop);
+
+        void CloseExpiredConnections(EventLoop &loop);
+
+        static void ResumeAccept(EventLoop &loop);
+
+        void WorkerThread(EventLoop &loop);
+
+    public:
+        UringBackend(const HttpRequestHandler &handler, const HttpServerOptions &options);
+
+        int Start(int port) override;
+
+        HttpShutdownReport Stop() override;
+
+        HttpServerStats GetStats() const override;
+    };
+}
@@ -27,6 +27,8 @@ namespace v1_taskbar_manager {
 
         static std::wstring LoadWStringFromResource(int id, int type);
 
+        static std::string LoadBytesFromResource(int id, int type);
+
         static void SavePortToWindowsRegistry(int port);
 
         static int ReadPortFromWindowsRegistry();
@@ -0,0 +1,43 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace v2_taskbar_manager {
+    enum class WebSocketOpcode : uint8_t {
+        Continuation = 0x0,
+        Text = 0x1,
+        Binary = 0x2,
+        Close = 0x8,
+        Ping = 0x9,
+        Pong = 0xA
+    };
+
+    /**
+     * @brief 一个已解析的客户端帧，payload 指向已去除掩码的接收缓冲区
+     */
+    struct WebSocketFrame {
+        WebSocketOpcode opcode = WebSocketOpcode::Continuation;
+        bool fin = false;
+        std::string_view payload;
+    };
+
+    enum class WebSocketParseResult {
+        // 帧尚未完整，需要继续接收数据
+        Incomplete,
+        // 帧已完整
+        Complete,
+        // 违反 RFC 6455（未加掩码、保留位非 0、控制帧过长或分片等）
+        ProtocolError,
+        // 负载超过允许的大小
+        TooLarge
+    };
+
+    std::string WebSocketAcceptKey(std::string_view clientKey);
+
+    WebSocketParseResult ParseWebSocketFrame(char *data, size_t length, size_t maxPayload, WebSocketFrame &frame,
+                                             size_t &consumed);
+
+    void AppendWebSocketFrame(std::string &out, WebSocketOpcode opcode, std::string_view payload);
+}
@@ -0,0 +1,98 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "StreamSession.h"
+#include "WebSocket.h"
+
+namespace v2_taskbar_manager {
+    class WebSocketHub;
+
+    /**
+     * @brief 一个 WebSocket 客户端的发送队列
+     * @note 尚未发送的变化按键合并：同一窗口在一次发送期间的多次变化只保留最终结果，
+     * 因此慢速客户端的队列长度不超过窗口数，不会随变化次数增长
+     */
+    class WebSocketSession final : public StreamSession {
+    public:
+        explicit WebSocketSession(WebSocketHub &hub);
+
+        void Subscribe(void *owner, Notify notify) override;
+
+        bool SendControl(WebSocketOpcode opcode, std::string_view payload);
+
+    private:
+        friend class WebSocketHub;
+
+        enum class ChangeType { Add, Update, Remove };
+
+        struct Change {
+            ChangeType type = ChangeType::Add;
+            std::string value;
+        };
+
+        WebSocketHub *hub;
+        // 下一条消息携带完整列表，客户端据此清空本地状态
+        bool reset = true;
+        std::string control;
+        std::unordered_map<std::string, Change> pending;
+
+        void Merge(std::string_view key, ChangeType type, std::string_view value);
+
+        void Unsubscribe() override;
+
+        bool HasPendingLocked() const override;
+
+        void FillLocked() override;
+
+        void ClearLocked() override;
+    };
+
+    /**
+     * @brief 以键值集合为状态的 WebSocket 广播中心
+     * @note 发布者每次提交完整的集合，由中心与上一次的集合比较，只把增加、更新、删除的条目推送给客户端；
+     * 新订阅的客户端先收到一条携带 "reset" 的完整列表
+     */
+    class WebSocketHub {
+    public:
+        explicit WebSocketHub(size_t maxPendingBytes = SIZE_MAX);
+
+        WebSocketHub(const WebSocketHub &) = delete;
+
+        WebSocketHub &operator=(const WebSocketHub &) = delete;
+
+        size_t Publish(std::vector<std::pair<std::string, std::string>> items);
+
+        void Subscribe(WebSocketSession &session, void *owner, StreamSession::Notify notify);
+
+        void CloseAll();
+
+        size_t SessionCount() const;
+
+        uint64_t Messages() const { return messages.load(std::memory_order_relaxed); }
+
+        uint64_t Coalesced() const { return coalesced.load(std::memory_order_relaxed); }
+
+    private:
+        friend class WebSocketSession;
+
+        mutable std::mutex mutex;
+        // 单个客户端允许积压的控制帧字节数，客户端不读取却持续发送 Ping 时队列不会无限增长
+        size_t maxPendingBytes;
+        std::unordered_map<std::string, std::string> state;
+        std::vector<std::shared_ptr<WebSocketSession>> sessions;
+        std::atomic<uint64_t> messages{0};
+        std::atomic<uint64_t> coalesced{0};
+
+        void Remove(const WebSocketSession *session);
+    };
+}
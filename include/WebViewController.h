@@ -3,7 +3,7 @@
 #include <string>
 #include <wil/com.h>
 
-#include "GlobalHotKeyManager.h"
+#include "CommandDispatcher.h"
 #include <nlohmann/json.hpp>
 #include "WebView2.h"
 
@@ -12,7 +12,7 @@ using namespace Microsoft::WRL;
 namespace v1_taskbar_manager {
     class WebViewController {
     public:
-        explicit WebViewController(HWND hWnd, const std::weak_ptr<GlobalHotKeyManager> &globalHotKeyManager, int port);
+        explicit WebViewController(HWND hWnd, const CommandDispatcher &commandDispatcher, int port);
 
         ~WebViewController();
 
@@ -24,7 +24,7 @@ namespace v1_taskbar_manager {
         HWND hWnd;
         wil::com_ptr<ICoreWebView2Controller> webviewController;
         wil::com_ptr<ICoreWebView2> webview;
-        std::weak_ptr<GlobalHotKeyManager> globalHotKeyManager;
+        const CommandDispatcher &commandDispatcher;
         int port;
 
         void SetupWebViewSettings() const;
@@ -0,0 +1,20 @@
+#pragma once
+#include <windows.h>
+
+#include "ProcessInfoCache.h"
+
+namespace v1_taskbar_manager {
+    /**
+     * @brief 基于进程句柄的进程信息源
+     * @note 以 PROCESS_QUERY_LIMITED_INFORMATION | SYNCHRONIZE 打开进程，提升权限运行的进程也可以读取映像名；
+     * 句柄由缓存持有，HasExited 以零超时等待句柄判断进程是否退出
+     */
+    class Win32ProcessInfoSource : public ProcessInfoSource {
+    public:
+        bool Open(std::uint32_t processId, ProcessInfo &info, std::uintptr_t &token) override;
+
+        bool HasExited(std::uintptr_t token) override;
+
+        void Close(std::uintptr_t token) override;
+    };
+}
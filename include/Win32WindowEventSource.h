@@ -0,0 +1,50 @@
+#pragma once
+#include <windows.h>
+#include <vector>
+
+#include "ProcessInfoCache.h"
+#include "Win32ProcessInfoSource.h"
+#include "Win32WindowSource.h"
+#include "WindowEventSource.h"
+
+namespace v1_taskbar_manager {
+    /**
+     * @brief 基于 SetWinEventHook 的窗口事件源
+     * @note 以 WINEVENT_OUTOFCONTEXT 安装钩子，事件通过消息循环投递到安装钩子的线程，必须在 UI 线程上订阅；
+     * 只关注顶层窗口的创建、销毁、显示、隐藏、标题变化与最小化，不订阅高频的位置变化
+     */
+    class Win32WindowEventSource : public WindowEventSource {
+    public:
+        Win32WindowEventSource() = default;
+
+        ~Win32WindowEventSource() override;
+
+        Win32WindowEventSource(const Win32WindowEventSource &) = delete;
+
+        Win32WindowEventSource &operator=(const Win32WindowEventSource &) = delete;
+
+        std::vector<WindowRecord> Snapshot() override;
+
+        bool Describe(WindowHandle handle, WindowRecord &record) override;
+
+        bool Subscribe(Sink sink) override;
+
+        void Unsubscribe() override;
+
+        // 窗口所属进程的信息缓存，同一进程的窗口只打开一次进程
+        ProcessInfoCache &Processes() { return processes; }
+
+    private:
+        // WINEVENTPROC 不携带用户数据，同一时间只允许一个实例订阅
+        static Win32WindowEventSource *subscriber;
+
+        Sink sink;
+        std::vector<HWINEVENTHOOK> hooks;
+        Win32WindowSource windows;
+        Win32ProcessInfoSource processSource;
+        ProcessInfoCache processes{processSource};
+
+        static void CALLBACK WinEventProc(HWINEVENTHOOK hook, DWORD event, HWND hWnd, LONG idObject, LONG idChild,
+                                          DWORD eventThread, DWORD eventTime);
+    };
+}
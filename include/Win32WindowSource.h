@@ -0,0 +1,43 @@
+#pragma once
+#include <windows.h>
+
+#include "WindowSource.h"
+
+namespace v1_taskbar_manager {
+    /**
+     * @brief 基于 Win32 API 的窗口源，每个方法对应一次系统调用
+     */
+    class Win32WindowSource : public WindowSource {
+    public:
+        bool EnumerateTopLevel(const Visitor &visitor) override;
+
+        bool IsWindow(WindowHandle handle) override;
+
+        bool IsVisible(WindowHandle handle) override;
+
+        bool Styles(WindowHandle handle, std::uint32_t &style, std::uint32_t &exStyle) override;
+
+        WindowHandle Parent(WindowHandle handle) override;
+
+        WindowHandle Owner(WindowHandle handle) override;
+
+        WindowHandle Desktop() override;
+
+        size_t TitleLength(WindowHandle handle) override;
+
+        std::string Title(WindowHandle handle) override;
+
+        std::string ClassName(WindowHandle handle) override;
+
+        bool IsMinimized(WindowHandle handle) override;
+
+        bool IsMaximized(WindowHandle handle) override;
+
+        std::uint32_t ProcessId(WindowHandle handle) override;
+
+        std::string ProcessName(std::uint32_t processId) override;
+
+    private:
+        static BOOL CALLBACK EnumWindowsProc(HWND hWnd, LPARAM lParam);
+    };
+}
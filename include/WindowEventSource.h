@@ -0,0 +1,70 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace v1_taskbar_manager {
+    // 窗口句柄的整数值；Windows 下即 HWND，脚本化的事件源使用任意编号
+    using WindowHandle = std::uintptr_t;
+
+    /**
+     * @brief 窗口注册表中的一个任务栏窗口，字符串均为 UTF-8
+     */
+    struct WindowRecord {
+        WindowHandle handle = 0;
+        // 页面与 API 使用的句柄文本，例如 "0x1A2B"
+        std::string handleText;
+        std::string title;
+        std::string className;
+        std::uint32_t processId = 0;
+        std::string processName;
+        bool isMinimized = false;
+        bool isMaximized = false;
+
+        bool operator==(const WindowRecord &other) const {
+            return handle == other.handle && title == other.title && className == other.className &&
+                   processId == other.processId && processName == other.processName &&
+                   isMinimized == other.isMinimized && isMaximized == other.isMaximized;
+        }
+
+        bool operator!=(const WindowRecord &other) const { return !(*this == other); }
+    };
+
+    enum class WindowEventKind {
+        Created,
+        Destroyed,
+        Shown,
+        Hidden,
+        NameChanged,
+        // 最小化、还原等状态变化
+        StateChanged,
+    };
+
+    struct WindowEvent {
+        WindowEventKind kind = WindowEventKind::Created;
+        WindowHandle handle = 0;
+    };
+
+    /**
+     * @brief 窗口生命周期事件的来源
+     * @note 事件只携带句柄，注册表收到事件后通过 Describe 读取窗口当前的信息；
+     * 事件在订阅者的线程上投递（Windows 下为安装钩子的 UI 线程），不需要加锁
+     */
+    class WindowEventSource {
+    public:
+        using Sink = std::function<void(const WindowEvent &event)>;
+
+        virtual ~WindowEventSource() = default;
+
+        // 枚举当前所有应在任务栏显示的窗口，用于建立与重建模型
+        virtual std::vector<WindowRecord> Snapshot() = 0;
+
+        // 读取一个窗口当前的信息，窗口不存在或不应在任务栏显示时返回 false
+        virtual bool Describe(WindowHandle handle, WindowRecord &record) = 0;
+
+        virtual bool Subscribe(Sink sink) = 0;
+
+        virtual void Unsubscribe() = 0;
+    };
+}
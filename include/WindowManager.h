@@ -1,29 +1,15 @@
 #pragma once
 #include <windows.h>
 #include <string>
-#include <vector>
+#include <nlohmann/json.hpp>
 
-namespace v1_taskbar_manager {
-    struct WindowInfo {
-        HWND hWnd;
-        std::wstring title;
-        std::wstring className;
-        bool isVisible;
-        bool isMinimized;
-        bool isMaximized;
-        DWORD processId;
-        std::wstring processName;
-    };
+#include "WindowEventSource.h"
 
+namespace v1_taskbar_manager {
     class WindowManager {
     public:
-        static std::vector<WindowInfo> GetTaskbarWindows();
-
         static void ActivateWindow(const std::string &handle);
 
-    private:
-        static bool ShouldShowInTaskbar(HWND hWnd);
-
-        static BOOL CALLBACK EnumWindowsProc(HWND hWnd, LPARAM lParam);
+        static nlohmann::json WindowToJson(const WindowRecord &record);
     };
 }
\ No newline at end of file
@@ -0,0 +1,59 @@
+#pragma once
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "WindowEventSource.h"
+#include "WindowTable.h"
+
+namespace v1_taskbar_manager {
+    /**
+     * @brief 由窗口生命周期事件维护的任务栏窗口模型
+     * @note 启动时枚举一次，之后只在事件涉及的窗口上调用 Describe，查询直接读取内存中的列表；
+     * 列表按窗口加入模型的先后排列，每次实际变化使版本号加一。只在事件源投递事件的线程上使用
+     */
+    class WindowRegistry {
+    public:
+        explicit WindowRegistry(WindowEventSource &source);
+
+        ~WindowRegistry();
+
+        WindowRegistry(const WindowRegistry &) = delete;
+
+        WindowRegistry &operator=(const WindowRegistry &) = delete;
+
+        bool Start();
+
+        void Stop();
+
+        void Resync();
+
+        void OnEvent(const WindowEvent &event);
+
+        const std::vector<WindowRecord> &Windows() const { return windows; }
+
+        const WindowRecord *Find(WindowHandle handle) const;
+
+        const WindowTable &Table() const;
+
+        uint64_t Version() const { return version; }
+
+        uint64_t Events() const { return events; }
+
+    private:
+        WindowEventSource &source;
+        std::vector<WindowRecord> windows;
+        // 句柄到 windows 中位置的索引
+        std::unordered_map<WindowHandle, size_t> index;
+        uint64_t version = 0;
+        uint64_t events = 0;
+        bool subscribed = false;
+        // 按列存放的当前列表，只作为发布窗口列表时的缓存，与 windows 并存，版本变化后第一次读取时重建
+        mutable WindowTable table;
+        mutable uint64_t tableVersion = UINT64_MAX;
+
+        void Refresh(WindowHandle handle);
+
+        void Remove(WindowHandle handle);
+    };
+}
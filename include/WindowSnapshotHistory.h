@@ -0,0 +1,58 @@
+#pragma once
+#include <cstdint>
+#include <deque>
+#include <string_view>
+#include <vector>
+
+#include "WindowEventSource.h"
+
+namespace v1_taskbar_manager {
+    // 窗口发生变化的字段，可以组合
+    enum WindowField : std::uint32_t {
+        WindowFieldTitle = 1u << 0,
+        WindowFieldClassName = 1u << 1,
+        WindowFieldProcess = 1u << 2,
+        WindowFieldState = 1u << 3,
+    };
+
+    struct WindowChange {
+        const WindowRecord *record;
+        std::uint32_t fields;
+    };
+
+    /**
+     * @brief 两个版本之间的变化，指针指向当前列表，字符串指向历史快照
+     * @note added 与 changed 按当前列表的顺序排列，removed 按旧快照的顺序排列
+     */
+    struct WindowDelta {
+        std::vector<const WindowRecord *> added;
+        std::vector<WindowChange> changed;
+        std::vector<std::string_view> removed;
+    };
+
+    /**
+     * @brief 最近返回给客户端的窗口列表快照
+     * @note 客户端带着上次看到的版本号查询时，与该版本的快照比较，只返回增加、删除与字段变化的窗口；
+     * 同一版本的客户端共用一份快照，只保存最近 capacity 个版本，更早的版本需要返回完整列表
+     */
+    class WindowSnapshotHistory {
+    public:
+        explicit WindowSnapshotHistory(size_t capacity = 8);
+
+        void Remember(std::uint64_t version, const std::vector<WindowRecord> &windows);
+
+        bool Diff(std::uint64_t since, const std::vector<WindowRecord> &current, WindowDelta &delta) const;
+
+        static std::uint32_t ChangedFields(const WindowRecord &previous, const WindowRecord &current);
+
+    private:
+        struct Snapshot {
+            std::uint64_t version;
+            std::vector<WindowRecord> windows;
+        };
+
+        size_t capacity;
+        // 最新的快照在末尾
+        std::deque<Snapshot> snapshots;
+    };
+}
@@ -0,0 +1,56 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <string>
+
+#include "WindowEventSource.h"
+
+namespace v1_taskbar_manager {
+    // 任务栏过滤用到的扩展样式，取值与 WS_EX_* 相同
+    constexpr std::uint32_t WindowExStyleToolWindow = 0x00000080;
+    constexpr std::uint32_t WindowExStyleAppWindow = 0x00040000;
+    constexpr std::uint32_t WindowExStyleNoActivate = 0x08000000;
+
+    /**
+     * @brief 顶层窗口及其属性的读取接口，对应任务栏过滤与元数据读取用到的 Win32 调用
+     * @note Windows 下由 Win32WindowSource 转发到 EnumWindows、GetWindowLong 等；
+     * SyntheticWindowSource 在内存中生成窗口，用于在 Linux 上压测枚举路径。字符串均为 UTF-8
+     */
+    class WindowSource {
+    public:
+        using Visitor = std::function<bool(WindowHandle handle)>;
+
+        virtual ~WindowSource() = default;
+
+        // 按 Z 序枚举顶层窗口，visitor 返回 false 时停止；枚举失败时返回 false
+        virtual bool EnumerateTopLevel(const Visitor &visitor) = 0;
+
+        virtual bool IsWindow(WindowHandle handle) = 0;
+
+        virtual bool IsVisible(WindowHandle handle) = 0;
+
+        // 读取样式与扩展样式，窗口已经不存在时返回 false
+        virtual bool Styles(WindowHandle handle, std::uint32_t &style, std::uint32_t &exStyle) = 0;
+
+        virtual WindowHandle Parent(WindowHandle handle) = 0;
+
+        virtual WindowHandle Owner(WindowHandle handle) = 0;
+
+        virtual WindowHandle Desktop() = 0;
+
+        virtual size_t TitleLength(WindowHandle handle) = 0;
+
+        virtual std::string Title(WindowHandle handle) = 0;
+
+        virtual std::string ClassName(WindowHandle handle) = 0;
+
+        virtual bool IsMinimized(WindowHandle handle) = 0;
+
+        virtual bool IsMaximized(WindowHandle handle) = 0;
+
+        virtual std::uint32_t ProcessId(WindowHandle handle) = 0;
+
+        // 不经缓存读取进程的映像名，无法读取时为 "Unknown"
+        virtual std::string ProcessName(std::uint32_t processId) = 0;
+    };
+}
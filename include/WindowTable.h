@@ -0,0 +1,67 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "StringPool.h"
+#include "WindowEventSource.h"
+
+namespace v1_taskbar_manager {
+    /**
+     * @brief 按列存放的任务栏窗口表
+     * @note 句柄、进程 ID 与状态各占一个连续数组，类名与进程名只保存字符串池中的下标，标题首尾相接存放；
+     * 句柄的十六进制文本在序列化时生成。每次刷新时 Clear 后重新追加，保留已有容量
+     */
+    class WindowTable {
+    public:
+        void Clear();
+
+        void Reserve(size_t count);
+
+        void Append(WindowHandle handle, std::string_view title, std::string_view className, uint32_t processId,
+                    std::string_view processName, bool isMinimized, bool isMaximized);
+
+        void Append(const WindowRecord &record);
+
+        size_t Size() const { return handles.size(); }
+
+        WindowHandle Handle(size_t row) const { return handles[row]; }
+
+        std::string HandleText(size_t row) const;
+
+        std::string_view Title(size_t row) const {
+            return std::string_view(titles).substr(titleOffsets[row], titleOffsets[row + 1] - titleOffsets[row]);
+        }
+
+        std::string_view ClassName(size_t row) const { return strings.Get(classNames[row]); }
+
+        uint32_t ProcessId(size_t row) const { return processIds[row]; }
+
+        std::string_view ProcessName(size_t row) const { return strings.Get(processNames[row]); }
+
+        bool IsMinimized(size_t row) const { return flags[row] & FlagMinimized; }
+
+        bool IsMaximized(size_t row) const { return flags[row] & FlagMaximized; }
+
+        void AppendWindowJson(size_t row, std::string &out) const;
+
+        void AppendJson(std::string &out) const;
+
+    private:
+        enum Flag : uint8_t {
+            FlagMinimized = 1u << 0,
+            FlagMaximized = 1u << 1,
+        };
+
+        std::vector<WindowHandle> handles;
+        std::vector<uint32_t> processIds;
+        std::vector<uint8_t> flags;
+        std::vector<uint32_t> classNames;
+        std::vector<uint32_t> processNames;
+        // 第 i 个窗口的标题位于 titles 的 [titleOffsets[i], titleOffsets[i + 1])，标题几乎不重复，不做去重
+        std::vector<uint32_t> titleOffsets{0};
+        std::string titles;
+        StringPool strings;
+    };
+}
@@ -1,12 +1,15 @@
 #include "Application.h"
 
 #include <dwmapi.h>
+#include <cctype>
+#include <cstdlib>
 #include <future>
 #include <iostream>
 #include <sstream>
 
 #include "Constants.h"
 #include "Utils.h"
+#include "WindowManager.h"
 #define SPDLOG_ACTIVE_LEVEL SPDLOG_LOGGER_TRACE
 #include "spdlog/sinks/basic_file_sink.h"
 #include "spdlog/sinks/stdout_color_sinks.h"
@@ -70,25 +73,39 @@ namespace v1_taskbar_manager {
             return 1;
         }
 
-        this->httpServer = std::make_unique<v2_taskbar_manager::HttpServer>();
+        this->hWnd = CreateMainWindow(hInstance, nCmdShow);
+        if (!hWnd) {
+            MessageBox(nullptr, L"Failed to create window!", L"Error", MB_ICONERROR);
+            return 1;
+        }
+
+        // 窗口事件钩子投递到安装它的线程，窗口注册表在 UI 线程上创建并维护
+        this->windowEventSource = std::make_unique<Win32WindowEventSource>();
+        this->windowRegistry = std::make_unique<WindowRegistry>(*this->windowEventSource);
+        this->windowRegistry->Start();
+
+        this->globalHotKeyManager = std::make_shared<GlobalHotKeyManager>(hWnd);
+        this->commandDispatcher =
+            std::make_unique<CommandDispatcher>(hWnd, this->globalHotKeyManager, *this->windowRegistry);
+
+        // API 的命令投递到主窗口执行，HTTP 服务需要在主窗口与命令分发层创建之后启动
+        v2_taskbar_manager::HttpServerOptions httpOptions;
+        httpOptions.apiTimeout = std::chrono::milliseconds(COMMAND_INVOKE_TIMEOUT);
+        httpOptions.apiTimeoutBody = CommandResult{20000, "UI 线程未响应", nullptr}.ToJson().dump();
+        this->httpServer = std::make_unique<v2_taskbar_manager::HttpServer>(httpOptions);
+        RegisterApis();
         int port = this->httpServer->Start();
         if (port == -1) {
             this->httpServer->Stop();
+            DestroyWindow(hWnd);
             SPDLOG_ERROR("内置 HTTP 服务启动失败");
             spdlog::shutdown();
             return 1;
         }
         SPDLOG_INFO("本地 Socket 服务端口: {}", port);
 
-        this->hWnd = CreateMainWindow(hInstance, nCmdShow);
-        if (!hWnd) {
-            MessageBox(nullptr, L"Failed to create window!", L"Error", MB_ICONERROR);
-            return 1;
-        }
-
-        this->globalHotKeyManager = std::make_shared<GlobalHotKeyManager>(hWnd);
         this->trayManager = std::make_unique<TrayManager>(hWnd);
-        this->webViewController = std::make_unique<WebViewController>(hWnd, this->globalHotKeyManager, port);
+        this->webViewController = std::make_unique<WebViewController>(hWnd, *this->commandDispatcher, port);
 
         // 设置窗口圆角
         constexpr DWM_WINDOW_CORNER_PREFERENCE preference = DWMWCP_ROUND;
@@ -97,6 +114,9 @@ namespace v1_taskbar_manager {
         trayManager->AddTrayIcon();
         webViewController->Initialize();
 
+        // 窗口列表的变化通过 WebSocket 推送给页面
+        SetTimer(hWnd, ID_TIMER_PUBLISH_WINDOWS, WINDOW_PUBLISH_INTERVAL, nullptr);
+
         ShowWindow(hWnd, nCmdShow);
         UpdateWindow(hWnd);
 
@@ -199,10 +219,23 @@ namespace v1_taskbar_manager {
             default: ;
             }
             break;
+        case WM_TIMER:
+            if (wParam == ID_TIMER_PUBLISH_WINDOWS) {
+                // 释放已经退出的进程的句柄，不必等到同一 PID 的窗口再次出现
+                windowEventSource->Processes().Sweep();
+                PublishWindows();
+            }
+            break;
+        case WM_DISPATCH_COMMAND:
+            if (commandDispatcher) {
+                commandDispatcher->HandleInvokeMessage(lParam);
+            }
+            return 0;
         case WM_HOTKEY:
             if (globalHotKeyManager) {
                 globalHotKeyManager->HandleHotKeyMessage(wParam);
             }
+            PublishEvent("hotkey", {{"id", static_cast<int>(wParam)}});
             return 0;
         case WM_DESTROY:
             PostQuitMessage(0);
@@ -296,9 +329,122 @@ namespace v1_taskbar_manager {
         SPDLOG_INFO("日志存储位置: {}", Utils::WStringToString(logFile));
     }
 
+    /**
+     * @brief 把窗口与热键命令登记为 HTTP API
+     * @note 处理函数在 I/O 工作线程上调用，命令由 CommandDispatcher 投递到 UI 线程执行，与 WebView2 消息共用同一个分发层；
+     * 工作线程不等待结果，UI 线程执行完命令之后完成响应，由后端唤醒工作线程发送。
+     * 响应正文与消息协议中的 result 相同：{"code","msg","data"}，命令失败时状态码为 422，
+     * UI 线程未在 COMMAND_INVOKE_TIMEOUT 内执行完或分发层已停止时为 503
+     */
+    void Application::RegisterApis() {
+        using Reply = std::shared_ptr<v2_taskbar_manager::HttpApiReply>;
+        auto invoke = [this](std::string cmd, nlohmann::json args, const Reply &reply) {
+            commandDispatcher->Post(std::move(cmd), std::move(args), [reply](std::optional<CommandResult> result) {
+                if (!result) {
+                    reply->Complete(503, CommandResult{20000, "UI 线程未响应", nullptr}.ToJson().dump());
+                    return;
+                }
+                reply->Complete(result->code == 10000 ? 200 : 422, result->ToJson().dump());
+            });
+        };
+
+        // GET /api/windows，带上 ?since=上次返回的 version 时只返回变化
+        httpServer->AddDeferredApi("GET", "/api/windows",
+                                   [invoke](const v2_taskbar_manager::HttpApiRequest &request, const Reply &reply) {
+                                       const std::string since(
+                                           v2_taskbar_manager::QueryParameter(request.query, "since"));
+                                       char *end = nullptr;
+                                       const unsigned long long version = std::strtoull(since.c_str(), &end, 10);
+                                       if (since.empty() || !std::isdigit(static_cast<unsigned char>(since[0])) ||
+                                           *end != '\0') {
+                                           invoke("getWindows", nullptr, reply);
+                                           return;
+                                       }
+                                       invoke("getWindows", {{"since", static_cast<std::uint64_t>(version)}}, reply);
+                                   });
+        // POST /api/windows/0x1A2B/activate
+        httpServer->AddDeferredApi("POST", "/api/windows/:handle/activate",
+                                   [invoke](const v2_taskbar_manager::HttpApiRequest &request, const Reply &reply) {
+                                       const std::string handle(request.params.Get("handle"));
+                                       invoke("activateWindow", {{"handle", handle}}, reply);
+                                   });
+        // PUT /api/hotkey，请求体与 registerHotkey 的 hotkey 参数相同：{"ctrl":true,"alt":true,"key":"T"}
+        httpServer->AddDeferredApi("PUT", "/api/hotkey",
+                                   [invoke](const v2_taskbar_manager::HttpApiRequest &request, const Reply &reply) {
+                                       nlohmann::json hotkey =
+                                           nlohmann::json::parse(request.request.body, nullptr, false);
+                                       if (hotkey.is_discarded() || !hotkey.is_object()) {
+                                           reply->Complete(
+                                               400, CommandResult{20000, "请求体不是 JSON 对象", nullptr}.ToJson().dump());
+                                           return;
+                                       }
+                                       invoke("registerHotkey", {{"hotkey", std::move(hotkey)}}, reply);
+                                   });
+        // DELETE /api/hotkey
+        httpServer->AddDeferredApi("DELETE", "/api/hotkey",
+                                   [invoke](const v2_taskbar_manager::HttpApiRequest &, const Reply &reply) {
+                                       invoke("clearHotkey", nullptr, reply);
+                                   });
+    }
+
+    /**
+     * @brief 把窗口注册表中的任务栏窗口发布到 WebSocket 广播中心，有变化时同时发布 windows 事件
+     * @note 由定时器在 UI 线程上调用，注册表版本没有变化时直接返回；
+     * 广播中心与上一次发布的列表比较，只把增加、更新、删除的窗口推送给客户端。
+     * 没有客户端连接时同样发布，广播中心保存的列表始终跟随注册表，新连接收到的 reset 最多落后一个定时器周期
+     */
+    void Application::PublishWindows() {
+        v2_taskbar_manager::WebSocketHub &hub = httpServer->GetWebSocketHub();
+        if (windowRegistry->Version() == publishedWindowsVersion) {
+            return;
+        }
+        publishedWindowsVersion = windowRegistry->Version();
+        // 从列式窗口表直接生成 JSON 文本，不再为每个窗口构造 nlohmann::json 对象
+        // 表的行与 Windows() 的顺序一致，句柄文本直接取自记录，不再逐行格式化
+        const WindowTable &table = windowRegistry->Table();
+        const std::vector<WindowRecord> &windows = windowRegistry->Windows();
+        std::vector<std::pair<std::string, std::string>> items;
+        items.reserve(table.Size());
+        std::string data = "{\"windows\":[";
+        for (size_t row = 0; row < table.Size(); row++) {
+            std::string windowJson;
+            table.AppendWindowJson(row, windowJson);
+            if (row > 0) {
+                data.push_back(',');
+            }
+            data.append(windowJson);
+            items.emplace_back(windows[row].handleText, std::move(windowJson));
+        }
+        data.append("]}");
+        if (hub.Publish(std::move(items)) > 0) {
+            httpServer->GetEventStreamHub().Publish("windows", data);
+        }
+    }
+
+    /**
+     * @brief 发布一个原生事件到事件流（/events）
+     * @param name 事件名，对应 EventSource 的事件类型
+     * @param data 事件数据
+     * @note 与发送给 WebView2 的事件消息 {"event","data"} 对应：事件名放在 event 字段，data 原样作为事件数据
+     */
+    void Application::PublishEvent(const std::string &name, const nlohmann::json &data) {
+        if (httpServer) {
+            httpServer->GetEventStreamHub().Publish(name, data.dump());
+        }
+    }
+
     void Application::Cleanup() {
+        KillTimer(hWnd, ID_TIMER_PUBLISH_WINDOWS);
+        // 消息循环已经结束，先让等待 UI 线程的 API 立即返回，停止服务时不必等到超时
+        commandDispatcher->Stop();
         this->httpServer->Stop();
         webViewController.reset();
+        commandDispatcher.reset();
+        const ProcessInfoCacheStats processStats = windowEventSource->Processes().Stats();
+        SPDLOG_INFO("进程信息缓存：命中 {}，未命中 {}，淘汰 {}，进程退出 {}", processStats.hits, processStats.misses,
+                    processStats.evictions, processStats.exits);
+        windowRegistry.reset();
+        windowEventSource.reset();
         trayManager.reset();
         globalHotKeyManager.reset();
         if (mutex) {
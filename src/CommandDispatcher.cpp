@@ -0,0 +1,173 @@
+#include "CommandDispatcher.h"
+
+#include "Constants.h"
+#include "Utils.h"
+#include "WindowManager.h"
+#include "spdlog/spdlog.h"
+
+namespace v1_taskbar_manager {
+    // 投递到 UI 线程的命令，由消息参数持有，执行或 Stop 清理时释放
+    struct CommandDispatcher::PendingCommand {
+        std::string cmd;
+        nlohmann::json args;
+        Callback callback;
+    };
+
+    CommandDispatcher::CommandDispatcher(HWND hWnd, const std::weak_ptr<GlobalHotKeyManager> &globalHotKeyManager,
+                                         const WindowRegistry &windowRegistry)
+        : hWnd(hWnd), globalHotKeyManager(globalHotKeyManager), windowRegistry(windowRegistry) {
+    }
+
+    /**
+     * @brief 在 UI 线程上执行命令
+     * @param cmd 命令：getWindows、activateWindow、registerHotkey、clearHotkey
+     * @param args 命令参数
+     * @return CommandResult 成功时 code 为 10000，失败时为 20000
+     */
+    CommandResult CommandDispatcher::Dispatch(const std::string &cmd, const nlohmann::json &args) const {
+        if (cmd == "getWindows") {
+            return {10000, "查询成功", WindowsToJson(args)};
+        }
+        if (cmd == "activateWindow") {
+            const std::string handle = args.is_object() ? args.value("handle", "") : "";
+            if (!IsWindow(Utils::HexStringToHWnd(handle))) {
+                return {20000, "窗口不存在", nullptr};
+            }
+            WindowManager::ActivateWindow(handle);
+            return {10000, "操作成功", nullptr};
+        }
+        if (cmd == "registerHotkey") {
+            const nlohmann::json hotkey =
+                args.is_object() && args.contains("hotkey") ? args["hotkey"] : nlohmann::json::object();
+            if (!hotkey.is_object()) {
+                return {20000, "热键参数无效", nullptr};
+            }
+            const bool ctrl = hotkey.value("ctrl", false);
+            const bool shift = hotkey.value("shift", false);
+            const bool alt = hotkey.value("alt", false);
+            const std::string key = hotkey.value("key", "");
+
+            if (auto ghm = globalHotKeyManager.lock()) {
+                HotKeyRegistrationResult result = ghm->RegisterGlobalHotKey(ctrl, shift, alt, key, [this] {
+                    ShowWindow(this->hWnd, SW_RESTORE);
+                    SetForegroundWindow(this->hWnd);
+                });
+
+                if (result.Success()) {
+                    return {10000, "操作成功", nullptr};
+                }
+                // 返回详细的错误信息
+                nlohmann::json errorData = {{"errorCode", result.errorCode},
+                                            {"errorMessage", result.errorMessage}};
+                return {20000, result.errorMessage, errorData};
+            }
+            return {20000, "全局热键管理器不可用", nullptr};
+        }
+        if (cmd == "clearHotkey") {
+            if (auto ghm = globalHotKeyManager.lock()) {
+                ghm->UnregisterAll();
+                return {10000, "操作成功", nullptr};
+            }
+            return {20000, "全局热键管理器不可用", nullptr};
+        }
+        return {20000, "未知命令: " + cmd, nullptr};
+    }
+
+    /**
+     * @brief 从任意线程把命令投递到 UI 线程执行，不等待结果
+     * @param cmd 命令
+     * @param args 命令参数
+     * @param callback 在 UI 线程上以命令的结果调用；分发层已停止或无法投递时在调用线程上立即以空结果调用
+     * @note 调用方（HTTP API）自己负责超时，超时之后命令仍会执行，回调的结果由调用方丢弃
+     */
+    void CommandDispatcher::Post(std::string cmd, nlohmann::json args, Callback callback) const {
+        auto pending = std::make_unique<PendingCommand>(
+            PendingCommand{std::move(cmd), std::move(args), std::move(callback)});
+        {
+            std::lock_guard lock(postMutex);
+            if (!stopping) {
+                if (PostMessage(hWnd, WM_DISPATCH_COMMAND, 0, reinterpret_cast<LPARAM>(pending.get()))) {
+                    // 消息参数持有命令，由 HandleInvokeMessage 或 Stop 释放
+                    pending.release();
+                    return;
+                }
+                SPDLOG_WARN("无法把命令投递到 UI 线程: {}", pending->cmd);
+            }
+        }
+        pending->callback(std::nullopt);
+    }
+
+    /**
+     * @brief 在 UI 线程上执行 Post 投递的命令
+     * @param lParam WM_DISPATCH_COMMAND 消息的参数
+     */
+    void CommandDispatcher::HandleInvokeMessage(const LPARAM lParam) const {
+        const std::unique_ptr<PendingCommand> pending(reinterpret_cast<PendingCommand *>(lParam));
+        pending->callback(Dispatch(pending->cmd, pending->args));
+    }
+
+    /**
+     * @brief 停止接受新的命令，消息队列中尚未执行的命令立即以空结果回调并释放
+     * @note 在 UI 线程上、停止 HTTP 服务之前调用；此时 UI 线程已退出消息循环，不会再执行这些命令
+     */
+    void CommandDispatcher::Stop() {
+        {
+            std::lock_guard lock(postMutex);
+            stopping = true;
+        }
+        MSG msg;
+        while (PeekMessage(&msg, nullptr, WM_DISPATCH_COMMAND, WM_DISPATCH_COMMAND, PM_REMOVE)) {
+            const std::unique_ptr<PendingCommand> pending(reinterpret_cast<PendingCommand *>(msg.lParam));
+            pending->callback(std::nullopt);
+        }
+    }
+
+    /**
+     * @brief 生成 getWindows 的结果
+     * @param args 命令参数，since 为客户端上次看到的版本号
+     * @return nlohmann::json since 的快照仍在历史中时返回 {version, since, add, update, remove}，
+     * 字段与 WebSocket 推送的变化消息相同，空数组省略；否则返回完整列表 {windows, version}
+     * @note 直接读取由窗口事件维护的模型，不再逐个枚举顶层窗口
+     */
+    nlohmann::json CommandDispatcher::WindowsToJson(const nlohmann::json &args) const {
+        const std::vector<WindowRecord> &windows = windowRegistry.Windows();
+        const std::uint64_t version = windowRegistry.Version();
+        nlohmann::json data;
+        data["version"] = version;
+
+        WindowDelta delta;
+        if (args.is_object() && args.contains("since") && args["since"].is_number_unsigned() &&
+            windowHistory.Diff(args["since"].get<std::uint64_t>(), windows, delta)) {
+            data["since"] = args["since"];
+            if (!delta.added.empty()) {
+                nlohmann::json &add = data["add"] = nlohmann::json::array();
+                for (const WindowRecord *record : delta.added) {
+                    add.push_back(WindowManager::WindowToJson(*record));
+                }
+            }
+            nlohmann::json update = nlohmann::json::array();
+            for (const WindowChange &change : delta.changed) {
+                // 页面只展示标题，其他字段的变化不下发
+                if (change.fields & WindowFieldTitle) {
+                    update.push_back(WindowManager::WindowToJson(*change.record));
+                }
+            }
+            if (!update.empty()) {
+                data["update"] = std::move(update);
+            }
+            if (!delta.removed.empty()) {
+                nlohmann::json &remove = data["remove"] = nlohmann::json::array();
+                for (const std::string_view handle : delta.removed) {
+                    remove.push_back(handle);
+                }
+            }
+        } else {
+            data["windows"] = nlohmann::json::array();
+            for (const WindowRecord &record : windows) {
+                data["windows"].push_back(WindowManager::WindowToJson(record));
+            }
+        }
+        windowHistory.Remember(version, windows);
+        return data;
+    }
+}
@@ -0,0 +1,770 @@
+#ifdef __linux__
+#include "EpollBackend.h"
+
+#include <algorithm>
+#include <arpa/inet.h>
+#include <cerrno>
+#include <cstring>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/resource.h>
+#include <sys/sendfile.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include "spdlog/spdlog.h"
+
+namespace v2_taskbar_manager {
+    namespace {
+        // 超时定时器的精度，也是有定时器时 epoll_wait 的最长等待时间
+        constexpr std::chrono::milliseconds kTimerTick{250};
+        // 文件描述符耗尽时暂停接受连接的时长，期间有连接关闭时提前恢复
+        constexpr std::chrono::milliseconds kAcceptRetryDelay{100};
+        // 为监听套接字、epoll、eventfd、静态文件与日志等保留的文件描述符数
+        constexpr size_t kReservedDescriptors = 64;
+
+        /**
+         * @brief 按进程的文件描述符上限（RLIMIT_NOFILE）限制连接上下文池的容量
+         * @param poolSize 配置的连接上下文池容量
+         * @return size_t 不超过上限减去保留数的容量，至少为 1
+         */
+        size_t LimitPoolToDescriptors(const size_t poolSize) {
+            rlimit limit{};
+            if (getrlimit(RLIMIT_NOFILE, &limit) < 0 || limit.rlim_cur == RLIM_INFINITY ||
+                poolSize + kReservedDescriptors <= limit.rlim_cur) {
+                return poolSize;
+            }
+            const size_t capped = limit.rlim_cur > kReservedDescriptors + 1 ? limit.rlim_cur - kReservedDescriptors : 1;
+            SPDLOG_WARN("连接上下文池容量 {} 超过文件描述符上限 {}，调整为 {}", poolSize, limit.rlim_cur, capped);
+            return capped;
+        }
+
+        /**
+         * @brief 判断 accept 的错误是否因为文件描述符或内核内存耗尽
+         * @param error errno
+         * @return bool 是否需要暂停接受连接：这些错误不会从监听队列中取走连接，立即重试只会空转
+         */
+        bool IsDescriptorShortage(const int error) {
+            return error == EMFILE || error == ENFILE || error == ENOBUFS || error == ENOMEM;
+        }
+
+        /**
+         * @brief 读取监听队列中已完成握手、等待被接受的连接数
+         * @param socket 监听套接字
+         * @return size_t 监听状态的套接字在 tcpi_unacked 中报告当前的接受队列长度
+         */
+        size_t ListenBacklog(const int socket) {
+            tcp_info info{};
+            socklen_t length = sizeof(info);
+            if (socket < 0 || getsockopt(socket, IPPROTO_TCP, TCP_INFO, &info, &length) < 0) {
+                return 0;
+            }
+            return info.tcpi_unacked;
+        }
+
+        /**
+         * @brief 以 503 响应拒绝一个新连接并关闭
+         * @param socket 刚接受的连接
+         * @param response 处理器预先生成的 503 响应
+         * @note 先读走已经到达的请求数据：关闭时接收队列中留有数据会使内核发送 RST，客户端可能收不到响应
+         */
+        void RejectConnection(const int socket, std::string_view response) {
+            char discard[2048];
+            for (int i = 0; i < 4 && recv(socket, discard, sizeof(discard), MSG_DONTWAIT) > 0; i++) {
+            }
+            send(socket, response.data(), response.size(), MSG_DONTWAIT | MSG_NOSIGNAL);
+            shutdown(socket, SHUT_WR);
+            close(socket);
+        }
+    }
+
+    EpollBackend::EpollBackend(const HttpRequestHandler &handler, const HttpServerOptions &options)
+        : handler(handler), options(options) {
+    }
+
+    /**
+     * @brief 启动 epoll 后端
+     * @param port 端口号，为 0 时由系统分配
+     * @return int 实际监听的端口号，失败返回 -1
+     * @note 第一个事件循环确定实际端口，其余事件循环通过 SO_REUSEPORT 绑定到同一端口，由内核分发新连接。
+     * 连接上下文池按事件循环平均划分，连接只在所属线程内使用，池操作不会产生竞争
+     */
+    int EpollBackend::Start(const int port) {
+        const size_t workerCount = options.ResolveWorkerThreads();
+        const size_t poolCapacity = (LimitPoolToDescriptors(options.connectionPoolSize) + workerCount - 1) / workerCount;
+        int actualPort = port;
+        for (size_t i = 0; i < workerCount; i++) {
+            auto loop = std::make_unique<EventLoop>(poolCapacity, kTimerTick);
+            actualPort = OpenLoop(*loop, actualPort);
+            loops.push_back(std::move(loop));
+            if (actualPort == -1) {
+                Stop();
+                return -1;
+            }
+        }
+
+        isRunning.store(true);
+        for (const auto &loop : loops) {
+            loop->thread = std::thread(&EpollBackend::WorkerThread, this, std::ref(*loop));
+        }
+        SPDLOG_INFO("epoll Worker 线程数: {}", workerCount);
+        return actualPort;
+    }
+
+    /**
+     * @brief 停止 epoll 后端
+     * @return HttpShutdownReport 停止所用的时间与连接的关闭情况
+     * @note 通过 eventfd 唤醒每个事件循环，由事件循环自己停止接受并关闭连接；
+     * 线程在连接全部关闭或到达期限之后结束，之后关闭剩余的连接
+     */
+    HttpShutdownReport EpollBackend::Stop() {
+        const auto start = std::chrono::steady_clock::now();
+        drainDeadline = start + options.drainTimeout;
+        draining.store(true);
+
+        for (const auto &loop : loops) {
+            if (loop->wakeupFd >= 0) {
+                constexpr uint64_t one = 1;
+                [[maybe_unused]] const ssize_t ignored = write(loop->wakeupFd, &one, sizeof(one));
+            }
+        }
+
+        SPDLOG_INFO("等待 Worker 线程结束");
+        HttpShutdownReport report;
+        for (const auto &loop : loops) {
+            if (loop->thread.joinable()) {
+                loop->thread.join();
+            }
+            report.connections += loop->drainConnections;
+            report.aborted += loop->contexts.size();
+            CloseLoop(*loop);
+        }
+        loops.clear();
+        isRunning.store(false);
+        report.duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+        return report;
+    }
+
+    /**
+     * @brief 获取运行时计数器
+     * @return HttpServerStats 所有事件循环的计数器之和
+     */
+    HttpServerStats EpollBackend::GetStats() const {
+        HttpServerStats stats;
+        for (const auto &loop : loops) {
+            stats.poolCapacity += loop->pool.Capacity();
+            stats.poolInUse += loop->pool.InUse();
+            stats.poolPeak += loop->pool.Peak();
+            stats.poolExhausted += loop->pool.Exhausted();
+            stats.connectionsRejected += loop->connectionsRejected.load();
+            stats.connectionsDeferred += loop->connectionsDeferred.load();
+            stats.acceptsWithData += loop->acceptsWithData.load();
+            stats.acceptBacklog += ListenBacklog(loop->listenSocket);
+            stats.firstByteTimeouts += loop->timeouts[static_cast<size_t>(HttpWaitPhase::FirstByte)].load();
+            stats.headerTimeouts += loop->timeouts[static_cast<size_t>(HttpWaitPhase::Header)].load();
+            stats.idleTimeouts += loop->timeouts[static_cast<size_t>(HttpWaitPhase::Idle)].load();
+        }
+        return stats;
+    }
+
+    /**
+     * @brief 创建事件循环的监听套接字、epoll 实例与唤醒描述符
+     * @param loop 事件循环
+     * @param port 端口号，为 0 时由系统分配
+     * @return int 实际监听的端口号，失败返回 -1
+     */
+    int EpollBackend::OpenLoop(EventLoop &loop, const int port) const {
+        loop.listenSocket = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, IPPROTO_TCP);
+        if (loop.listenSocket < 0) {
+            return -1;
+        }
+
+        // 设置套接字选项以允许地址重用，多个事件循环共享同一端口
+        constexpr int reuse = 1;
+        setsockopt(loop.listenSocket, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+        setsockopt(loop.listenSocket, SOL_SOCKET, SO_REUSEPORT, &reuse, sizeof(reuse));
+        // 握手完成之后等到第一段请求数据到达才放入接受队列，接受之后可以直接读取，与 IOCP 的 AcceptEx 携带接收缓冲区对应
+        if (options.acceptWithFirstRead) {
+            const int seconds = static_cast<int>(std::max<long long>(
+                std::chrono::duration_cast<std::chrono::seconds>(options.firstByteTimeout).count(), 1));
+            setsockopt(loop.listenSocket, IPPROTO_TCP, TCP_DEFER_ACCEPT, &seconds, sizeof(seconds));
+        }
+
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        address.sin_port = htons(port);
+
+        // 获取实际分配的端口号
+        sockaddr_in actualAddr{};
+        socklen_t len = sizeof(actualAddr);
+        if (bind(loop.listenSocket, reinterpret_cast<sockaddr *>(&address), sizeof(address)) < 0 ||
+            getsockname(loop.listenSocket, reinterpret_cast<sockaddr *>(&actualAddr), &len) < 0 ||
+            listen(loop.listenSocket, SOMAXCONN) < 0) {
+            return -1;
+        }
+
+        loop.epollFd = epoll_create1(EPOLL_CLOEXEC);
+        loop.wakeupFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (loop.epollFd < 0 || loop.wakeupFd < 0) {
+            return -1;
+        }
+
+        // 监听套接字与唤醒描述符使用 nullptr/自身地址作为标识，与连接上下文区分
+        epoll_event event{};
+        event.events = EPOLLIN;
+        event.data.ptr = nullptr;
+        epoll_ctl(loop.epollFd, EPOLL_CTL_ADD, loop.listenSocket, &event);
+        event.data.ptr = &loop.wakeupFd;
+        epoll_ctl(loop.epollFd, EPOLL_CTL_ADD, loop.wakeupFd, &event);
+
+        return ntohs(actualAddr.sin_port);
+    }
+
+    /**
+     * @brief 接受所有等待中的连接并注册到 epoll
+     * @param loop 事件循环
+     * @note 文件描述符耗尽时与池耗尽一样暂停接受，等有连接关闭或 kAcceptRetryDelay 之后再恢复
+     */
+    void EpollBackend::AcceptConnections(EventLoop &loop) {
+        while (true) {
+            // 池耗尽时按过载策略拒绝新连接，或暂停接受连接、等有连接关闭后再恢复
+            EpollContext *context = loop.pool.Acquire(options);
+            if (context == nullptr && options.overloadPolicy == HttpOverloadPolicy::Reject) {
+                const int socket = accept4(loop.listenSocket, nullptr, nullptr, SOCK_CLOEXEC);
+                if (socket < 0) {
+                    PauseAcceptOnShortage(loop, errno);
+                    return;
+                }
+                RejectConnection(socket, handler.OverloadedResponse());
+                loop.connectionsRejected.fetch_add(1, std::memory_order_relaxed);
+                continue;
+            }
+            if (context == nullptr) {
+                if (!loop.acceptPaused) {
+                    loop.connectionsDeferred.fetch_add(1, std::memory_order_relaxed);
+                }
+                SetAcceptPaused(loop, true);
+                return;
+            }
+
+            const int socket = accept4(loop.listenSocket, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+            if (socket < 0) {
+                const int error = errno;
+                loop.pool.Release(context);
+                PauseAcceptOnShortage(loop, error);
+                return;
+            }
+
+            context->socket = socket;
+            context->wantWrite = false;
+            context->closed = false;
+            context->connection.Reset();
+            loop.contexts.insert(context);
+            loop.timers.Schedule(&context->timer, context->connection.ReceiveDeadline());
+
+            epoll_event event{};
+            event.events = EPOLLIN;
+            event.data.ptr = context;
+            if (epoll_ctl(loop.epollFd, EPOLL_CTL_ADD, socket, &event) < 0) {
+                CloseContext(loop, context);
+                continue;
+            }
+            // 延迟接受的连接通常已经带有请求数据，直接读取省去一次 epoll_wait
+            if (options.acceptWithFirstRead && HandleReadable(loop, context) > 0) {
+                loop.acceptsWithData.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * @brief 处理可读事件
+     * @param loop 事件循环
+     * @param context 连接上下文
+     * @return ssize_t 接收的字节数，没有数据或失败时返回 -1
+     */
+    ssize_t EpollBackend::HandleReadable(EventLoop &loop, EpollContext *context) {
+        const ssize_t count = recv(context->socket, context->recvData, sizeof(context->recvData), 0);
+        if (count < 0) {
+            if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+                CloseContext(loop, context);
+            }
+            return count;
+        }
+        Dispatch(loop, context,
+                 context->connection.OnReceived(context->recvData, static_cast<size_t>(count), handler));
+        return count;
+    }
+
+    /**
+     * @brief 处理可写事件，尽可能多地发送待发送数据
+     * @param loop 事件循环
+     * @param context 连接上下文
+     */
+    void EpollBackend::HandleWritable(EventLoop &loop, EpollContext *context) {
+        const ssize_t count = SendPending(context);
+        if (count < 0) {
+            if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+                CloseContext(loop, context);
+            }
+            return;
+        }
+        Dispatch(loop, context, context->connection.OnSent(static_cast<size_t>(count), handler));
+    }
+
+    /**
+     * @brief 以 scatter/gather 方式发送连接中尚未发送的头部与正文
+     * @param context 连接上下文
+     * @return ssize_t 发送的字节数，失败返回 -1
+     * @note 头部发送完毕之后，资源目录中未映射的大文件由 sendfile 直接从页缓存发送，不经过用户态
+     */
+    ssize_t EpollBackend::SendPending(EpollContext *context) {
+        std::string_view pending[2];
+        const size_t count = context->connection.PendingBuffers(pending);
+        if (count == 0) {
+            uint64_t offset = 0;
+            size_t length = 0;
+            const StaticFile *file = context->connection.PendingFile(offset, length);
+            if (file == nullptr) {
+                return 0;
+            }
+            auto fileOffset = static_cast<off_t>(offset);
+            const ssize_t sent = sendfile(context->socket, file->fd, &fileOffset, length);
+            if (sent == 0) {
+                // 文件在发送过程中被截断，已经无法按 Content-Length 完成响应
+                errno = EIO;
+                return -1;
+            }
+            return sent;
+        }
+        iovec vectors[2];
+        for (size_t i = 0; i < count; i++) {
+            vectors[i].iov_base = const_cast<char *>(pending[i].data());
+            vectors[i].iov_len = pending[i].size();
+        }
+        msghdr message{};
+        message.msg_iov = vectors;
+        message.msg_iovlen = count;
+        return sendmsg(context->socket, &message, MSG_NOSIGNAL);
+    }
+
+    /**
+     * @brief 根据连接状态机给出的动作调整 epoll 关注的事件
+     * @param loop 事件循环
+     * @param context 连接上下文
+     * @param action 下一个动作
+     * @note 与 IOCP 的投递语义保持一致：Send 时先直接尝试发送，只有发送缓冲区已满才等待 EPOLLOUT
+     */
+    void EpollBackend::Dispatch(EventLoop &loop, EpollContext *context, HttpAction action) {
+        while (action == HttpAction::Send && !context->wantWrite) {
+            const ssize_t count = SendPending(context);
+            if (count >= 0) {
+                action = context->connection.OnSent(static_cast<size_t>(count), handler);
+                continue;
+            }
+            if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+                CloseContext(loop, context);
+                return;
+            }
+            context->wantWrite = true;
+            loop.timers.Cancel(&context->timer);
+            SetInterest(loop, context, EPOLLOUT);
+        }
+
+        if (action == HttpAction::Upgrade) {
+            UpgradeContext(loop, context);
+        } else if (action == HttpAction::Wait) {
+            WaitReply(loop, context);
+        } else if (action == HttpAction::Receive && loop.draining) {
+            // 停止期间响应发送完毕的连接不再等待下一个请求
+            CloseContext(loop, context);
+        } else if (action == HttpAction::Receive) {
+            // 每次等待请求数据都按连接所处阶段重新设置截止时间，请求头超时从请求开始起算，不会被零散的数据延长
+            loop.timers.Schedule(&context->timer, context->connection.ReceiveDeadline());
+            if (context->wantWrite) {
+                context->wantWrite = false;
+                SetInterest(loop, context, EPOLLIN);
+            }
+        } else if (action == HttpAction::Close) {
+            CloseContext(loop, context);
+        }
+    }
+
+    /**
+     * @brief 握手响应（或事件流的响应头）发送完毕后把连接切换为推送连接
+     * @param loop 事件循环
+     * @param context 连接上下文
+     * @note 推送连接长期存在，不受等待请求的超时约束；订阅时排队的数据通过唤醒路径发送
+     */
+    void EpollBackend::UpgradeContext(EventLoop &loop, EpollContext *context) {
+        loop.timers.Cancel(&context->timer);
+        if (context->wantWrite) {
+            context->wantWrite = false;
+            SetInterest(loop, context, EPOLLIN);
+        }
+        context->connection.Stream()->Subscribe(context, [&loop](StreamSession &session) {
+            {
+                std::lock_guard lock(loop.readyMutex);
+                loop.readySessions.push_back(session.shared_from_this());
+            }
+            constexpr uint64_t one = 1;
+            [[maybe_unused]] const ssize_t ignored = write(loop.wakeupFd, &one, sizeof(one));
+        });
+    }
+
+    /**
+     * @brief 等待其他线程完成 API 响应，期间事件循环继续处理其他连接
+     * @param loop 事件循环
+     * @param context 连接上下文
+     * @note 等待期间不关注任何事件，管线化的后续请求留在内核缓冲区中，对端重置连接时仍会报告 EPOLLERR/EPOLLHUP；
+     * 完成的通知与推送会话共用 wakeupFd，超时由时间轮以 503 结束
+     */
+    void EpollBackend::WaitReply(EventLoop &loop, EpollContext *context) {
+        loop.timers.Schedule(&context->timer, context->connection.ReplyDeadline());
+        context->wantWrite = false;
+        SetInterest(loop, context, 0);
+        const bool watching = context->connection.Reply()->Watch(context, [&loop](HttpApiReply &reply) {
+            {
+                std::lock_guard lock(loop.readyMutex);
+                loop.readyReplies.push_back(reply.shared_from_this());
+            }
+            constexpr uint64_t one = 1;
+            [[maybe_unused]] const ssize_t ignored = write(loop.wakeupFd, &one, sizeof(one));
+        });
+        // 处理函数返回之后、登记之前已经完成
+        if (!watching) {
+            FinishReply(loop, context);
+        }
+    }
+
+    /**
+     * @brief 发送已完成（或已超时）的 API 响应
+     * @param loop 事件循环
+     * @param context 连接上下文
+     */
+    void EpollBackend::FinishReply(EventLoop &loop, EpollContext *context) {
+        loop.timers.Cancel(&context->timer);
+        SetInterest(loop, context, EPOLLIN);
+        Dispatch(loop, context, context->connection.OnReplied(handler));
+    }
+
+    /**
+     * @brief 处理推送连接上的事件
+     * @param loop 事件循环
+     * @param context 连接上下文
+     * @param events epoll 事件
+     * @note 与 HTTP 连接不同，推送连接始终关注 EPOLLIN，只在发送缓冲区已满时额外关注 EPOLLOUT
+     */
+    void EpollBackend::HandleStream(EventLoop &loop, EpollContext *context, const uint32_t events) {
+        if (events & EPOLLOUT && context->wantWrite && !FlushStream(loop, context)) {
+            return;
+        }
+        if (!(events & (EPOLLIN | EPOLLERR | EPOLLHUP))) {
+            return;
+        }
+        const ssize_t count = recv(context->socket, context->recvData, sizeof(context->recvData), 0);
+        if (count < 0) {
+            if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+                CloseContext(loop, context);
+            }
+            return;
+        }
+        if (context->connection.OnReceived(context->recvData, static_cast<size_t>(count), handler) ==
+            HttpAction::Close) {
+            CloseContext(loop, context);
+        }
+    }
+
+    /**
+     * @brief 发送推送会话中排队的数据，直到发送完毕或发送缓冲区已满
+     * @param loop 事件循环
+     * @param context 连接上下文
+     * @return 连接已被关闭时返回 false
+     * @note wantWrite 为 true 时本线程已是会话的发送者，直接继续发送剩余部分
+     */
+    bool EpollBackend::FlushStream(EventLoop &loop, EpollContext *context) {
+        StreamSession *session = context->connection.Stream();
+        if (!context->wantWrite && !session->BeginWrite()) {
+            return true;
+        }
+        while (true) {
+            const std::string_view unsent = session->Unsent();
+            const ssize_t count = send(context->socket, unsent.data(), unsent.size(), MSG_NOSIGNAL);
+            if (count < 0) {
+                if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+                    CloseContext(loop, context);
+                    return false;
+                }
+                if (!context->wantWrite) {
+                    context->wantWrite = true;
+                    SetInterest(loop, context, EPOLLIN | EPOLLOUT);
+                }
+                return true;
+            }
+            if (!session->OnWritten(static_cast<size_t>(count))) {
+                break;
+            }
+        }
+        if (context->wantWrite) {
+            context->wantWrite = false;
+            SetInterest(loop, context, EPOLLIN);
+        }
+        // 最后的数据（回复对端的 Close 帧、积压过多的事件流的结尾）发送完毕之后关闭连接
+        if (session->IsCloseSent()) {
+            CloseContext(loop, context);
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief 发送所有被唤醒的推送会话中排队的数据，以及已完成的 API 响应
+     * @param loop 事件循环
+     * @note 唤醒之后连接可能已经关闭（或 API 响应已经超时），已分离的会话与响应 Owner() 为 nullptr，直接跳过
+     */
+    void EpollBackend::FlushReadySessions(EventLoop &loop) {
+        uint64_t value = 0;
+        [[maybe_unused]] const ssize_t ignored = read(loop.wakeupFd, &value, sizeof(value));
+
+        std::vector<std::shared_ptr<StreamSession>> sessions;
+        std::vector<std::shared_ptr<HttpApiReply>> replies;
+        {
+            std::lock_guard lock(loop.readyMutex);
+            sessions.swap(loop.readySessions);
+            replies.swap(loop.readyReplies);
+        }
+        for (const std::shared_ptr<StreamSession> &session : sessions) {
+            if (auto *context = static_cast<EpollContext *>(session->Owner())) {
+                FlushStream(loop, context);
+            }
+        }
+        for (const std::shared_ptr<HttpApiReply> &reply : replies) {
+            if (auto *context = static_cast<EpollContext *>(reply->Owner())) {
+                FinishReply(loop, context);
+            }
+        }
+    }
+
+    /**
+     * @brief 修改连接关注的 epoll 事件
+     */
+    void EpollBackend::SetInterest(const EventLoop &loop, const EpollContext *context, const uint32_t events) {
+        epoll_event event{};
+        event.events = events;
+        event.data.ptr = const_cast<EpollContext *>(context);
+        epoll_ctl(loop.epollFd, EPOLL_CTL_MOD, context->socket, &event);
+    }
+
+    /**
+     * @brief 暂停或恢复监听套接字的可读事件
+     * @param loop 事件循环
+     * @param paused 是否暂停
+     */
+    void EpollBackend::SetAcceptPaused(EventLoop &loop, const bool paused) {
+        if (loop.acceptPaused == paused || loop.listenSocket < 0) {
+            return;
+        }
+        loop.acceptPaused = paused;
+        if (!paused) {
+            loop.acceptRetryAt = {};
+        }
+        epoll_event event{};
+        event.events = paused ? 0u : static_cast<uint32_t>(EPOLLIN);
+        event.data.ptr = nullptr;
+        epoll_ctl(loop.epollFd, EPOLL_CTL_MOD, loop.listenSocket, &event);
+    }
+
+    /**
+     * @brief accept 因文件描述符耗尽失败时暂停接受连接
+     * @param loop 事件循环
+     * @param error accept 失败时的 errno
+     * @note 监听套接字是水平触发的，不暂停会在 epoll_wait 与 accept 之间空转；
+     * 耗尽可能来自进程中的其他描述符，不一定有连接会关闭，所以同时设置 kAcceptRetryDelay 之后重试
+     */
+    void EpollBackend::PauseAcceptOnShortage(EventLoop &loop, const int error) {
+        if (!IsDescriptorShortage(error) || loop.acceptPaused) {
+            return;
+        }
+        SPDLOG_WARN("接受连接失败: {}，暂停 {} 毫秒", std::strerror(error), kAcceptRetryDelay.count());
+        SetAcceptPaused(loop, true);
+        loop.acceptRetryAt = std::chrono::steady_clock::now() + kAcceptRetryDelay;
+    }
+
+    /**
+     * @brief 关闭套接字，连接上下文在本轮事件处理完毕后归还到池中
+     * @param loop 事件循环
+     * @param context 连接上下文
+     * @note 同一轮事件中可能多次关闭同一个连接（例如唤醒时发送失败，之后又收到 EPOLLHUP），只有第一次生效
+     */
+    void EpollBackend::CloseContext(EventLoop &loop, EpollContext *context) {
+        if (context->closed) {
+            return;
+        }
+        context->closed = true;
+        loop.contexts.erase(context);
+        loop.timers.Cancel(&context->timer);
+        context->connection.Close();
+        if (context->socket >= 0) {
+            close(context->socket);
+            context->socket = -1;
+        }
+        loop.closedContexts.push_back(context);
+    }
+
+    /**
+     * @brief 把本轮关闭的连接上下文归还到池中，并恢复因池耗尽而暂停的接受
+     * @param loop 事件循环
+     */
+    void EpollBackend::ReleaseClosedContexts(EventLoop &loop) {
+        if (loop.closedContexts.empty()) {
+            return;
+        }
+        for (EpollContext *context : loop.closedContexts) {
+            loop.pool.Release(context);
+        }
+        loop.closedContexts.clear();
+        SetAcceptPaused(loop, false);
+    }
+
+    /**
+     * @brief 开始停止事件循环：关闭监听套接字，关闭等待请求的连接
+     * @param loop 事件循环
+     * @note 正在发送响应的连接在发送完毕后关闭；推送连接在结束标记发送完毕后关闭；
+     * 等待 API 结果的连接不再等待，立即以 503 响应之后关闭
+     */
+    void EpollBackend::BeginDrain(EventLoop &loop) {
+        loop.draining = true;
+        loop.drainConnections = loop.contexts.size();
+        // 监听队列中尚未接受的连接随监听套接字的关闭被重置，客户端不会一直等待
+        close(loop.listenSocket);
+        loop.listenSocket = -1;
+
+        std::vector<EpollContext *> waiting;
+        for (EpollContext *context : loop.contexts) {
+            if (context->connection.Stream() == nullptr && !context->wantWrite) {
+                waiting.push_back(context);
+            }
+        }
+        for (EpollContext *context : waiting) {
+            if (context->connection.Reply() != nullptr) {
+                FinishReply(loop, context);
+            } else {
+                CloseContext(loop, context);
+            }
+        }
+    }
+
+    /**
+     * @brief 关闭事件循环中仍然存活的连接以及事件循环自身的描述符
+     * @param loop 事件循环
+     */
+    void EpollBackend::CloseLoop(EventLoop &loop) {
+        while (!loop.contexts.empty()) {
+            CloseContext(loop, *loop.contexts.begin());
+        }
+        ReleaseClosedContexts(loop);
+        for (int *fd : {&loop.listenSocket, &loop.epollFd, &loop.wakeupFd}) {
+            if (*fd >= 0) {
+                close(*fd);
+                *fd = -1;
+            }
+        }
+    }
+
+    /**
+     * @brief 推进时间轮，关闭等待请求数据超时的连接，以 503 结束等待 API 结果超时的连接
+     * @param loop 事件循环
+     * @note 只访问到期的定时器，开销与连接总数无关；超时的 API 响应在推进完毕之后发送，回调中不能重新设置定时器
+     */
+    void EpollBackend::CloseExpiredConnections(EventLoop &loop) {
+        std::vector<EpollContext *> replies;
+        loop.timers.Advance(std::chrono::steady_clock::now(), [&loop, &replies](TimerNode *node) {
+            auto *context = static_cast<EpollContext *>(node->owner);
+            if (context->connection.Reply() != nullptr) {
+                SPDLOG_WARN("API 处理超时");
+                replies.push_back(context);
+                return;
+            }
+            const HttpWaitPhase phase = context->connection.WaitPhase();
+            loop.timeouts[static_cast<size_t>(phase)].fetch_add(1, std::memory_order_relaxed);
+            SPDLOG_DEBUG("连接超时关闭, 阶段: {}", static_cast<int>(phase));
+            CloseContext(loop, context);
+        });
+        for (EpollContext *context : replies) {
+            if (!context->closed) {
+                FinishReply(loop, context);
+            }
+        }
+    }
+
+    void EpollBackend::WorkerThread(EventLoop &loop) {
+        epoll_event events[64];
+        while (true) {
+            // 没有定时器时无需定时唤醒
+            int timeout = loop.timers.Size() == 0 ? -1 : static_cast<int>(kTimerTick.count());
+            if (loop.acceptRetryAt != std::chrono::steady_clock::time_point{}) {
+                const auto retryMs = std::chrono::ceil<std::chrono::milliseconds>(
+                    loop.acceptRetryAt - std::chrono::steady_clock::now()).count();
+                const int retry = static_cast<int>(std::max<long long>(retryMs, 0));
+                timeout = timeout < 0 ? retry : std::min(timeout, retry);
+            }
+            if (draining.load()) {
+                if (!loop.draining) {
+                    BeginDrain(loop);
+                }
+                const auto remaining = drainDeadline - std::chrono::steady_clock::now();
+                if (loop.contexts.empty() || remaining <= std::chrono::steady_clock::duration::zero()) {
+                    break;
+                }
+                // 向上取整，避免在期限之前反复以 0 超时空转
+                const auto remainingMs = std::chrono::ceil<std::chrono::milliseconds>(remaining).count();
+                timeout = timeout < 0 ? static_cast<int>(remainingMs) : std::min<int>(timeout, remainingMs);
+            }
+            const int count = epoll_wait(loop.epollFd, events, 64, timeout);
+            if (count < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                break;
+            }
+
+            for (int i = 0; i < count; i++) {
+                void *ptr = events[i].data.ptr;
+                if (ptr == nullptr) {
+                    AcceptConnections(loop);
+                    continue;
+                }
+                if (ptr == &loop.wakeupFd) {
+                    FlushReadySessions(loop);
+                    continue;
+                }
+
+                auto *context = static_cast<EpollContext *>(ptr);
+                if (context->closed) {
+                    continue;
+                }
+                if (events[i].events & (EPOLLERR | EPOLLHUP) && !(events[i].events & EPOLLIN)) {
+                    CloseContext(loop, context);
+                } else if (context->connection.Stream() != nullptr) {
+                    HandleStream(loop, context, events[i].events);
+                } else if (context->wantWrite) {
+                    HandleWritable(loop, context);
+                } else {
+                    HandleReadable(loop, context);
+                }
+            }
+
+            CloseExpiredConnections(loop);
+            ReleaseClosedContexts(loop);
+            if (loop.acceptRetryAt != std::chrono::steady_clock::time_point{} &&
+                std::chrono::steady_clock::now() >= loop.acceptRetryAt) {
+                loop.acceptRetryAt = {};
+                SetAcceptPaused(loop, false);
+            }
+        }
+    }
+}
+#endif
@@ -0,0 +1,240 @@
+#include "EventStream.h"
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+
+namespace v2_taskbar_manager {
+    namespace {
+        // 缺口超出缓冲区时发送的事件，客户端需要重新获取完整状态
+        constexpr std::string_view kResetRecord = "event: reset\ndata: {}\n\n";
+        // 客户端跟不上时在流的末尾追加的注释，EventSource 会忽略它并自动重连
+        constexpr std::string_view kOverflowRecord = ": overflow\n\n";
+        // 服务器停止时在流的末尾追加的注释
+        constexpr std::string_view kShutdownRecord = ": shutdown\n\n";
+
+        /**
+         * @brief 本进程的纪元
+         * @return uint64_t 第一次调用时的 Unix 时间（微秒），进程内的所有广播中心共用
+         */
+        uint64_t ProcessEpoch() {
+            static const uint64_t epoch = static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::microseconds>(
+                    std::chrono::system_clock::now().time_since_epoch()).count());
+            return epoch;
+        }
+
+        /**
+         * @brief 把一个事件编码为 text/event-stream 格式
+         * @param out 输出缓冲区
+         * @param epoch 进程的纪元
+         * @param id 事件的序号
+         * @param event 事件名，换行符被丢弃
+         * @param data 事件数据，每一行编码为一个 data 字段
+         */
+        void AppendEventRecord(std::string &out, const uint64_t epoch, const uint64_t id, std::string_view event,
+                               std::string_view data) {
+            char digits[41];
+            char *end = std::to_chars(digits, digits + sizeof(digits), epoch).ptr;
+            *end++ = '-';
+            end = std::to_chars(end, digits + sizeof(digits), id).ptr;
+            out += "id: ";
+            out.append(digits, end);
+            out.push_back('\n');
+            if (!event.empty()) {
+                out += "event: ";
+                for (const char c : event) {
+                    if (c != '\r' && c != '\n') {
+                        out.push_back(c);
+                    }
+                }
+                out.push_back('\n');
+            }
+            size_t begin = 0;
+            while (true) {
+                const size_t lineEnd = data.find('\n', begin);
+                std::string_view line = data.substr(begin, lineEnd == std::string_view::npos ? lineEnd : lineEnd - begin);
+                if (!line.empty() && line.back() == '\r') {
+                    line.remove_suffix(1);
+                }
+                out += "data: ";
+                out.append(line.data(), line.size());
+                out.push_back('\n');
+                if (lineEnd == std::string_view::npos) {
+                    break;
+                }
+                begin = lineEnd + 1;
+            }
+            out.push_back('\n');
+        }
+    }
+
+    EventStreamSession::EventStreamSession(EventStreamHub &hub, const std::optional<EventId> lastEventId)
+        : hub(&hub), lastEventId(lastEventId) {
+    }
+
+    /**
+     * @brief 订阅广播中心的事件，并排队 Last-Event-ID 之后缓冲区中的事件
+     * @param owner 后端的连接上下文
+     * @param notify 有数据待发送时的回调
+     */
+    void EventStreamSession::Subscribe(void *owner, Notify notify) {
+        hub->Subscribe(*this, owner, std::move(notify));
+    }
+
+    void EventStreamSession::Unsubscribe() {
+        hub->Remove(this);
+    }
+
+    bool EventStreamSession::HasPendingLocked() const {
+        return !queued.empty();
+    }
+
+    /**
+     * @brief 把排队的事件交给发送者，调用方持有 mutex
+     * @note 事件已是编码后的字节，只需要交换缓冲区
+     */
+    void EventStreamSession::FillLocked() {
+        writing.swap(queued);
+        queued.clear();
+        queuedEvents = 0;
+        if (closing) {
+            closeInWriting = true;
+        }
+    }
+
+    void EventStreamSession::ClearLocked() {
+        queued.clear();
+        queuedEvents = 0;
+    }
+
+    /**
+     * @param capacity 保留的最近事件数，也是单个客户端允许积压的事件数上限
+     * @param maxPendingBytes 单个客户端允许积压的字节数上限
+     */
+    EventStreamHub::EventStreamHub(const size_t capacity, const size_t maxPendingBytes)
+        : ring(std::max<size_t>(capacity, 1)), maxPendingBytes(maxPendingBytes), epoch(ProcessEpoch()) {
+    }
+
+    /**
+     * @brief 发布一个事件
+     * @param event 事件名，为空时客户端以 message 事件接收
+     * @param data 事件数据
+     * @return uint64_t 事件的序号，完整的 ID 还带有 Epoch()
+     * @note 事件只编码一次，之后追加到每个客户端的队列；
+     * 队列中的事件达到缓冲区容量或积压的字节超过 maxPendingBytes 的客户端不再排队新的事件，发送完已排队的事件之后关闭连接
+     */
+    uint64_t EventStreamHub::Publish(std::string_view event, std::string_view data) {
+        std::lock_guard lock(mutex);
+        const uint64_t id = nextId++;
+        // 覆盖最旧的事件，复用其缓冲区的容量
+        std::string &record = ring[(id - 1) % ring.size()];
+        record.clear();
+        AppendEventRecord(record, epoch, id, event, data);
+        events.fetch_add(1, std::memory_order_relaxed);
+
+        for (const std::shared_ptr<EventStreamSession> &session : sessions) {
+            std::lock_guard sessionLock(session->mutex);
+            if (session->closing) {
+                continue;
+            }
+            if (session->queuedEvents >= ring.size() || session->queued.size() + record.size() > maxPendingBytes) {
+                session->queued += kOverflowRecord;
+                session->closing = true;
+                overflows.fetch_add(1, std::memory_order_relaxed);
+            } else {
+                session->queued += record;
+                session->queuedEvents++;
+            }
+            session->NotifyLocked();
+        }
+        return id;
+    }
+
+    /**
+     * @brief 订阅事件
+     * @param session 会话，必须由 shared_ptr 管理
+     * @param owner 后端的连接上下文，通知时可以通过 Owner() 取回
+     * @param notify 有数据待发送时的回调，在会话的锁内调用，只能做轻量的唤醒操作
+     * @note Last-Event-ID 早于缓冲区中最旧的事件，或不是本进程发出的 ID（纪元不同，例如服务重启之前的 ID）时，
+     * 先排队 reset 事件再排队整个缓冲区
+     */
+    void EventStreamHub::Subscribe(EventStreamSession &session, void *owner, StreamSession::Notify notify) {
+        std::lock_guard lock(mutex);
+        std::lock_guard sessionLock(session.mutex);
+        session.owner = owner;
+        session.notify = std::move(notify);
+        if (session.lastEventId) {
+            const uint64_t oldest = OldestIdLocked();
+            uint64_t last = session.lastEventId->sequence;
+            if (session.lastEventId->epoch != epoch || last + 1 < oldest || last >= nextId) {
+                session.queued += kResetRecord;
+                last = oldest - 1;
+            }
+            for (uint64_t id = last + 1; id < nextId; id++) {
+                session.queued += ring[(id - 1) % ring.size()];
+                session.queuedEvents++;
+            }
+        }
+        sessions.push_back(std::static_pointer_cast<EventStreamSession>(session.shared_from_this()));
+        session.NotifyLocked();
+    }
+
+    /**
+     * @brief 结束所有事件流，服务器停止之前调用
+     * @note 已排队的事件与结尾的注释发送完毕后由后端关闭连接
+     */
+    void EventStreamHub::CloseAll() {
+        std::lock_guard lock(mutex);
+        for (const std::shared_ptr<EventStreamSession> &session : sessions) {
+            std::lock_guard sessionLock(session->mutex);
+            if (session->closing) {
+                continue;
+            }
+            session->queued += kShutdownRecord;
+            session->closing = true;
+            session->NotifyLocked();
+        }
+    }
+
+    size_t EventStreamHub::SessionCount() const {
+        std::lock_guard lock(mutex);
+        return sessions.size();
+    }
+
+    uint64_t EventStreamHub::OldestIdLocked() const {
+        return nextId > ring.size() ? nextId - ring.size() : 1;
+    }
+
+    void EventStreamHub::Remove(const EventStreamSession *session) {
+        std::lock_guard lock(mutex);
+        const auto it = std::find_if(sessions.begin(), sessions.end(),
+                                     [session](const auto &item) { return item.get() == session; });
+        if (it != sessions.end()) {
+            sessions.erase(it);
+        }
+    }
+
+    /**
+     * @brief 解析 Last-Event-ID 头部
+     * @param value 头部的值
+     * @return std::optional<EventId> 没有头部时返回空；不是 "<epoch>-<sequence>" 形式时返回纪元为 0 的 ID，
+     * 订阅时与其他进程发出的 ID 一样先收到 reset 事件
+     */
+    std::optional<EventId> ParseLastEventId(std::string_view value) {
+        if (value.empty()) {
+            return std::nullopt;
+        }
+        EventId id;
+        const char *last = value.data() + value.size();
+        const auto [epochEnd, epochError] = std::from_chars(value.data(), last, id.epoch);
+        if (epochError != std::errc() || epochEnd == last || *epochEnd != '-') {
+            return EventId{};
+        }
+        const auto [end, ec] = std::from_chars(epochEnd + 1, last, id.sequence);
+        if (ec != std::errc() || end != last) {
+            return EventId{};
+        }
+        return id;
+    }
+}
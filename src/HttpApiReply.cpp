@@ -0,0 +1,80 @@
+#include "HttpApiReply.h"
+
+namespace v2_taskbar_manager {
+    /**
+     * @brief 完成响应，并在后端已登记时通知后端
+     * @param status HTTP 状态码
+     * @param body JSON 正文
+     * @return 第一次完成时返回 true；已经完成（例如已超时）或连接已关闭时返回 false，结果被丢弃
+     */
+    bool HttpApiReply::Complete(const int status, std::string body) {
+        std::lock_guard lock(mutex);
+        if (completed || detached) {
+            return false;
+        }
+        completed = true;
+        this->status = status;
+        this->body = std::move(body);
+        if (notify) {
+            notify(*this);
+        }
+        return true;
+    }
+
+    bool HttpApiReply::IsCompleted() const {
+        std::lock_guard lock(mutex);
+        return completed;
+    }
+
+    /**
+     * @brief 登记完成时的通知
+     * @param owner 所属对象（后端的连接上下文）
+     * @param notify 完成时调用的通知，调用时持有 mutex，只能投递唤醒，不能回调本对象
+     * @return 已经完成时不登记并返回 false，调用方直接取出结果
+     */
+    bool HttpApiReply::Watch(void *owner, Notify notify) {
+        std::lock_guard lock(mutex);
+        if (completed) {
+            return false;
+        }
+        this->owner = owner;
+        this->notify = std::move(notify);
+        return true;
+    }
+
+    /**
+     * @brief 获取登记时的所属对象
+     * @return void* 已取出结果或已分离时返回 nullptr
+     */
+    void *HttpApiReply::Owner() const {
+        std::lock_guard lock(mutex);
+        return owner;
+    }
+
+    /**
+     * @brief 在 I/O 线程上取出已完成的结果，之后不再通知
+     * @param body [输出] 与 JSON 正文交换，保留调用方缓冲区的容量供下次完成使用
+     * @return int HTTP 状态码，尚未完成时为 0
+     */
+    int HttpApiReply::Take(std::string &body) {
+        std::lock_guard lock(mutex);
+        owner = nullptr;
+        notify = nullptr;
+        detached = true;
+        if (!completed) {
+            return 0;
+        }
+        body.swap(this->body);
+        return status;
+    }
+
+    /**
+     * @brief 连接关闭时调用，返回之后不会再调用通知，处理函数之后的完成被丢弃
+     */
+    void HttpApiReply::Detach() {
+        std::lock_guard lock(mutex);
+        owner = nullptr;
+        notify = nullptr;
+        detached = true;
+    }
+}
@@ -0,0 +1,969 @@
+#include "HttpConnection.h"
+
+#include <charconv>
+#include <cstdint>
+#include <cstdio>
+#include <exception>
+#include <sstream>
+
+#include "spdlog/spdlog.h"
+
+namespace v2_taskbar_manager {
+    namespace {
+        // 连接归还到池中时保留的缓冲区容量上限，超过时释放，避免个别大请求长期占用内存
+        constexpr size_t kMaxRetainedCapacity = 64 * 1024;
+        // 客户端 WebSocket 帧负载的上限，页面只发送控制帧，不需要接收大消息
+        constexpr size_t kMaxWebSocketPayload = 4096;
+        // 事件流响应头之后的第一段数据，指定 EventSource 断开后的重连间隔
+        constexpr std::string_view kEventStreamPreamble = "retry: 3000\n\n";
+
+        /**
+         * @brief 去除首尾的空格与制表符
+         */
+        std::string_view Trim(std::string_view value) {
+            while (!value.empty() && (value.front() == ' ' || value.front() == '\t')) {
+                value.remove_prefix(1);
+            }
+            while (!value.empty() && (value.back() == ' ' || value.back() == '\t')) {
+                value.remove_suffix(1);
+            }
+            return value;
+        }
+
+        /**
+         * @brief 判断 Accept-Encoding 是否接受指定的内容编码
+         * @param acceptEncoding Accept-Encoding 头部的值
+         * @param coding 内容编码名称（不区分大小写）
+         * @return 显式列出时以其权重为准，未列出时以 * 的权重为准，q=0 表示不接受
+         */
+        bool AcceptsEncoding(std::string_view acceptEncoding, std::string_view coding) {
+            int listed = -1;
+            int wildcard = -1;
+            while (!acceptEncoding.empty()) {
+                const size_t itemEnd = acceptEncoding.find(',');
+                const std::string_view item = acceptEncoding.substr(0, itemEnd);
+                acceptEncoding = itemEnd == std::string_view::npos
+                                     ? std::string_view()
+                                     : acceptEncoding.substr(itemEnd + 1);
+
+                const size_t paramsBegin = item.find(';');
+                const std::string_view name = Trim(item.substr(0, paramsBegin));
+
+                // 只有 q 值的数字全部为 0 时才表示拒绝，其余情况一律视为接受
+                bool accepted = true;
+                if (paramsBegin != std::string_view::npos) {
+                    const std::string_view params = Trim(item.substr(paramsBegin + 1));
+                    if (params.size() > 2 && (params[0] == 'q' || params[0] == 'Q') && params[1] == '=') {
+                        accepted = params.find_first_not_of("0.", 2) != std::string_view::npos;
+                    }
+                }
+
+                if (EqualsIgnoreCase(name, coding)) {
+                    listed = accepted ? 1 : 0;
+                } else if (name == "*") {
+                    wildcard = accepted ? 1 : 0;
+                }
+            }
+            return listed != -1 ? listed == 1 : wildcard == 1;
+        }
+
+        /**
+         * @brief 判断以逗号分隔的头部值中是否包含指定的标记
+         * @param list 头部的值，例如 Connection: keep-alive, Upgrade
+         * @param token 标记（不区分大小写）
+         */
+        bool ContainsToken(std::string_view list, std::string_view token) {
+            while (!list.empty()) {
+                const size_t itemEnd = list.find(',');
+                if (EqualsIgnoreCase(Trim(list.substr(0, itemEnd)), token)) {
+                    return true;
+                }
+                list = itemEnd == std::string_view::npos ? std::string_view() : list.substr(itemEnd + 1);
+            }
+            return false;
+        }
+
+        /**
+         * @brief 判断 If-None-Match 是否与资源的实体标签匹配
+         * @param ifNoneMatch If-None-Match 头部的值，可以是以逗号分隔的多个标签或 *
+         * @param etag 带引号的实体标签，可以是弱标签
+         * @note If-None-Match 使用弱比较，忽略双方的 W/ 前缀
+         */
+        bool MatchesETag(std::string_view ifNoneMatch, std::string_view etag) {
+            if (etag.substr(0, 2) == "W/") {
+                etag.remove_prefix(2);
+            }
+            while (!ifNoneMatch.empty()) {
+                const size_t itemEnd = ifNoneMatch.find(',');
+                std::string_view tag = Trim(ifNoneMatch.substr(0, itemEnd));
+                ifNoneMatch = itemEnd == std::string_view::npos ? std::string_view() : ifNoneMatch.substr(itemEnd + 1);
+
+                if (tag == "*") {
+                    return true;
+                }
+                if (tag.substr(0, 2) == "W/") {
+                    tag.remove_prefix(2);
+                }
+                if (tag == etag) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        /**
+         * @brief 获取状态码的原因短语
+         */
+        std::string_view StatusReason(const int status) {
+            switch (status) {
+                case 200:
+                    return "OK";
+                case 204:
+                    return "No Content";
+                case 400:
+                    return "Bad Request";
+                case 403:
+                    return "Forbidden";
+                case 404:
+                    return "Not Found";
+                case 409:
+                    return "Conflict";
+                case 422:
+                    return "Unprocessable Entity";
+                case 503:
+                    return "Service Unavailable";
+                default:
+                    return status < 500 ? "Bad Request" : "Internal Server Error";
+            }
+        }
+
+        /**
+         * @brief 以 FNV-1a 计算内容的 64 位哈希，作为实体标签
+         * @return std::string 16 位十六进制字符串
+         */
+        std::string ContentHash(std::string_view content) {
+            uint64_t hash = 14695981039346656037ull;
+            for (const char c : content) {
+                hash ^= static_cast<unsigned char>(c);
+                hash *= 1099511628211ull;
+            }
+            char hex[17];
+            std::snprintf(hex, sizeof(hex), "%016llx", static_cast<unsigned long long>(hash));
+            return hex;
+        }
+    }
+
+    /**
+     * @param assets 内嵌的静态资源
+     * @param options 服务器配置
+     * @param webSocketHub 推送窗口列表变化的广播中心，为 nullptr 时不接受 WebSocket 连接
+     * @param eventStreamHub 推送原生事件的广播中心，为 nullptr 时不提供事件流
+     * @param apis 返回 JSON 的 API，与其他端点共用路由表
+     */
+    HttpRequestHandler::HttpRequestHandler(std::vector<HttpAsset> assets, const HttpServerOptions &options,
+                                           WebSocketHub *webSocketHub, EventStreamHub *eventStreamHub,
+                                           std::vector<HttpApi> apis)
+        : assets(std::move(assets)), apis(std::move(apis)), webSocketHub(webSocketHub),
+          webSocketPath(options.webSocketPath),
+          eventStreamHub(eventStreamHub), eventStreamPath(options.eventStreamPath) {
+        // 实体标签只依赖内容，内容不变时浏览器缓存的版本在重启之后依然有效
+        std::string cacheControl = "Cache-Control: ";
+        if (options.staticMaxAge.count() > 0) {
+            cacheControl += "max-age=" + std::to_string(options.staticMaxAge.count());
+        } else {
+            cacheControl += "no-cache";
+        }
+        cacheControl += "\r\n";
+
+        if (!options.assetRoot.empty()) {
+            files = std::make_unique<StaticFileCache>(options.assetRoot, cacheControl, options.zeroCopyThreshold);
+        }
+
+        prebuiltAssets.reserve(this->assets.size());
+        for (const HttpAsset &asset : this->assets) {
+            // 存在压缩版本时，同一路径的响应随 Accept-Encoding 变化，需要告知缓存按该头部区分
+            const bool compressed = !asset.gzip.empty() || !asset.brotli.empty();
+            const std::string vary = compressed ? cacheControl + "Vary: Accept-Encoding\r\n" : cacheControl;
+            // 强实体标签必须区分不同编码的表示
+            const std::string hash = ContentHash(asset.identity);
+
+            PrebuiltAsset prebuilt;
+            prebuilt.variants[Identity] = PrebuildVariant(asset, asset.identity, "\"" + hash + "\"", vary);
+            if (!asset.gzip.empty()) {
+                prebuilt.variants[Gzip] = PrebuildVariant(asset, asset.gzip, "\"" + hash + "-gzip\"",
+                                                          "Content-Encoding: gzip\r\n" + vary);
+            }
+            if (!asset.brotli.empty()) {
+                prebuilt.variants[Brotli] = PrebuildVariant(asset, asset.brotli, "\"" + hash + "-br\"",
+                                                            "Content-Encoding: br\r\n" + vary);
+            }
+            prebuiltAssets.push_back(std::move(prebuilt));
+        }
+
+        for (size_t i = 0; i < this->assets.size(); i++) {
+            const HttpEndpoint endpoint{HttpEndpoint::Asset, i};
+            if (!router.Add("GET", this->assets[i].path, endpoint)) {
+                SPDLOG_WARN("无法登记静态资源的路由: {}", this->assets[i].path);
+            } else if (this->assets[i].path == "/index.html") {
+                router.Add("GET", "/", endpoint);
+            }
+        }
+        // 握手不合法的请求也由 Upgrade 响应，因此 WebSocket 端点匹配任意方法；事件流端点的其他方法响应 405
+        if (webSocketHub != nullptr && !webSocketPath.empty() &&
+            !router.Add({}, webSocketPath, HttpEndpoint{HttpEndpoint::WebSocket})) {
+            SPDLOG_WARN("无法登记 WebSocket 端点的路由: {}", webSocketPath);
+        }
+        if (eventStreamHub != nullptr && !eventStreamPath.empty() &&
+            !router.Add("GET", eventStreamPath, HttpEndpoint{HttpEndpoint::EventStream})) {
+            SPDLOG_WARN("无法登记事件流端点的路由: {}", eventStreamPath);
+        }
+        for (size_t i = 0; i < this->apis.size(); i++) {
+            if (!router.Add(this->apis[i].method, this->apis[i].pattern, HttpEndpoint{HttpEndpoint::Api, i})) {
+                SPDLOG_WARN("无法登记 API 的路由: {} {}", this->apis[i].method, this->apis[i].pattern);
+            }
+        }
+
+        notFound = Prebuild("HTTP/1.1 404 Not Found", {}, {});
+        notImplemented = Prebuild("HTTP/1.1 501 Not Implemented", {}, {});
+        badRequest = Prebuild("HTTP/1.1 400 Bad Request", {}, {});
+        headerTooLarge = Prebuild("HTTP/1.1 431 Request Header Fields Too Large", {}, {});
+        bodyTooLarge = Prebuild("HTTP/1.1 413 Payload Too Large", {}, {});
+        forbidden = Prebuild("HTTP/1.1 403 Forbidden", {}, {});
+        upgradeRequired = Prebuild("HTTP/1.1 426 Upgrade Required", {}, {},
+                                   "Upgrade: websocket\r\nSec-WebSocket-Version: 13\r\n");
+        overloaded = Prebuild("HTTP/1.1 503 Service Unavailable", {}, {},
+                              "Retry-After: " + std::to_string(options.overloadRetryAfter.count()) + "\r\n");
+        // 事件流没有 Content-Length，连接在客户端断开或服务端结束流之前一直保持
+        eventStreamHeader = "HTTP/1.1 200 OK\r\nContent-Type: text/event-stream\r\nCache-Control: no-cache\r\n"
+                            "Connection: keep-alive\r\n\r\n";
+    }
+
+    /**
+     * @brief 查找请求对应的端点
+     * @param request 已解析的请求
+     * @return HttpRoute 没有匹配的端点时 target 为 nullptr，路径与查询字符串已拆分
+     */
+    HttpRoute HttpRequestHandler::Route(const HttpRequest &request) const {
+        return router.Match(request.method, request.path);
+    }
+
+    /**
+     * @brief 处理一次 HTTP 请求
+     * @param request 已解析的请求
+     * @param route Route 返回的匹配结果
+     * @param keepAlive 响应之后是否保持连接
+     * @param response [输出] 响应，指向预先构建的只读数据
+     * @return std::shared_ptr<HttpApiReply> 延迟完成的 API 尚未给出结果时返回等待中的响应，此时 response 尚未生成；
+     * 其他情况返回 nullptr
+     * @note 路径已登记但方法不匹配时响应 405 并列出允许的方法；未登记的路径上 GET 以外的方法响应 501
+     */
+    std::shared_ptr<HttpApiReply> HttpRequestHandler::Handle(const HttpRequest &request, const HttpRoute &route,
+                                                             const bool keepAlive, HttpResponse &response) const {
+        SPDLOG_INFO("收到请求: Method[{}], Path[{}], Protocol[{}]", request.method, request.path, request.protocol);
+
+        if (route.target != nullptr && route.target->kind == HttpEndpoint::Api) {
+            return HandleApi(apis[route.target->index], request, route, keepAlive, response);
+        }
+        if (route.target != nullptr && route.target->kind == HttpEndpoint::Asset) {
+            const PrebuiltAsset &asset = prebuiltAssets[route.target->index];
+            const AssetVariant &variant = Negotiate(asset, request.Header("Accept-Encoding"));
+            if (MatchesETag(request.Header("If-None-Match"), variant.etag)) {
+                Use(variant.notModified, keepAlive, response);
+            } else {
+                Use(variant.ok, keepAlive, response);
+            }
+        } else if (route.pathMatched) {
+            UseMethodNotAllowed(route.allow, keepAlive, response);
+        } else if (request.method != "GET") {
+            Use(notImplemented, keepAlive, response);
+        } else if (std::shared_ptr<const StaticFile> file = files ? files->Lookup(route.path) : nullptr) {
+            const bool notModified = MatchesETag(request.Header("If-None-Match"), file->etag);
+            UseFile(std::move(file), notModified, keepAlive, response);
+        } else {
+            Use(notFound, keepAlive, response);
+        }
+        return nullptr;
+    }
+
+    /**
+     * @brief 设置监听端口，后端开始监听之后调用
+     * @param port 实际监听的端口
+     * @note ":端口" 在这里生成一次，先于端口写入；读取方先读取端口，端口不为 0 时后缀已经可见
+     */
+    void HttpRequestHandler::SetListeningPort(const int port) {
+        listeningPortSuffix = ":" + std::to_string(port);
+        listeningPort.store(port, std::memory_order_release);
+    }
+
+    /**
+     * @brief 判断请求是否来自本机，并且来自服务器自身提供的页面
+     * @param request 已解析的请求
+     * @return Host 为 127.0.0.1:端口 或 localhost:端口，且没有 Origin 头部（非浏览器客户端）
+     * 或 Origin 与该 Host 一致时返回 true；尚未监听时拒绝所有请求
+     * @note 先校验 Host 可以防御 DNS 重绑定：其他域名被重新解析到 127.0.0.1 后，页面与 Host 同源，
+     * 只比较 Origin 与 Host 无法区分；WebSocket 握手、事件流与 API 都需要拒绝这类请求
+     */
+    bool HttpRequestHandler::IsSameOrigin(const HttpRequest &request) const {
+        if (listeningPort.load(std::memory_order_acquire) <= 0) {
+            return false;
+        }
+        const std::string_view portSuffix = listeningPortSuffix;
+        const std::string_view host = request.Header("Host");
+        if (host.size() <= portSuffix.size() || host.substr(host.size() - portSuffix.size()) != portSuffix) {
+            return false;
+        }
+        const std::string_view hostName = host.substr(0, host.size() - portSuffix.size());
+        if (hostName != "127.0.0.1" && !EqualsIgnoreCase(hostName, "localhost")) {
+            return false;
+        }
+        const std::string_view origin = request.Header("Origin");
+        return origin.empty() || (origin.substr(0, 7) == "http://" && EqualsIgnoreCase(origin.substr(7), host));
+    }
+
+    /**
+     * @brief 为无法解析的请求生成错误响应
+     * @param result 解析结果，BadRequest 或 TooLarge
+     * @param response [输出] 响应，总是关闭连接
+     */
+    void HttpRequestHandler::HandleParseError(const HttpParseResult result, HttpResponse &response) const {
+        SPDLOG_WARN("无法解析的请求: {}", result == HttpParseResult::TooLarge ? "请求头过大" : "格式错误");
+        Use(result == HttpParseResult::TooLarge ? headerTooLarge : badRequest, false, response);
+    }
+
+    /**
+     * @brief 为超过 maxRequestBodySize 的请求体生成 413 响应
+     * @param response [输出] 响应，总是关闭连接，未读取的请求体随连接一起丢弃
+     */
+    void HttpRequestHandler::HandleBodyTooLarge(HttpResponse &response) const {
+        SPDLOG_WARN("请求体过大");
+        Use(bodyTooLarge, false, response);
+    }
+
+    /**
+     * @brief 调用 API 处理函数并生成 JSON 响应
+     * @param api 路由匹配的 API
+     * @param request 已解析的请求，请求体已接收完整
+     * @param route 路由匹配结果，提供路径参数与查询字符串
+     * @param keepAlive 响应之后是否保持连接
+     * @param response [输出] 响应，头部与正文写入连接复用的缓冲区
+     * @return std::shared_ptr<HttpApiReply> 延迟完成的 API 在处理函数返回时尚未完成则返回等待中的响应，否则返回 nullptr
+     * @note 处理函数抛出的异常不会传播到工作线程，以 500 响应
+     */
+    std::shared_ptr<HttpApiReply> HttpRequestHandler::HandleApi(const HttpApi &api, const HttpRequest &request,
+                                                                const HttpRoute &route, const bool keepAlive,
+                                                                HttpResponse &response) const {
+        if (!IsSameOrigin(request)) {
+            SPDLOG_WARN("拒绝跨源的 API 请求: Host {}, Origin {}", request.Header("Host"), request.Header("Origin"));
+            Use(forbidden, keepAlive, response);
+            return nullptr;
+        }
+
+        response.Clear();
+        response.bodyBuffer.clear();
+        int status;
+        if (api.deferred) {
+            auto reply = std::make_shared<HttpApiReply>();
+            try {
+                api.deferred(HttpApiRequest{request, route.params, route.query}, reply);
+            } catch (const std::exception &e) {
+                SPDLOG_ERROR("API 处理失败: {} {}, {}", request.method, route.path, e.what());
+                reply->Complete(500, {});
+            }
+            // 处理函数当场给出结果（例如参数错误）时直接响应，不进入等待
+            if (!reply->IsCompleted()) {
+                return reply;
+            }
+            status = reply->Take(response.bodyBuffer);
+        } else {
+            try {
+                status = api.handler(HttpApiRequest{request, route.params, route.query}, response.bodyBuffer);
+            } catch (const std::exception &e) {
+                SPDLOG_ERROR("API 处理失败: {} {}, {}", request.method, route.path, e.what());
+                status = 500;
+                response.bodyBuffer.clear();
+            }
+        }
+        FinishApi(status, keepAlive, response);
+        return nullptr;
+    }
+
+    /**
+     * @brief 为已写入 bodyBuffer 的 API 正文生成响应头
+     * @param status HTTP 状态码
+     * @param keepAlive 响应之后是否保持连接
+     * @param response [输出] 响应，头部写入 headerBuffer，正文指向 bodyBuffer
+     */
+    void HttpRequestHandler::FinishApi(const int status, const bool keepAlive, HttpResponse &response) const {
+        std::string &header = response.headerBuffer;
+        header = "HTTP/1.1 ";
+        header += std::to_string(status);
+        header.push_back(' ');
+        header += StatusReason(status);
+        header += "\r\nContent-Type: application/json; charset=utf-8\r\nCache-Control: no-store\r\nContent-Length: ";
+        header += std::to_string(response.bodyBuffer.size());
+        header += keepAlive ? "\r\nConnection: keep-alive\r\n\r\n" : "\r\nConnection: close\r\n\r\n";
+        response.header = header;
+        response.body = response.bodyBuffer;
+    }
+
+    /**
+     * @brief 校验 WebSocket 握手请求并生成 101 响应
+     * @param request 指向 WebSocket 端点的请求
+     * @param response [输出] 握手成功时为 101 响应，否则为关闭连接的错误响应
+     * @return std::shared_ptr<WebSocketSession> 握手成功时返回尚未订阅的会话，否则返回 nullptr
+     * @note Host 必须是本机地址与监听端口，浏览器发起的握手还必须与页面同源（Origin 与 Host 一致），
+     * 避免其他网页（包括 DNS 重绑定后的网页）读取本机的窗口列表
+     */
+    std::shared_ptr<WebSocketSession> HttpRequestHandler::Upgrade(const HttpRequest &request,
+                                                                  HttpResponse &response) const {
+        const std::string_view key = request.Header("Sec-WebSocket-Key");
+        if (request.method != "GET" || request.protocol != "HTTP/1.1" ||
+            !EqualsIgnoreCase(request.Header("Upgrade"), "websocket") ||
+            !ContainsToken(request.Header("Connection"), "upgrade") || key.size() != 24) {
+            SPDLOG_WARN("无效的 WebSocket 握手: {}", request.path);
+            Use(upgradeRequired, false, response);
+            return nullptr;
+        }
+        if (request.Header("Sec-WebSocket-Version") != "13") {
+            Use(upgradeRequired, false, response);
+            return nullptr;
+        }
+        if (!IsSameOrigin(request)) {
+            SPDLOG_WARN("拒绝跨源的 WebSocket 握手: Host {}, Origin {}", request.Header("Host"),
+                        request.Header("Origin"));
+            Use(forbidden, false, response);
+            return nullptr;
+        }
+
+        response.Clear();
+        response.headerBuffer = "HTTP/1.1 101 Switching Protocols\r\nUpgrade: websocket\r\nConnection: Upgrade\r\n"
+                                "Sec-WebSocket-Accept: ";
+        response.headerBuffer += WebSocketAcceptKey(key);
+        response.headerBuffer += "\r\n\r\n";
+        response.header = response.headerBuffer;
+        SPDLOG_INFO("WebSocket 握手: {}", request.path);
+        return std::make_shared<WebSocketSession>(*webSocketHub);
+    }
+
+    /**
+     * @brief 生成事件流的响应头并创建会话
+     * @param request 指向事件流端点的 GET 请求
+     * @param response [输出] 不带 Content-Length 的 200 响应，正文为重连间隔；请求不是来自本机页面时为 403
+     * @return std::shared_ptr<EventStreamSession> 尚未订阅的会话，拒绝时返回 nullptr
+     * @note 与 WebSocket 握手相同地校验 Host 与 Origin；不输出 Access-Control-Allow-Origin，其他源的页面无法读取事件流；
+     * 浏览器重连时携带的 Last-Event-ID 决定从缓冲区中补发哪些事件
+     */
+    std::shared_ptr<EventStreamSession> HttpRequestHandler::OpenEventStream(const HttpRequest &request,
+                                                                            HttpResponse &response) const {
+        if (!IsSameOrigin(request)) {
+            SPDLOG_WARN("拒绝跨源的事件流订阅: Host {}, Origin {}", request.Header("Host"), request.Header("Origin"));
+            Use(forbidden, false, response);
+            return nullptr;
+        }
+        response.Clear();
+        response.header = eventStreamHeader;
+        response.body = kEventStreamPreamble;
+        SPDLOG_INFO("事件流订阅: {}", request.path);
+        return std::make_shared<EventStreamSession>(*eventStreamHub,
+                                                    ParseLastEventId(request.Header("Last-Event-ID")));
+    }
+
+    /**
+     * @brief 根据 Accept-Encoding 选择客户端可接受的最小版本
+     * @param asset 静态资源
+     * @param acceptEncoding Accept-Encoding 头部的值，为空时只使用原始内容
+     * @return const AssetVariant& 选中的版本
+     */
+    const HttpRequestHandler::AssetVariant &HttpRequestHandler::Negotiate(const PrebuiltAsset &asset,
+                                                                          std::string_view acceptEncoding) {
+        constexpr std::string_view codings[EncodingCount] = {"identity", "gzip", "br"};
+
+        const AssetVariant *selected = &asset.variants[Identity];
+        if (acceptEncoding.empty()) {
+            return *selected;
+        }
+        for (int encoding = Gzip; encoding < EncodingCount; encoding++) {
+            const AssetVariant &variant = asset.variants[encoding];
+            if (!variant.etag.empty() && variant.ok.body.size() < selected->ok.body.size() &&
+                AcceptsEncoding(acceptEncoding, codings[encoding])) {
+                selected = &variant;
+            }
+        }
+        return *selected;
+    }
+
+    /**
+     * @brief 预先构建静态资源某个编码版本的 200 与 304 响应
+     * @param asset 静态资源
+     * @param body 该编码版本的正文
+     * @param etag 该编码版本带引号的实体标签
+     * @param headers 额外的头部行（Content-Encoding、Cache-Control、Vary），每行以 CRLF 结尾
+     */
+    HttpRequestHandler::AssetVariant HttpRequestHandler::PrebuildVariant(const HttpAsset &asset,
+                                                                         std::string_view body, std::string etag,
+                                                                         std::string_view headers) {
+        const std::string validators = "ETag: " + etag + "\r\n" + std::string(headers);
+
+        AssetVariant variant;
+        variant.ok = Prebuild("HTTP/1.1 200 OK", asset.contentType, body, validators);
+        variant.notModified = PrebuildNotModified(validators);
+        variant.etag = std::move(etag);
+        return variant;
+    }
+
+    /**
+     * @brief 预先构建一个固定响应的头部
+     * @param statusLine 状态行
+     * @param contentType 正文类型，为空时不输出 Content-Type
+     * @param body 正文，必须在处理器的生命周期内有效
+     * @param extraHeaders 额外的头部行，每行以 CRLF 结尾
+     * @return PrebuiltResponse 保持连接与关闭连接两种头部以及正文
+     */
+    HttpRequestHandler::PrebuiltResponse HttpRequestHandler::Prebuild(std::string_view statusLine,
+                                                                      std::string_view contentType,
+                                                                      std::string_view body,
+                                                                      std::string_view extraHeaders) {
+        std::ostringstream stream;
+        stream << statusLine << "\r\n";
+        if (!contentType.empty()) {
+            stream << "Content-Type: " << contentType << "\r\n";
+        }
+        stream << "Content-Length: " << body.size() << "\r\n";
+        stream << extraHeaders;
+        const std::string common = stream.str();
+
+        PrebuiltResponse prebuilt;
+        prebuilt.keepAliveHeader = common + "Connection: keep-alive\r\n\r\n";
+        prebuilt.closeHeader = common + "Connection: close\r\n\r\n";
+        prebuilt.body = body;
+        return prebuilt;
+    }
+
+    /**
+     * @brief 预先构建 304 响应的头部
+     * @param headers 与 200 响应相同的 ETag、Cache-Control、Vary 等头部行
+     * @note 304 响应没有正文，也不输出 Content-Length，避免被误认为表示的长度为 0
+     */
+    HttpRequestHandler::PrebuiltResponse HttpRequestHandler::PrebuildNotModified(std::string_view headers) {
+        const std::string common = "HTTP/1.1 304 Not Modified\r\n" + std::string(headers);
+
+        PrebuiltResponse prebuilt;
+        prebuilt.keepAliveHeader = common + "Connection: keep-alive\r\n\r\n";
+        prebuilt.closeHeader = common + "Connection: close\r\n\r\n";
+        return prebuilt;
+    }
+
+    /**
+     * @brief 让响应指向预先构建的头部与正文
+     */
+    void HttpRequestHandler::Use(const PrebuiltResponse &prebuilt, const bool keepAlive, HttpResponse &response) {
+        response.Clear();
+        response.header = keepAlive ? prebuilt.keepAliveHeader : prebuilt.closeHeader;
+        response.body = prebuilt.body;
+    }
+
+    /**
+     * @brief 生成 405 响应
+     * @param allow 路径上登记的方法，作为 Allow 头部
+     * @param keepAlive 响应之后是否保持连接
+     * @param response [输出] 响应，头部写入 headerBuffer
+     * @note Allow 随路径变化，不预先构建；只在方法错误时生成，不在常规请求的路径上
+     */
+    void HttpRequestHandler::UseMethodNotAllowed(std::string_view allow, const bool keepAlive,
+                                                 HttpResponse &response) {
+        response.Clear();
+        std::string &header = response.headerBuffer;
+        header = "HTTP/1.1 405 Method Not Allowed\r\nAllow: ";
+        header.append(allow.data(), allow.size());
+        header += keepAlive ? "\r\nContent-Length: 0\r\nConnection: keep-alive\r\n\r\n"
+                            : "\r\nContent-Length: 0\r\nConnection: close\r\n\r\n";
+        response.header = header;
+    }
+
+    /**
+     * @brief 让响应指向资源目录中的文件
+     * @param file 文件，由响应持有直到发送完毕
+     * @param notModified 是否响应 304
+     * @param keepAlive 响应之后是否保持连接
+     * @param response [输出] 响应，已映射的文件正文指向映射视图，未映射的文件由后端零拷贝发送
+     */
+    void HttpRequestHandler::UseFile(std::shared_ptr<const StaticFile> file, const bool notModified,
+                                     const bool keepAlive, HttpResponse &response) {
+        response.Clear();
+        if (notModified) {
+            response.header = keepAlive ? file->notModifiedKeepAliveHeader : file->notModifiedCloseHeader;
+        } else {
+            response.header = keepAlive ? file->keepAliveHeader : file->closeHeader;
+            response.body = file->Content();
+            response.fileLength = file->IsMapped() ? 0 : file->size;
+        }
+        response.file = std::move(file);
+    }
+
+    HttpConnection::HttpConnection(const HttpServerOptions &options)
+        : options(&options), parser(options.maxRequestHeaderSize) {
+        Reset();
+    }
+
+    /**
+     * @brief 重置连接状态，以便复用于新的连接
+     * @note 缓冲区保留已有容量，只有超过 kMaxRetainedCapacity 时才释放
+     */
+    void HttpConnection::Reset() {
+        Close();
+        for (std::string *buffer : {&requestData, &response.headerBuffer, &response.bodyBuffer}) {
+            if (buffer->capacity() > kMaxRetainedCapacity) {
+                std::string().swap(*buffer);
+            } else {
+                buffer->clear();
+            }
+        }
+        parser.Reset();
+        requestBegin = 0;
+        response.Clear();
+        sendCount = 0;
+        requestCount = 0;
+        keepAlive = false;
+        acceptedAt = std::chrono::steady_clock::now();
+        requestStartedAt = acceptedAt;
+        lastActivity = acceptedAt;
+    }
+
+    /**
+     * @brief 处理接收到的数据
+     * @param data 接收到的数据
+     * @param length 数据长度，为 0 表示对端已关闭连接
+     * @param handler 请求处理器
+     * @return HttpAction 后端需要执行的下一个动作
+     */
+    HttpAction HttpConnection::OnReceived(const char *data, size_t length, const HttpRequestHandler &handler) {
+        if (upgraded) {
+            // 事件流是单向的，客户端发送的任何数据都被忽略，只用接收来发现连接关闭
+            if (webSocket == nullptr) {
+                return length == 0 ? HttpAction::Close : HttpAction::Receive;
+            }
+            return OnWebSocketReceived(data, length);
+        }
+        if (length == 0) {
+            return HttpAction::Close;
+        }
+        lastActivity = std::chrono::steady_clock::now();
+
+        // 没有缓存的数据时直接在接收缓冲区上解析，一次接收到完整请求是最常见的情况，不需要任何拷贝
+        if (requestBegin == requestData.size()) {
+            requestStartedAt = lastActivity;
+            requestData.clear();
+            requestBegin = 0;
+            size_t consumed = 0;
+            const HttpAction action = ProcessRequest(std::string_view(data, length), handler, consumed);
+            // 未完整的请求，或完整请求之后的管线化数据，缓存起来等待继续解析
+            requestData.append(data + consumed, length - consumed);
+            return action;
+        }
+
+        // 丢弃已处理的部分，解析器记录的是相对于请求开头的偏移，不受影响
+        if (requestBegin > 0) {
+            requestData.erase(0, requestBegin);
+            requestBegin = 0;
+        }
+        requestData.append(data, length);
+        return ProcessNextRequest(handler);
+    }
+
+    /**
+     * @brief 处理发送完成的数据
+     * @param bytes 本次发送的字节数
+     * @param handler 请求处理器，用于处理已缓存的管线化请求
+     * @return HttpAction 还有剩余数据时继续发送；响应发送完毕后，持久连接继续处理下一个请求，否则关闭连接
+     */
+    HttpAction HttpConnection::OnSent(size_t bytes, const HttpRequestHandler &handler) {
+        lastActivity = std::chrono::steady_clock::now();
+        sendCount += bytes;
+        if (sendCount < response.Size()) {
+            return HttpAction::Send;
+        }
+        if (stream && keepAlive) {
+            upgraded = true;
+            response.Clear();
+            sendCount = 0;
+            return HttpAction::Upgrade;
+        }
+        if (!keepAlive) {
+            return HttpAction::Close;
+        }
+        response.Clear();
+        sendCount = 0;
+        // 已缓存的管线化数据从现在开始计算请求头超时
+        requestStartedAt = lastActivity;
+        return ProcessNextRequest(handler);
+    }
+
+    /**
+     * @brief 取出已完成的 API 结果并生成响应
+     * @param handler 请求处理器
+     * @return HttpAction 发送响应
+     * @note 在 Reply() 完成的通知之后、或 Watch 发现已经完成时，由后端在 I/O 线程上调用；
+     * 后端在超时与停止时以 apiTimeoutBody 完成等待中的响应，因此这里总能取到结果
+     */
+    HttpAction HttpConnection::OnReplied(const HttpRequestHandler &handler) {
+        int status = reply->Take(response.bodyBuffer);
+        reply.reset();
+        if (status == 0) {
+            status = 503;
+            response.bodyBuffer = options->apiTimeoutBody;
+        }
+        handler.FinishApi(status, keepAlive, response);
+        return HttpAction::Send;
+    }
+
+    /**
+     * @brief 释放连接持有的推送会话与等待中的 API 响应，连接关闭时由后端调用
+     * @note 会话从广播中心移除之后不会再通知后端
+     */
+    void HttpConnection::Close() {
+        if (reply) {
+            reply->Detach();
+            reply.reset();
+        }
+        if (stream) {
+            stream->Detach();
+            stream.reset();
+        }
+        webSocket = nullptr;
+        upgraded = false;
+    }
+
+    /**
+     * @brief 处理 WebSocket 连接上接收到的数据
+     * @param data 接收到的数据
+     * @param length 数据长度，为 0 表示对端已关闭连接
+     * @return HttpAction 继续接收，协议错误或对端关闭时关闭连接
+     * @note 页面不通过 WebSocket 发送消息，数据帧被忽略；Ping 回复 Pong，Close 回复相同状态码的 Close，
+     * 回复由会话的发送队列发出
+     */
+    HttpAction HttpConnection::OnWebSocketReceived(const char *data, const size_t length) {
+        if (length == 0) {
+            return HttpAction::Close;
+        }
+        lastActivity = std::chrono::steady_clock::now();
+
+        // 握手之后立即到达的帧可能已经缓存在 requestData 中
+        if (requestBegin > 0) {
+            requestData.erase(0, requestBegin);
+            requestBegin = 0;
+        }
+        requestData.append(data, length);
+
+        size_t offset = 0;
+        while (offset < requestData.size()) {
+            WebSocketFrame frame;
+            size_t consumed = 0;
+            const WebSocketParseResult result = ParseWebSocketFrame(
+                requestData.data() + offset, requestData.size() - offset, kMaxWebSocketPayload, frame, consumed);
+            if (result == WebSocketParseResult::Incomplete) {
+                break;
+            }
+            if (result != WebSocketParseResult::Complete) {
+                SPDLOG_WARN("WebSocket 帧错误: {}", result == WebSocketParseResult::TooLarge ? "负载过大" : "协议错误");
+                return HttpAction::Close;
+            }
+            offset += consumed;
+
+            bool queued = true;
+            if (frame.opcode == WebSocketOpcode::Ping) {
+                queued = webSocket->SendControl(WebSocketOpcode::Pong, frame.payload);
+            } else if (frame.opcode == WebSocketOpcode::Close) {
+                queued = webSocket->SendControl(WebSocketOpcode::Close, frame.payload.substr(0, 2));
+            }
+            if (!queued) {
+                SPDLOG_WARN("WebSocket 客户端积压的控制帧过多");
+                return HttpAction::Close;
+            }
+        }
+        requestData.erase(0, offset);
+        return HttpAction::Receive;
+    }
+
+    /**
+     * @brief 获取尚未发送的数据分段
+     * @param buffers [输出] 尚未发送的头部剩余部分与正文剩余部分
+     * @return size_t 非空分段的数量
+     */
+    size_t HttpConnection::PendingBuffers(std::string_view (&buffers)[2]) const {
+        size_t count = 0;
+        if (sendCount < response.header.size()) {
+            buffers[count++] = response.header.substr(sendCount);
+        }
+        const size_t bodySent = sendCount > response.header.size() ? sendCount - response.header.size() : 0;
+        if (bodySent < response.body.size()) {
+            buffers[count++] = response.body.substr(bodySent);
+        }
+        return count;
+    }
+
+    /**
+     * @brief 获取尚未发送的文件正文
+     * @param offset [输出] 文件中尚未发送部分的起始偏移
+     * @param length [输出] 尚未发送的长度
+     * @return const StaticFile* 响应没有需要零拷贝发送的文件正文时返回 nullptr
+     * @note 文件正文位于头部之后，IOCP 后端可以把头部剩余部分与文件一起交给 TransmitFile
+     */
+    const StaticFile *HttpConnection::PendingFile(uint64_t &offset, size_t &length) const {
+        const size_t buffered = response.header.size() + response.body.size();
+        const uint64_t fileSent = sendCount > buffered ? sendCount - buffered : 0;
+        if (fileSent >= response.fileLength) {
+            return nullptr;
+        }
+        offset = fileSent;
+        length = static_cast<size_t>(response.fileLength - fileSent);
+        return response.file.get();
+    }
+
+    /**
+     * @brief 获取连接等待请求数据时所处的阶段
+     * @return HttpWaitPhase 已缓存了部分请求时为 Header，否则第一个请求之前为 FirstByte，之后为 Idle
+     */
+    HttpWaitPhase HttpConnection::WaitPhase() const {
+        if (requestBegin < requestData.size()) {
+            return HttpWaitPhase::Header;
+        }
+        return requestCount == 0 ? HttpWaitPhase::FirstByte : HttpWaitPhase::Idle;
+    }
+
+    /**
+     * @brief 获取本次等待请求数据的截止时间
+     * @return std::chrono::steady_clock::time_point 按所处阶段分别从连接建立、请求开始、上一个响应发送完毕时起算
+     * @note 后端在每次投递接收操作时用它设置定时器，发送响应期间不计时
+     */
+    std::chrono::steady_clock::time_point HttpConnection::ReceiveDeadline() const {
+        switch (WaitPhase()) {
+            case HttpWaitPhase::FirstByte:
+                return acceptedAt + options->firstByteTimeout;
+            case HttpWaitPhase::Header:
+                return requestStartedAt + options->headerTimeout;
+            case HttpWaitPhase::Idle:
+                break;
+        }
+        return lastActivity + options->idleTimeout;
+    }
+
+    /**
+     * @brief 从已缓存的数据中取出下一个完整的请求并生成响应
+     * @param handler 请求处理器
+     * @return HttpAction 请求头未完整时继续接收，否则发送响应
+     */
+    HttpAction HttpConnection::ProcessNextRequest(const HttpRequestHandler &handler) {
+        size_t consumed = 0;
+        const HttpAction action = ProcessRequest(std::string_view(requestData).substr(requestBegin), handler,
+                                                 consumed);
+        requestBegin += consumed;
+        if (requestBegin == requestData.size()) {
+            requestData.clear();
+            requestBegin = 0;
+        }
+        return action;
+    }
+
+    /**
+     * @brief 解析缓冲区开头的请求并生成响应
+     * @param buffer 从请求的第一个字节开始的数据，未完整时下次传入的数据必须是它的延续
+     * @param handler 请求处理器
+     * @param consumed [输出] 已处理的字节数，请求未完整时为 0
+     * @return HttpAction 请求头未完整时继续接收，否则发送响应
+     */
+    HttpAction HttpConnection::ProcessRequest(std::string_view buffer, const HttpRequestHandler &handler,
+                                              size_t &consumed) {
+        const HttpParseResult result = parser.Parse(buffer);
+        if (result == HttpParseResult::Incomplete) {
+            consumed = 0;
+            return HttpAction::Receive;
+        }
+        sendCount = 0;
+
+        // 无法解析的请求无法确定下一个请求的边界，响应错误之后关闭连接
+        if (result != HttpParseResult::Complete) {
+            keepAlive = false;
+            handler.HandleParseError(result, response);
+            consumed = buffer.size();
+            parser.Reset();
+            return HttpAction::Send;
+        }
+
+        // 请求体跟在请求头之后，接收完整之前不处理请求；未完整时下次从头重新解析，
+        // 缓冲区扩容之后请求中的字段需要指向新的地址
+        HttpRequest request = parser.Request();
+        size_t bodyLength = 0;
+        if (const std::string_view contentLength = request.Header("Content-Length"); !contentLength.empty()) {
+            const auto [end, ec] = std::from_chars(contentLength.data(), contentLength.data() + contentLength.size(),
+                                                   bodyLength);
+            if (ec != std::errc() || end != contentLength.data() + contentLength.size()) {
+                keepAlive = false;
+                handler.HandleParseError(HttpParseResult::BadRequest, response);
+                consumed = buffer.size();
+                parser.Reset();
+                return HttpAction::Send;
+            }
+            if (bodyLength > options->maxRequestBodySize) {
+                keepAlive = false;
+                handler.HandleBodyTooLarge(response);
+                consumed = buffer.size();
+                parser.Reset();
+                return HttpAction::Send;
+            }
+            if (buffer.size() - parser.Consumed() < bodyLength) {
+                consumed = 0;
+                parser.Reset();
+                return HttpAction::Receive;
+            }
+            request.body = buffer.substr(parser.Consumed(), bodyLength);
+        }
+
+        // HTTP/1.1 默认保持连接，HTTP/1.0 需要显式声明 keep-alive
+        const std::string_view connection = request.Header("Connection");
+        if (request.protocol == "HTTP/1.1") {
+            keepAlive = !ContainsToken(connection, "close");
+        } else {
+            keepAlive = ContainsToken(connection, "keep-alive");
+        }
+
+        // 不读取分块传输的请求体，处理完之后关闭连接，避免把请求体当作下一个请求解析
+        if (!request.Header("Transfer-Encoding").empty()) {
+            keepAlive = false;
+        }
+
+        requestCount++;
+        if (requestCount >= options->maxRequestsPerConnection) {
+            keepAlive = false;
+        }
+
+        const HttpRoute route = handler.Route(request);
+        const HttpEndpoint::Kind kind = route.target != nullptr ? route.target->kind : HttpEndpoint::Asset;
+
+        // 握手成功时 keepAlive 表示发送完 101 响应之后切换协议，失败时响应错误并关闭连接
+        if (kind == HttpEndpoint::WebSocket) {
+            std::shared_ptr<WebSocketSession> session = handler.Upgrade(request, response);
+            webSocket = session.get();
+            stream = std::move(session);
+            keepAlive = stream != nullptr;
+            consumed = parser.Consumed() + bodyLength;
+            parser.Reset();
+            return HttpAction::Send;
+        }
+
+        // 事件流的响应头发送完毕之后连接只用于推送，请求之后的数据不再作为请求解析
+        if (kind == HttpEndpoint::EventStream) {
+            stream = handler.OpenEventStream(request, response);
+            keepAlive = stream != nullptr;
+            consumed = parser.Consumed() + bodyLength;
+            parser.Reset();
+            return HttpAction::Send;
+        }
+
+        reply = handler.Handle(request, route, keepAlive, response);
+
+        // 剩余数据是下一个管线化请求的开始，等待 API 结果期间留在缓存中
+        consumed = parser.Consumed() + bodyLength;
+        parser.Reset();
+        return reply ? HttpAction::Wait : HttpAction::Send;
+    }
+}
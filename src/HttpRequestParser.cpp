@@ -0,0 +1,256 @@
+#include "HttpRequestParser.h"
+
+#include <cstring>
+
+namespace v2_taskbar_manager {
+    namespace {
+        /**
+         * @brief 构建 RFC 9110 中 token 字符的查找表
+         */
+        struct TokenTable {
+            bool chars[256]{};
+
+            constexpr TokenTable() {
+                for (int c = '0'; c <= '9'; c++) {
+                    chars[c] = true;
+                }
+                for (int c = 'a'; c <= 'z'; c++) {
+                    chars[c] = true;
+                    chars[c - 'a' + 'A'] = true;
+                }
+                for (const char c : std::string_view("!#$%&'*+-.^_`|~")) {
+                    chars[static_cast<unsigned char>(c)] = true;
+                }
+            }
+        };
+
+        constexpr TokenTable kTokenTable;
+
+        bool IsTokenChar(const char c) {
+            return kTokenTable.chars[static_cast<unsigned char>(c)];
+        }
+
+        /**
+         * @brief 判断是否为控制字符（不含制表符），请求目标中不允许出现
+         */
+        bool IsControlChar(const char c) {
+            const auto u = static_cast<unsigned char>(c);
+            return (u < 0x20 && u != '\t') || u == 0x7f;
+        }
+    }
+
+    /**
+     * @brief 不区分大小写地比较两个字符串
+     */
+    bool EqualsIgnoreCase(std::string_view a, std::string_view b) {
+        if (a.size() != b.size()) {
+            return false;
+        }
+        for (size_t i = 0; i < a.size(); i++) {
+            const char x = a[i] >= 'A' && a[i] <= 'Z' ? static_cast<char>(a[i] - 'A' + 'a') : a[i];
+            const char y = b[i] >= 'A' && b[i] <= 'Z' ? static_cast<char>(b[i] - 'A' + 'a') : b[i];
+            if (x != y) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief 查找指定头部的值
+     * @param name 头部名称（不区分大小写）
+     * @return std::string_view 去除首尾空白的头部值，不存在时为空
+     */
+    std::string_view HttpRequest::Header(std::string_view name) const {
+        for (size_t i = 0; i < headerCount; i++) {
+            if (EqualsIgnoreCase(headers[i].name, name)) {
+                return headers[i].value;
+            }
+        }
+        return {};
+    }
+
+    /**
+     * @param maxHeaderSize 请求行与全部头部（含结尾空行）的最大字节数
+     */
+    HttpRequestParser::HttpRequestParser(const size_t maxHeaderSize) : maxHeaderSize(maxHeaderSize) {
+    }
+
+    /**
+     * @brief 重置解析状态，以便解析下一个请求
+     */
+    void HttpRequestParser::Reset() {
+        state = State::Method;
+        position = 0;
+        tokenBegin = 0;
+        headerCount = 0;
+        request = {};
+    }
+
+    /**
+     * @brief 解析请求头
+     * @param buffer 从请求的第一个字节开始的缓冲区，每次调用传入的内容都必须是上一次的延续
+     * @return HttpParseResult 解析结果，Incomplete 时再次调用会从上次停止的位置继续
+     * @note 请求体不由解析器处理，Complete 之后 Consumed() 返回请求头（含结尾空行）的长度
+     */
+    HttpParseResult HttpRequestParser::Parse(std::string_view buffer) {
+        if (state == State::Done) {
+            return Complete(buffer);
+        }
+
+        // 超过限制的部分不扫描，避免为超大请求头做无用功
+        const size_t limit = buffer.size() < maxHeaderSize ? buffer.size() : maxHeaderSize;
+        const char *data = buffer.data();
+        // 扫描位置放在局部变量中：通过 char 指针读取的数据可能与成员别名，使用成员会迫使编译器在每个字节后写回内存
+        size_t pos = position;
+        // 每个状态都在内层循环中一次扫描完整个字段，只在字段边界上切换状态，数据不足时停在原处等待下次继续
+        while (pos < limit) {
+            switch (state) {
+                case State::Method:
+                    while (pos < limit && IsTokenChar(data[pos])) {
+                        pos++;
+                    }
+                    if (pos == limit) {
+                        continue;
+                    }
+                    if (data[pos] != ' ' || pos == 0) {
+                        return HttpParseResult::BadRequest;
+                    }
+                    method = {0, static_cast<uint32_t>(pos)};
+                    tokenBegin = pos + 1;
+                    state = State::Path;
+                    break;
+                case State::Path:
+                    while (pos < limit && data[pos] != ' ' && !IsControlChar(data[pos]) &&
+                           data[pos] != '\t') {
+                        pos++;
+                    }
+                    if (pos == limit) {
+                        continue;
+                    }
+                    if (data[pos] != ' ' || pos == tokenBegin) {
+                        return HttpParseResult::BadRequest;
+                    }
+                    path = {static_cast<uint32_t>(tokenBegin), static_cast<uint32_t>(pos)};
+                    tokenBegin = pos + 1;
+                    state = State::Protocol;
+                    break;
+                case State::Protocol: {
+                    while (pos < limit && data[pos] != '\r' && data[pos] != '\n') {
+                        pos++;
+                    }
+                    if (pos == limit) {
+                        continue;
+                    }
+                    const std::string_view version(data + tokenBegin, pos - tokenBegin);
+                    if (version.size() != 8 || version.substr(0, 5) != "HTTP/") {
+                        return HttpParseResult::BadRequest;
+                    }
+                    protocol = {static_cast<uint32_t>(tokenBegin), static_cast<uint32_t>(pos)};
+                    state = data[pos] == '\r' ? State::RequestLineEnd : State::HeaderStart;
+                    break;
+                }
+                case State::RequestLineEnd:
+                    if (data[pos] != '\n') {
+                        return HttpParseResult::BadRequest;
+                    }
+                    state = State::HeaderStart;
+                    break;
+                case State::HeaderStart:
+                    if (data[pos] == '\r') {
+                        state = State::HeadersEnd;
+                        break;
+                    }
+                    if (data[pos] == '\n') {
+                        position = pos + 1;
+                        state = State::Done;
+                        return Complete(buffer);
+                    }
+                    // 以空白开头的续行（obs-fold）已被废弃，不在此处接受
+                    if (!IsTokenChar(data[pos])) {
+                        return HttpParseResult::BadRequest;
+                    }
+                    if (headerCount == kMaxHeaderCount) {
+                        return HttpParseResult::TooLarge;
+                    }
+                    tokenBegin = pos;
+                    state = State::HeaderName;
+                    [[fallthrough]];
+                case State::HeaderName:
+                    while (pos < limit && IsTokenChar(data[pos])) {
+                        pos++;
+                    }
+                    if (pos == limit) {
+                        continue;
+                    }
+                    if (data[pos] != ':') {
+                        return HttpParseResult::BadRequest;
+                    }
+                    headerRanges[headerCount].name = {
+                        static_cast<uint32_t>(tokenBegin), static_cast<uint32_t>(pos)
+                    };
+                    state = State::HeaderValueStart;
+                    break;
+                case State::HeaderValueStart:
+                    if (data[pos] == ' ' || data[pos] == '\t') {
+                        break;
+                    }
+                    tokenBegin = pos;
+                    state = State::HeaderValue;
+                    [[fallthrough]];
+                case State::HeaderValue: {
+                    // 头部值通常是一行中最长的部分，用 memchr 直接定位行尾；值只用于查找，不校验其中的字符
+                    const auto lineFeed = static_cast<const char *>(
+                        std::memchr(data + pos, '\n', limit - pos));
+                    if (lineFeed == nullptr) {
+                        pos = limit;
+                        continue;
+                    }
+                    pos = lineFeed - data;
+                    size_t valueEnd = pos;
+                    while (valueEnd > tokenBegin && (data[valueEnd - 1] == '\r' || data[valueEnd - 1] == ' ' ||
+                                                     data[valueEnd - 1] == '\t')) {
+                        valueEnd--;
+                    }
+                    headerRanges[headerCount].value = {
+                        static_cast<uint32_t>(tokenBegin), static_cast<uint32_t>(valueEnd)
+                    };
+                    headerCount++;
+                    state = State::HeaderStart;
+                    break;
+                }
+                case State::HeadersEnd:
+                    if (data[pos] != '\n') {
+                        return HttpParseResult::BadRequest;
+                    }
+                    position = pos + 1;
+                    state = State::Done;
+                    return Complete(buffer);
+                case State::Done:
+                    break;
+            }
+            pos++;
+        }
+        position = pos;
+        return pos >= maxHeaderSize ? HttpParseResult::TooLarge : HttpParseResult::Incomplete;
+    }
+
+    /**
+     * @brief 根据记录的偏移生成指向缓冲区的请求字段
+     */
+    HttpParseResult HttpRequestParser::Complete(std::string_view buffer) {
+        const char *data = buffer.data();
+        const auto view = [data](const Range range) {
+            return std::string_view(data + range.begin, range.end - range.begin);
+        };
+        for (size_t i = 0; i < headerCount; i++) {
+            headers[i] = {view(headerRanges[i].name), view(headerRanges[i].value)};
+        }
+        request.method = view(method);
+        request.path = view(path);
+        request.protocol = view(protocol);
+        request.headers = headers;
+        request.headerCount = headerCount;
+        return HttpParseResult::Complete;
+    }
+}
@@ -0,0 +1,55 @@
+#include "HttpRouter.h"
+
+namespace v2_taskbar_manager {
+    /**
+     * @brief 按名称取得路径参数
+     * @param name 参数名，不含 ':' 或 '*'
+     * @return std::string_view 没有该参数时返回空
+     */
+    std::string_view HttpRouteParams::Get(std::string_view name) const {
+        for (size_t i = 0; i < count; i++) {
+            if (names[i] == name) {
+                return values[i];
+            }
+        }
+        return {};
+    }
+
+    /**
+     * @brief 把请求行中的路径拆分为路径与查询字符串
+     * @param target 请求行中的路径
+     * @return std::pair<std::string_view, std::string_view> 路径与查询字符串（不含 '?'），片段标识符被丢弃
+     */
+    std::pair<std::string_view, std::string_view> SplitQuery(std::string_view target) {
+        if (const size_t fragment = target.find('#'); fragment != std::string_view::npos) {
+            target = target.substr(0, fragment);
+        }
+        const size_t question = target.find('?');
+        if (question == std::string_view::npos) {
+            return {target, {}};
+        }
+        return {target.substr(0, question), target.substr(question + 1)};
+    }
+
+    /**
+     * @brief 从查询字符串中取得参数的值
+     * @param query 查询字符串（不含 '?'）
+     * @param name 参数名
+     * @return std::string_view 第一个同名参数的值，未解码；没有该参数时返回空
+     */
+    std::string_view QueryParameter(std::string_view query, std::string_view name) {
+        while (!query.empty()) {
+            const size_t ampersand = query.find('&');
+            const std::string_view pair = query.substr(0, ampersand);
+            const size_t equals = pair.find('=');
+            if (pair.substr(0, equals) == name) {
+                return equals == std::string_view::npos ? std::string_view() : pair.substr(equals + 1);
+            }
+            if (ampersand == std::string_view::npos) {
+                break;
+            }
+            query.remove_prefix(ampersand + 1);
+        }
+        return {};
+    }
+}
@@ -0,0 +1,844 @@
+#include "IocpBackend.h"
+
+#include <algorithm>
+
+#include "spdlog/spdlog.h"
+
+namespace v2_taskbar_manager {
+    namespace {
+        // 超时定时器的精度，也是完成端口的最长等待时间
+        constexpr std::chrono::milliseconds kTimerTick{250};
+        // AcceptEx 在接收缓冲区末尾为本地与远程地址各保留的长度
+        constexpr DWORD kAddressLength = sizeof(sockaddr_in) + 16;
+        // 停止时取消剩余连接之后，等待被取消的操作以失败完成的最长时间
+        constexpr std::chrono::milliseconds kCancelTimeout{1000};
+    }
+
+    /**
+     * @brief 重置池中取出的I/O上下文，使其可以用于新的连接
+     * @param acceptSocket 用于 AcceptEx 的套接字
+     */
+    void IocpBackend::IOContext::Reset(const SOCKET acceptSocket) {
+        ZeroMemory(&io.overlapped, sizeof(io.overlapped));
+        socket = acceptSocket;
+        io.op = IOOperation::OP_ACCEPT;
+        refCount.store(1);
+        connection.Reset();
+    }
+
+    IocpBackend::IocpBackend(const HttpRequestHandler &handler, const HttpServerOptions &options)
+        : handler(handler), options(options), contextPool(options.connectionPoolSize), timers(kTimerTick) {
+        rejectOperation.op = IOOperation::OP_REJECT;
+    }
+
+    /**
+     * @brief 启动 IOCP 后端
+     * @param port 端口号，为 0 时由系统分配
+     * @return int 实际监听的端口号，失败返回 -1
+     */
+    int IocpBackend::Start(const int port) {
+        int iResult = 0;
+
+        WSADATA wsaData = {};
+        iResult = WSAStartup(MAKEWORD(2, 2), &wsaData);
+        if (iResult != 0) {
+            return -1;
+        }
+
+        listenSocket = WSASocket(AF_INET, SOCK_STREAM, 0, nullptr, 0, WSA_FLAG_OVERLAPPED);
+        if (listenSocket == INVALID_SOCKET) {
+            WSACleanup();
+            return -1;
+        }
+
+        // 设置套接字为非阻塞模式
+        u_long iMode = 1;
+        iResult = ioctlsocket(listenSocket, FIONBIO, &iMode);
+        if (iResult != NO_ERROR) {
+            closesocket(listenSocket);
+            WSACleanup();
+            return -1;
+        }
+
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        address.sin_port = htons(port);
+
+        iResult = bind(listenSocket, reinterpret_cast<SOCKADDR *>(&address), sizeof(address));
+        if (iResult == SOCKET_ERROR) {
+            closesocket(listenSocket);
+            WSACleanup();
+            return -1;
+        }
+
+        // 获取实际分配的端口号
+        sockaddr_in actualAddr{};
+        int len = sizeof(actualAddr);
+        if (getsockname(listenSocket, reinterpret_cast<sockaddr *>(&actualAddr), &len) == SOCKET_ERROR) {
+            closesocket(listenSocket);
+            WSACleanup();
+            return -1;
+        }
+
+        const int actualPort = ntohs(actualAddr.sin_port);
+
+        iResult = listen(listenSocket, SOMAXCONN);
+        if (iResult == SOCKET_ERROR) {
+            closesocket(listenSocket);
+            WSACleanup();
+            return -1;
+        }
+
+        // 创建I/O完成端口
+        completionPort = CreateIoCompletionPort(INVALID_HANDLE_VALUE, nullptr, listenSocket, 0);
+        if (completionPort == nullptr) {
+            closesocket(listenSocket);
+            WSACleanup();
+            return -1;
+        }
+        CreateIoCompletionPort(reinterpret_cast<HANDLE>(listenSocket), completionPort, listenSocket, 0);
+
+        // 获取AcceptEx函数指针
+        GUID guidAcceptEx = WSAID_ACCEPTEX;
+        DWORD bytes;
+        iResult = WSAIoctl(listenSocket, SIO_GET_EXTENSION_FUNCTION_POINTER, &guidAcceptEx, sizeof(guidAcceptEx),
+                           &lpFnAcceptEx, sizeof(lpFnAcceptEx), &bytes, nullptr, nullptr);
+        // 获取TransmitFile函数指针，资源目录中的大文件由它零拷贝发送
+        if (iResult != SOCKET_ERROR) {
+            GUID guidTransmitFile = WSAID_TRANSMITFILE;
+            iResult = WSAIoctl(listenSocket, SIO_GET_EXTENSION_FUNCTION_POINTER, &guidTransmitFile,
+                               sizeof(guidTransmitFile), &lpFnTransmitFile, sizeof(lpFnTransmitFile), &bytes, nullptr,
+                               nullptr);
+        }
+        if (iResult == SOCKET_ERROR) {
+            CloseHandle(completionPort);
+            completionPort = nullptr;
+            closesocket(listenSocket);
+            listenSocket = INVALID_SOCKET;
+            WSACleanup();
+            return -1;
+        }
+
+        // 启动服务器，所有 Worker 线程共同消费同一个完成端口
+        isRunning.store(true);
+        const size_t workerCount = options.ResolveWorkerThreads();
+        for (size_t i = 0; i < workerCount; i++) {
+            workers.emplace_back(&IocpBackend::WorkerThread, this);
+        }
+        SPDLOG_INFO("IOCP Worker 线程数: {}, 预投递 AcceptEx: {}", workerCount, options.acceptDepth);
+        for (size_t i = 0; i < std::max<size_t>(options.acceptDepth, 1); i++) {
+            PostAccept();
+        }
+        return actualPort;
+    }
+
+    /**
+     * @brief 停止 IOCP 后端
+     * @return HttpShutdownReport 停止所用的时间与连接的关闭情况
+     * @note 关闭监听套接字、取消等待请求数据的 WSARecv，Worker 线程继续处理进行中的响应直到发送完毕；
+     * 到达期限之后以 CancelIoEx 取消其余连接上的所有操作，所有上下文归还之后再唤醒并等待 Worker 线程结束
+     */
+    HttpShutdownReport IocpBackend::Stop() {
+        HttpShutdownReport report;
+        if (!isRunning) {
+            return report;
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        const size_t inUse = contextPool.InUse();
+        const auto accepts = static_cast<size_t>(std::max<long>(acceptsPending.load(), 0));
+        report.connections = inUse > accepts ? inUse - accepts : 0;
+        draining.store(true);
+
+        // 挂起的 AcceptEx（包括拒绝连接的 AcceptEx）随监听套接字的关闭以失败完成，不再补投
+        closesocket(listenSocket);
+
+        // 等待请求数据的连接都设置了定时器，取消它们挂起的 WSARecv，连接在失败完成时释放；
+        // 等待 API 结果的连接不再等待，以 503 完成，响应发送完毕之后关闭
+        std::vector<IOContext *> waiting;
+        std::vector<std::shared_ptr<HttpApiReply>> replies;
+        {
+            std::lock_guard lock(timerMutex);
+            timers.CancelAll([&waiting, &replies](TimerNode *node) {
+                auto *context = static_cast<IOContext *>(node->owner);
+                if (context->reply) {
+                    replies.push_back(std::move(context->reply));
+                    return;
+                }
+                if (!TryAddRef(context)) {
+                    return;
+                }
+                CancelIoEx(reinterpret_cast<HANDLE>(context->socket), &context->io.overlapped);
+                waiting.push_back(context);
+            });
+        }
+        for (IOContext *context : waiting) {
+            Release(context);
+        }
+        for (const std::shared_ptr<HttpApiReply> &reply : replies) {
+            reply->Complete(503, options.apiTimeoutBody);
+        }
+
+        // 进行中的响应与推送连接的结束标记在期限内发送完毕，连接随之释放
+        {
+            std::unique_lock lock(drainMutex);
+            drainCondition.wait_until(lock, start + options.drainTimeout,
+                                      [this] { return contextPool.InUse() == 0; });
+        }
+
+        // 到达期限之后取消其余连接上的所有操作，它们以失败完成并归还上下文
+        std::vector<IOContext *> remaining;
+        contextPool.ForEachInUse([&remaining](IOContext *context) {
+            if (TryAddRef(context)) {
+                remaining.push_back(context);
+            }
+        });
+        report.aborted = remaining.size();
+        for (IOContext *context : remaining) {
+            CancelIoEx(reinterpret_cast<HANDLE>(context->socket), nullptr);
+            Release(context);
+        }
+        if (!remaining.empty()) {
+            std::unique_lock lock(drainMutex);
+            if (!drainCondition.wait_for(lock, kCancelTimeout, [this] { return contextPool.InUse() == 0; })) {
+                SPDLOG_WARN("仍有 {} 个连接上下文没有归还", contextPool.InUse());
+            }
+        }
+
+        isRunning.store(false);
+
+        // 每个 Worker 线程各消费一个空的完成通知后退出
+        if (completionPort) {
+            for (size_t i = 0; i < workers.size(); i++) {
+                PostQueuedCompletionStatus(completionPort, 0, 0, nullptr);
+            }
+        }
+
+        SPDLOG_INFO("等待 Worker 线程结束");
+        for (std::thread &worker : workers) {
+            if (worker.joinable()) {
+                worker.join();
+            }
+        }
+        workers.clear();
+
+        listenSocket = INVALID_SOCKET;
+        // 拒绝 AcceptEx 的失败完成没有在 Worker 线程退出之前处理时，套接字在这里关闭
+        if (rejectSocket != INVALID_SOCKET) {
+            closesocket(rejectSocket);
+            rejectSocket = INVALID_SOCKET;
+        }
+        rejectPosted.store(false);
+
+        if (completionPort) {
+            CloseHandle(completionPort);
+            completionPort = nullptr;
+        }
+
+        draining.store(false);
+        WSACleanup();
+        report.duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+        return report;
+    }
+
+    /**
+     * @brief 获取运行时计数器
+     * @return HttpServerStats 计数器快照
+     */
+    HttpServerStats IocpBackend::GetStats() const {
+        HttpServerStats stats;
+        stats.poolCapacity = contextPool.Capacity();
+        stats.poolInUse = contextPool.InUse();
+        stats.poolPeak = contextPool.Peak();
+        stats.poolExhausted = contextPool.Exhausted();
+        stats.connectionsRejected = connectionsRejected.load();
+        stats.connectionsDeferred = connectionsDeferred.load();
+        stats.acceptsPending = static_cast<size_t>(std::max<long>(acceptsPending.load(), 0));
+        stats.acceptsDrained = acceptsDrained.load();
+        stats.acceptsWithData = acceptsWithData.load();
+        stats.firstByteTimeouts = timeouts[static_cast<size_t>(HttpWaitPhase::FirstByte)].load();
+        stats.headerTimeouts = timeouts[static_cast<size_t>(HttpWaitPhase::Header)].load();
+        stats.idleTimeouts = timeouts[static_cast<size_t>(HttpWaitPhase::Idle)].load();
+        return stats;
+    }
+
+    /**
+     * @brief 提交接受连接请求
+     *
+     * 提交一个异步接受连接请求，将新连接添加到客户端列表中。
+     * 启用 acceptWithFirstRead 时 AcceptEx 携带接收缓冲区，第一段请求数据到达时才完成，省去一次 WSARecv 的投递与完成。
+     * 池耗尽时等待有连接释放后再补投；Reject 策略下另外在池外挂起一个 AcceptEx，以 503 拒绝等待中的连接
+     */
+    void IocpBackend::PostAccept() {
+        if (draining) {
+            return;
+        }
+        // 从池中取出一个I/O上下文来跟踪这个异步操作
+        IOContext *context = contextPool.Acquire(options);
+        if (context == nullptr) {
+            if (acceptsDeferred.fetch_add(1) == 0 && options.overloadPolicy == HttpOverloadPolicy::Defer) {
+                connectionsDeferred.fetch_add(1, std::memory_order_relaxed);
+            }
+            if (options.overloadPolicy == HttpOverloadPolicy::Reject) {
+                PostReject();
+            }
+            return;
+        }
+        const SOCKET socket = WSASocket(AF_INET, SOCK_STREAM, 0, nullptr, 0, WSA_FLAG_OVERLAPPED);
+        if (socket == INVALID_SOCKET) {
+            contextPool.Release(context);
+            return;
+        }
+        context->Reset(socket);
+        acceptsPending.fetch_add(1);
+        if (options.acceptWithFirstRead) {
+            std::lock_guard lock(acceptMutex);
+            accepting.insert(context);
+        }
+
+        const DWORD receiveLength = options.acceptWithFirstRead ? sizeof(context->recvData) - 2 * kAddressLength : 0;
+        DWORD bytes = 0;
+        const BOOL ok = lpFnAcceptEx(listenSocket, socket, context->recvData, receiveLength, kAddressLength,
+                                     kAddressLength, &bytes, &context->io.overlapped);
+        if (!ok && WSAGetLastError() != ERROR_IO_PENDING) {
+            FinishAccept(context);
+            Release(context);
+        }
+    }
+
+    /**
+     * @brief 记录一个 AcceptEx 已经结束（成功或失败）
+     * @param context I/O上下文
+     * @note 最后一个挂起的 AcceptEx 被取走时计一次耗尽，补投之前到达的连接只能在监听队列中等待
+     */
+    void IocpBackend::FinishAccept(IOContext *context) {
+        if (acceptsPending.fetch_sub(1) == 1) {
+            acceptsDrained.fetch_add(1, std::memory_order_relaxed);
+        }
+        if (options.acceptWithFirstRead) {
+            std::lock_guard lock(acceptMutex);
+            accepting.erase(context);
+        }
+    }
+
+    /**
+     * @brief 处理接受连接的完成
+     * @param context I/O上下文
+     * @param bytes 随接受一起到达的请求数据的字节数
+     * @note 先补投 AcceptEx 再处理请求，使挂起的接受操作数尽快恢复
+     */
+    void IocpBackend::OnAccepted(IOContext *context, const DWORD bytes) {
+        FinishAccept(context);
+        setsockopt(context->socket, SOL_SOCKET, SO_UPDATE_ACCEPT_CONTEXT, reinterpret_cast<char *>(&listenSocket),
+                   sizeof(listenSocket));
+
+        CreateIoCompletionPort(reinterpret_cast<HANDLE>(context->socket), completionPort, context->socket, 0);
+
+        // 连接建立后开始计算第一个字节的超时
+        context->connection.Reset();
+
+        // 投递下一个接受连接操作，保持服务器能够接受新连接
+        PostAccept();
+
+        if (!options.acceptWithFirstRead) {
+            PostRecv(context);
+            return;
+        }
+        // 第一段请求数据已在接收缓冲区的开头，字节数为 0 表示对端在发送数据之前关闭了连接
+        if (bytes > 0) {
+            acceptsWithData.fetch_add(1, std::memory_order_relaxed);
+        }
+        Dispatch(context, context->connection.OnReceived(context->recvData, bytes, handler));
+    }
+
+    /**
+     * @brief 在池外投递一个不接收数据的 AcceptEx，用于拒绝连接数达到上限之后到达的连接
+     * @note 同一时刻最多挂起一个，完成之后仍有未补投的 AcceptEx 时再次投递
+     */
+    void IocpBackend::PostReject() {
+        if (draining || rejectPosted.exchange(true)) {
+            return;
+        }
+        rejectSocket = WSASocket(AF_INET, SOCK_STREAM, 0, nullptr, 0, WSA_FLAG_OVERLAPPED);
+        if (rejectSocket == INVALID_SOCKET) {
+            rejectPosted.store(false);
+            return;
+        }
+        ZeroMemory(&rejectOperation.overlapped, sizeof(rejectOperation.overlapped));
+        DWORD bytes = 0;
+        if (!lpFnAcceptEx(listenSocket, rejectSocket, rejectAddresses, 0, kAddressLength, kAddressLength, &bytes,
+                          &rejectOperation.overlapped) &&
+            WSAGetLastError() != ERROR_IO_PENDING) {
+            closesocket(rejectSocket);
+            rejectSocket = INVALID_SOCKET;
+            rejectPosted.store(false);
+        }
+    }
+
+    /**
+     * @brief 处理拒绝 AcceptEx 的完成
+     * @param accepted 是否成功接受了连接
+     * @note 挂起期间有连接释放时，接受的连接照常处理；否则读走已到达的请求数据之后发送 503 并关闭，
+     * 关闭时接收队列中留有数据会使连接被重置，客户端可能收不到响应
+     */
+    void IocpBackend::OnRejected(const bool accepted) {
+        const SOCKET socket = rejectSocket;
+        rejectSocket = INVALID_SOCKET;
+        rejectPosted.store(false);
+
+        // 停止期间接受的连接同样以 503 拒绝
+        IOContext *context = accepted && !draining ? contextPool.Acquire(options) : nullptr;
+        if (!accepted) {
+            closesocket(socket);
+        } else if (context != nullptr) {
+            setsockopt(socket, SOL_SOCKET, SO_UPDATE_ACCEPT_CONTEXT, reinterpret_cast<char *>(&listenSocket),
+                       sizeof(listenSocket));
+            context->Reset(socket);
+            CreateIoCompletionPort(reinterpret_cast<HANDLE>(socket), completionPort, socket, 0);
+            context->connection.Reset();
+            PostRecv(context);
+        } else {
+            setsockopt(socket, SOL_SOCKET, SO_UPDATE_ACCEPT_CONTEXT, reinterpret_cast<char *>(&listenSocket),
+                       sizeof(listenSocket));
+            // 非阻塞地读取与发送，拒绝连接不会阻塞 Worker 线程
+            u_long nonBlocking = 1;
+            ioctlsocket(socket, FIONBIO, &nonBlocking);
+            char discard[2048];
+            for (int i = 0; i < 4 && recv(socket, discard, sizeof(discard), 0) > 0; i++) {
+            }
+            const std::string_view response = handler.OverloadedResponse();
+            send(socket, response.data(), static_cast<int>(response.size()), 0);
+            shutdown(socket, SD_SEND);
+            closesocket(socket);
+            connectionsRejected.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        if (isRunning && acceptsDeferred.load() > 0) {
+            PostReject();
+        }
+    }
+
+    /**
+     * @brief 取消连接已建立、但迟迟没有发送数据的 AcceptEx
+     * @note 携带接收缓冲区的 AcceptEx 要等到第一段数据才完成，连接之后不发送数据的客户端会一直占用它。
+     * SO_CONNECT_TIME 给出连接已建立的秒数（尚未建立时为 0xFFFFFFFF），达到第一个字节的超时后取消，
+     * AcceptEx 以失败完成并补投；只在推进时间轮的线程上调用
+     */
+    void IocpBackend::CloseIdleAccepts() {
+        const auto limit = std::max<long long>(
+            std::chrono::duration_cast<std::chrono::seconds>(options.firstByteTimeout).count(), 1);
+        std::lock_guard lock(acceptMutex);
+        for (auto it = accepting.begin(); it != accepting.end();) {
+            IOContext *context = *it;
+            DWORD seconds = 0;
+            int size = sizeof(seconds);
+            if (getsockopt(context->socket, SOL_SOCKET, SO_CONNECT_TIME, reinterpret_cast<char *>(&seconds),
+                           &size) == 0 &&
+                seconds != 0xFFFFFFFF && seconds >= limit) {
+                // 从集合中移除，避免取消完成之前的下一次推进重复计数
+                it = accepting.erase(it);
+                if (CancelIoEx(reinterpret_cast<HANDLE>(listenSocket), &context->io.overlapped)) {
+                    timeouts[static_cast<size_t>(HttpWaitPhase::FirstByte)].fetch_add(1, std::memory_order_relaxed);
+                }
+                continue;
+            }
+            ++it;
+        }
+    }
+
+    /**
+     * @brief 投递异步接收操作
+     * @param context I/O上下文
+     */
+    void IocpBackend::PostRecv(IOContext *context) {
+        // 定时器必须在投递 WSARecv 之前设置，否则接收可能已经在其他线程上完成；推送连接不设置超时
+        if (context->connection.Stream() == nullptr) {
+            ScheduleTimer(context);
+        }
+        ZeroMemory(&context->io.overlapped, sizeof(context->io.overlapped));
+        context->io.op = IOOperation::OP_RECV;
+        context->buffer.buf = context->recvData;
+        context->buffer.len = sizeof(context->recvData);
+        DWORD flags = 0;
+        if (WSARecv(context->socket, &context->buffer, 1, nullptr, &flags, &context->io.overlapped, nullptr) ==
+                SOCKET_ERROR &&
+            WSAGetLastError() != WSA_IO_PENDING) {
+            Release(context);
+        }
+    }
+
+    /**
+     * @brief 投递异步发送操作，以 scatter/gather 方式发送连接中尚未发送的头部与正文
+     * @param context I/O上下文
+     */
+    void IocpBackend::PostSend(IOContext *context) {
+        CancelTimer(context);
+        ZeroMemory(&context->io.overlapped, sizeof(context->io.overlapped));
+        context->io.op = IOOperation::OP_SEND;
+        std::string_view pending[2];
+        const size_t count = context->connection.PendingBuffers(pending);
+
+        // 资源目录中未映射的大文件：头部剩余部分作为 TransmitFile 的前缀，文件正文由内核直接从文件系统缓存发送
+        uint64_t offset = 0;
+        size_t length = 0;
+        if (const StaticFile *file = context->connection.PendingFile(offset, length)) {
+            context->transmitBuffers = {};
+            if (count > 0) {
+                context->transmitBuffers.Head = const_cast<char *>(pending[0].data());
+                context->transmitBuffers.HeadLength = static_cast<DWORD>(pending[0].size());
+            }
+            // 文件句柄由所有连接共享，发送位置通过 OVERLAPPED 的偏移指定而不是文件指针
+            context->io.overlapped.Offset = static_cast<DWORD>(offset);
+            context->io.overlapped.OffsetHigh = static_cast<DWORD>(offset >> 32);
+            // 单次 TransmitFile 最多发送 2^31-2 字节，更大的文件在 OnSent 之后继续发送
+            const auto bytes = static_cast<DWORD>(length < 0x7FFFFFFE ? length : 0x7FFFFFFE);
+            if (!lpFnTransmitFile(context->socket, file->handle, bytes, 0, &context->io.overlapped,
+                                  count > 0 ? &context->transmitBuffers : nullptr, 0) &&
+                WSAGetLastError() != WSA_IO_PENDING) {
+                Release(context);
+            }
+            return;
+        }
+
+        for (size_t i = 0; i < count; i++) {
+            context->sendBuffers[i].buf = const_cast<char *>(pending[i].data());
+            context->sendBuffers[i].len = static_cast<ULONG>(pending[i].size());
+        }
+        if (WSASend(context->socket, context->sendBuffers, static_cast<DWORD>(count), nullptr, 0,
+                    &context->io.overlapped, nullptr) ==
+                SOCKET_ERROR &&
+            WSAGetLastError() != WSA_IO_PENDING) {
+            Release(context);
+        }
+    }
+
+    /**
+     * @brief 根据连接状态机给出的动作投递下一个 I/O 操作
+     * @param context I/O上下文
+     * @param action 下一个动作
+     */
+    void IocpBackend::Dispatch(IOContext *context, const HttpAction action) {
+        switch (action) {
+        case HttpAction::Receive:
+            // 停止期间响应发送完毕的连接不再等待下一个请求
+            if (draining && context->connection.Stream() == nullptr) {
+                Release(context);
+            } else {
+                PostRecv(context);
+            }
+            break;
+        case HttpAction::Send:
+            PostSend(context);
+            break;
+        case HttpAction::Close:
+            if (context->connection.Stream() != nullptr) {
+                AbortStream(context);
+            }
+            Release(context);
+            break;
+        case HttpAction::Upgrade:
+            UpgradeContext(context);
+            break;
+        case HttpAction::Wait:
+            WaitReply(context);
+            break;
+        }
+    }
+
+    /**
+     * @brief 握手响应（或事件流的响应头）发送完毕后把连接切换为推送连接
+     * @param context I/O上下文
+     * @note 接收与推送各自持有一个挂起的操作与一个引用：io 上始终挂起 WSARecv，
+     * 会话有数据待发送时通过完成端口唤醒一个 Worker 线程，在 push 上投递 WSASend
+     */
+    void IocpBackend::UpgradeContext(IOContext *context) {
+        CancelTimer(context);
+        context->connection.Stream()->Subscribe(context, [this, context](StreamSession &) {
+            // 通知在会话的锁内调用，连接已在释放时不再唤醒
+            if (!TryAddRef(context)) {
+                return;
+            }
+            ZeroMemory(&context->push.overlapped, sizeof(context->push.overlapped));
+            context->push.op = IOOperation::OP_PUSH_WAKE;
+            PostQueuedCompletionStatus(completionPort, 0, context->socket, &context->push.overlapped);
+        });
+        PostRecv(context);
+    }
+
+    /**
+     * @brief 等待其他线程完成 API 响应，期间不投递任何 I/O，Worker 线程继续处理其他连接
+     * @param context I/O上下文
+     * @note 等待期间 io 上的引用一直持有，连接不会被释放；完成（包括超时与停止时的完成）只发生一次，
+     * 通知通过完成端口唤醒一个 Worker 线程，在那里发送响应
+     */
+    void IocpBackend::WaitReply(IOContext *context) {
+        HttpApiReply *reply = context->connection.Reply();
+        {
+            std::lock_guard lock(timerMutex);
+            context->reply = reply->shared_from_this();
+            timers.Schedule(&context->timer, context->connection.ReplyDeadline());
+        }
+        const bool watching = reply->Watch(context, [this, context](HttpApiReply &) {
+            ZeroMemory(&context->push.overlapped, sizeof(context->push.overlapped));
+            context->push.op = IOOperation::OP_REPLY_WAKE;
+            PostQueuedCompletionStatus(completionPort, 0, context->socket, &context->push.overlapped);
+        });
+        // 处理函数返回之后、登记之前已经完成
+        if (!watching) {
+            FinishReply(context);
+        }
+    }
+
+    /**
+     * @brief 发送已完成的 API 响应
+     * @param context I/O上下文
+     */
+    void IocpBackend::FinishReply(IOContext *context) {
+        CancelTimer(context);
+        Dispatch(context, context->connection.OnReplied(handler));
+    }
+
+    /**
+     * @brief 在 push 上投递推送会话中尚未发送的数据，调用方已经是会话的发送者并持有一个引用
+     * @param context I/O上下文
+     */
+    void IocpBackend::PostPush(IOContext *context) {
+        const std::string_view unsent = context->connection.Stream()->Unsent();
+        ZeroMemory(&context->push.overlapped, sizeof(context->push.overlapped));
+        context->push.op = IOOperation::OP_PUSH_SEND;
+        context->pushBuffer.buf = const_cast<char *>(unsent.data());
+        context->pushBuffer.len = static_cast<ULONG>(unsent.size());
+        if (WSASend(context->socket, &context->pushBuffer, 1, nullptr, 0, &context->push.overlapped, nullptr) ==
+                SOCKET_ERROR &&
+            WSAGetLastError() != WSA_IO_PENDING) {
+            AbortStream(context);
+            Release(context);
+        }
+    }
+
+    /**
+     * @brief 处理推送的完成
+     * @param context I/O上下文
+     * @param bytes 本次发送的字节数
+     * @note 发送期间新排队的数据由同一个发送者继续发送；最后的数据发送完毕后取消挂起的接收，连接随之关闭
+     */
+    void IocpBackend::OnPushed(IOContext *context, const DWORD bytes) {
+        StreamSession *session = context->connection.Stream();
+        if (session->OnWritten(bytes)) {
+            PostPush(context);
+            return;
+        }
+        if (session->IsCloseSent()) {
+            AbortStream(context);
+        }
+        Release(context);
+    }
+
+    /**
+     * @brief 关闭推送连接的双向传输，使另一个方向上挂起的操作以失败完成并释放引用
+     * @param context I/O上下文，调用方持有一个引用，套接字在此期间不会被关闭
+     */
+    void IocpBackend::AbortStream(IOContext *context) {
+        shutdown(context->socket, SD_BOTH);
+        CancelIoEx(reinterpret_cast<HANDLE>(context->socket), nullptr);
+    }
+
+    /**
+     * @brief 在引用计数尚未归零时增加一个引用
+     * @param context I/O上下文
+     * @return 引用计数已归零（正在释放）时返回 false
+     */
+    bool IocpBackend::TryAddRef(IOContext *context) {
+        long count = context->refCount.load();
+        while (count > 0) {
+            if (context->refCount.compare_exchange_weak(count, count + 1)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief 释放一个引用，最后一个引用释放时关闭套接字并把I/O上下文归还到池中
+     * @param context I/O上下文
+     * @note 这是I/O上下文唯一的释放点，任何线程在任何分支上放弃 I/O 都只需要调用此函数
+     */
+    void IocpBackend::Release(IOContext *context) {
+        if (context->refCount.fetch_sub(1) != 1) {
+            return;
+        }
+        CancelTimer(context);
+        // 先从广播中心移除会话，之后不会再有唤醒投递到这个上下文
+        context->connection.Close();
+        if (context->socket != INVALID_SOCKET) {
+            closesocket(context->socket);
+            context->socket = INVALID_SOCKET;
+        }
+        contextPool.Release(context);
+        if (draining) {
+            std::lock_guard lock(drainMutex);
+            drainCondition.notify_all();
+        }
+
+        // 之前因为池耗尽而没有投递的 AcceptEx 在这里补投
+        long deferred = acceptsDeferred.load();
+        while (isRunning && deferred > 0) {
+            if (acceptsDeferred.compare_exchange_weak(deferred, deferred - 1)) {
+                PostAccept();
+                break;
+            }
+        }
+    }
+
+    /**
+     * @brief 按连接所处阶段设置等待请求数据的超时定时器
+     * @param context I/O上下文
+     * @note 阶段在设置时记录下来，超时处理不需要读取可能正在其他线程上处理的连接状态
+     */
+    void IocpBackend::ScheduleTimer(IOContext *context) {
+        const HttpWaitPhase phase = context->connection.WaitPhase();
+        const auto deadline = context->connection.ReceiveDeadline();
+        std::lock_guard lock(timerMutex);
+        context->waitPhase = phase;
+        timers.Schedule(&context->timer, deadline);
+    }
+
+    /**
+     * @brief 取消超时定时器，发送响应期间与上下文归还之前调用
+     * @param context I/O上下文
+     */
+    void IocpBackend::CancelTimer(IOContext *context) {
+        std::lock_guard lock(timerMutex);
+        timers.Cancel(&context->timer);
+        context->reply.reset();
+    }
+
+    /**
+     * @brief 推进时间轮，取消超时连接上挂起的 WSARecv，以 503 完成等待超时的 API 响应
+     * @note 被取消的 WSARecv 会以失败完成，I/O上下文在完成处理中释放；API 响应在锁外完成，
+     * 与其他线程的完成竞争时先完成的一方生效，响应由完成的唤醒发送。
+     * CancelIoEx 在持有 timerMutex 时调用：同一连接重新投递 WSARecv 之前必须先在锁内重新设置定时器，
+     * 因此不会误取消一个新的接收；处理期间持有的引用保证套接字不会被提前关闭
+     */
+    void IocpBackend::CloseExpiredConnections() {
+        if (options.acceptWithFirstRead) {
+            CloseIdleAccepts();
+        }
+        std::vector<IOContext *> expired;
+        std::vector<std::shared_ptr<HttpApiReply>> replies;
+        {
+            std::lock_guard lock(timerMutex);
+            timers.Advance(std::chrono::steady_clock::now(), [this, &expired, &replies](TimerNode *node) {
+                auto *context = static_cast<IOContext *>(node->owner);
+                if (context->reply) {
+                    replies.push_back(std::move(context->reply));
+                    return;
+                }
+                if (!TryAddRef(context)) {
+                    return;
+                }
+                // 接收恰好已经完成时 CancelIoEx 找不到操作，连接继续由完成处理决定去留
+                if (CancelIoEx(reinterpret_cast<HANDLE>(context->socket), &context->io.overlapped)) {
+                    timeouts[static_cast<size_t>(context->waitPhase)].fetch_add(1, std::memory_order_relaxed);
+                }
+                expired.push_back(context);
+            });
+        }
+        for (IOContext *context : expired) {
+            Release(context);
+        }
+        for (const std::shared_ptr<HttpApiReply> &reply : replies) {
+            if (reply->Complete(503, options.apiTimeoutBody)) {
+                SPDLOG_WARN("API 处理超时");
+            }
+        }
+    }
+
+    void IocpBackend::WorkerThread() {
+        while (isRunning) {
+            // 传输的字节数
+            DWORD bytesTransferred;
+            // 完成键
+            ULONG_PTR completionKey;
+            // 重叠结构指针
+            LPOVERLAPPED overlapped;
+
+            // 从完成端口获取完成的I/O操作
+            const BOOL ok = GetQueuedCompletionStatus(completionPort, &bytesTransferred, &completionKey, &overlapped,
+                                                      static_cast<DWORD>(kTimerTick.count()));
+
+            if (!isRunning) {
+                break;
+            }
+
+            // 繁忙时完成端口可能一直不超时，因此按时间间隔而不是按超时事件推进时间轮，同一时刻只由一个线程推进
+            const long long now = std::chrono::steady_clock::now().time_since_epoch().count();
+            long long tickAt = nextTick.load();
+            if (now >= tickAt &&
+                nextTick.compare_exchange_strong(
+                    tickAt, now + std::chrono::duration_cast<std::chrono::steady_clock::duration>(kTimerTick).count())) {
+                CloseExpiredConnections();
+            }
+
+            if (!ok) {
+                if (overlapped == nullptr) {
+                    continue;
+                }
+                const auto operation = CONTAINING_RECORD(overlapped, IOOperation, overlapped);
+                // 拒绝连接的 AcceptEx 不属于任何I/O上下文
+                if (operation->op == IOOperation::OP_REJECT) {
+                    OnRejected(false);
+                    continue;
+                }
+                IOContext *context = operation->context;
+                const bool isAccept = operation->op == IOOperation::OP_ACCEPT;
+                // 推送连接任一方向失败时，另一个方向上挂起的操作也需要结束
+                if (context->connection.Stream() != nullptr) {
+                    AbortStream(context);
+                }
+                // 失败的接受连接操作同样需要补投，保持服务器能够接受新连接
+                if (isAccept) {
+                    FinishAccept(context);
+                }
+                Release(context);
+                if (isAccept) {
+                    PostAccept();
+                }
+                continue;
+            }
+
+            if (completionKey == 0 && overlapped == nullptr) {
+                break;
+            }
+
+            if (!overlapped) {
+                continue;
+            }
+
+            const auto operation = CONTAINING_RECORD(overlapped, IOOperation, overlapped);
+            IOContext *context = operation->context;
+            // 根据操作类型处理不同的I/O完成事件
+            if (operation->op == IOOperation::OP_ACCEPT) {
+                OnAccepted(context, bytesTransferred);
+            } else if (operation->op == IOOperation::OP_REJECT) {
+                OnRejected(true);
+            } else if (operation->op == IOOperation::OP_RECV) {
+                Dispatch(context, context->connection.OnReceived(context->recvData, bytesTransferred, handler));
+            } else if (operation->op == IOOperation::OP_SEND) {
+                Dispatch(context, context->connection.OnSent(bytesTransferred, handler));
+            } else if (operation->op == IOOperation::OP_PUSH_WAKE) {
+                // 唤醒期间已有发送者时，新的数据由该发送者在完成时继续发送
+                if (context->connection.Stream()->BeginWrite()) {
+                    PostPush(context);
+                } else {
+                    Release(context);
+                }
+            } else if (operation->op == IOOperation::OP_PUSH_SEND) {
+                OnPushed(context, bytesTransferred);
+            } else if (operation->op == IOOperation::OP_REPLY_WAKE) {
+                FinishReply(context);
+            }
+        }
+    }
+}
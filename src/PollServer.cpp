@@ -0,0 +1,598 @@
+#include "PollServer.h"
+
+#include <algorithm>
+#include <sstream>
+
+#ifdef _WIN32
+#include <ws2tcpip.h>
+#else
+#include <arpa/inet.h>
+#include <cerrno>
+#include <netinet/in.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+#include "spdlog/spdlog.h"
+
+namespace v1_taskbar_manager {
+    namespace {
+        // 等待请求超时的精度，也是存在定时器时一次等待的最长时间；没有定时器时无限期等待
+        constexpr std::chrono::milliseconds kTimerTick{100};
+
+#ifdef _WIN32
+        constexpr PollSocket kInvalidSocket = INVALID_SOCKET;
+        constexpr int kSendFlags = 0;
+        constexpr int kShutdownSend = SD_SEND;
+
+        void CloseSocket(const SOCKET socket) { closesocket(socket); }
+
+        bool WouldBlock() { return WSAGetLastError() == WSAEWOULDBLOCK; }
+#else
+        constexpr PollSocket kInvalidSocket = -1;
+        constexpr int kSendFlags = MSG_NOSIGNAL;
+        constexpr int kShutdownSend = SHUT_WR;
+
+        void CloseSocket(const int socket) { close(socket); }
+
+        bool WouldBlock() { return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR; }
+#endif
+
+        /**
+         * @brief 构建固定的响应报文，启动时构建一次，所有客户端只读共享
+         * @param statusLine 状态行
+         * @param headers 额外的响应头，每行以 "\r\n" 结尾
+         * @param body 响应体
+         * @return std::string 完整的响应报文，旧版服务器每个响应之后都关闭连接
+         */
+        std::string BuildResponse(const std::string &statusLine, const std::string &headers, const std::string &body) {
+            std::ostringstream stream;
+            stream << statusLine << "\r\n";
+            stream << headers;
+            stream << "Content-Length: " << body.size() << "\r\n";
+            stream << "Connection: close\r\n";
+            stream << "\r\n";
+            stream << body;
+            return stream.str();
+        }
+    }
+
+    PollServer::PollServer(const std::string &html, const v2_taskbar_manager::HttpServerOptions &options)
+        : options(options),
+          indexResponse(BuildResponse("HTTP/1.1 200 OK", "Content-Type: text/html; charset=utf-8\r\n", html)),
+          notFoundResponse(BuildResponse("HTTP/1.1 404 Not Found", "", "")),
+          notImplementedResponse(BuildResponse("HTTP/1.1 501 Not Implemented", "", "")),
+          methodNotAllowedResponse(BuildResponse("HTTP/1.1 405 Method Not Allowed", "Allow: GET\r\n", "")),
+          overloadedResponse(BuildResponse("HTTP/1.1 503 Service Unavailable",
+                                           "Retry-After: " + std::to_string(options.overloadRetryAfter.count()) +
+                                               "\r\n",
+                                           "")),
+          listenSocket(kInvalidSocket), pool(options.connectionPoolSize), timers(kTimerTick) {
+        // 路由表指向服务器持有的响应报文，与新版服务器使用同一个路由实现
+        router.Add("GET", "/", indexResponse);
+        router.Add("GET", "/index.html", indexResponse);
+    }
+
+    PollServer::~PollServer() {
+        Stop();
+    }
+
+    /**
+     * @brief 在回环地址上监听并启动服务线程
+     * @param port 端口号，为 0 时由系统分配
+     * @return int 实际监听的端口号，失败返回 -1
+     */
+    int PollServer::Start(const int port) {
+#ifdef _WIN32
+        WSADATA wsaData;
+        if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0) {
+            return -1;
+        }
+        listenSocket = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+        u_long nonBlocking = 1;
+        if (listenSocket != INVALID_SOCKET && ioctlsocket(listenSocket, FIONBIO, &nonBlocking) != NO_ERROR) {
+            closesocket(listenSocket);
+            listenSocket = INVALID_SOCKET;
+        }
+        using AddressLength = int;
+#else
+        listenSocket = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, IPPROTO_TCP);
+        using AddressLength = socklen_t;
+#endif
+        auto fail = [this] {
+            if (listenSocket != kInvalidSocket) {
+                CloseSocket(listenSocket);
+                listenSocket = kInvalidSocket;
+            }
+            ClosePoller();
+#ifdef _WIN32
+            WSACleanup();
+#endif
+            return -1;
+        };
+        if (listenSocket == kInvalidSocket) {
+            return fail();
+        }
+
+        // 设置套接字选项以允许地址重用
+        constexpr int reuseAddr = 1;
+        setsockopt(listenSocket, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char *>(&reuseAddr),
+                   sizeof(reuseAddr));
+
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        addr.sin_port = htons(static_cast<uint16_t>(port));
+        AddressLength length = sizeof(addr);
+        if (bind(listenSocket, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) != 0 ||
+            getsockname(listenSocket, reinterpret_cast<sockaddr *>(&addr), &length) != 0 ||
+            listen(listenSocket, SOMAXCONN) != 0 || !OpenPoller()) {
+            return fail();
+        }
+
+        stopRequested.store(false);
+        draining = false;
+        acceptPaused = false;
+        thread = std::thread(&PollServer::Run, this);
+        return ntohs(addr.sin_port);
+    }
+
+    /**
+     * @brief 停止服务线程
+     * @note 通过唤醒描述符打断等待，不接受新连接；还没有收到请求的客户端立即关闭，
+     * 正在发送响应的客户端在 drainTimeout 内发送完毕，到期后强制关闭
+     */
+    void PollServer::Stop() {
+        if (!thread.joinable()) {
+            return;
+        }
+        SPDLOG_INFO("正在停止 Socket 服务");
+        const auto start = std::chrono::steady_clock::now();
+        stopRequested.store(true);
+        Wake();
+        thread.join();
+        ClosePoller();
+#ifdef _WIN32
+        WSACleanup();
+#endif
+        SPDLOG_INFO("Socket 服务已停止，用时 {} ms",
+                    std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start)
+                        .count());
+    }
+
+    /**
+     * @brief 创建就绪通知与唤醒描述符，并登记监听套接字
+     * @return bool 是否成功
+     */
+    bool PollServer::OpenPoller() {
+#ifdef _WIN32
+        // 唤醒套接字与监听套接字一起参与 WSAPoll，Stop 向它发送一个数据报即可打断等待
+        wakeSocket = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+        sockaddr_in wakeAddr{};
+        wakeAddr.sin_family = AF_INET;
+        wakeAddr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        int wakeLength = sizeof(wakeAddr);
+        u_long nonBlocking = 1;
+        if (wakeSocket == INVALID_SOCKET ||
+            bind(wakeSocket, reinterpret_cast<sockaddr *>(&wakeAddr), sizeof(wakeAddr)) == SOCKET_ERROR ||
+            getsockname(wakeSocket, reinterpret_cast<sockaddr *>(&wakeAddr), &wakeLength) == SOCKET_ERROR ||
+            ioctlsocket(wakeSocket, FIONBIO, &nonBlocking) != NO_ERROR) {
+            return false;
+        }
+        wakePort = ntohs(wakeAddr.sin_port);
+        pollFds.clear();
+        pollFds.push_back(WSAPOLLFD{listenSocket, POLLRDNORM, 0});
+        pollFds.push_back(WSAPOLLFD{wakeSocket, POLLRDNORM, 0});
+        return true;
+#else
+        epollFd = epoll_create1(EPOLL_CLOEXEC);
+        wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (epollFd < 0 || wakeFd < 0) {
+            return false;
+        }
+        // 监听套接字以空指针标记，唤醒描述符以自身地址标记，其余事件携带 Client
+        epoll_event event{};
+        event.events = EPOLLIN;
+        event.data.ptr = nullptr;
+        if (epoll_ctl(epollFd, EPOLL_CTL_ADD, listenSocket, &event) < 0) {
+            return false;
+        }
+        event.data.ptr = &wakeFd;
+        return epoll_ctl(epollFd, EPOLL_CTL_ADD, wakeFd, &event) == 0;
+#endif
+    }
+
+    void PollServer::ClosePoller() {
+#ifdef _WIN32
+        if (wakeSocket != INVALID_SOCKET) {
+            closesocket(wakeSocket);
+            wakeSocket = INVALID_SOCKET;
+        }
+        wakePort = 0;
+        pollFds.clear();
+#else
+        if (wakeFd >= 0) {
+            close(wakeFd);
+            wakeFd = -1;
+        }
+        if (epollFd >= 0) {
+            close(epollFd);
+            epollFd = -1;
+        }
+#endif
+    }
+
+    /**
+     * @brief 打断服务线程的等待
+     */
+    void PollServer::Wake() {
+#ifdef _WIN32
+        if (wakePort <= 0) {
+            return;
+        }
+        const SOCKET sender = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+        if (sender == INVALID_SOCKET) {
+            return;
+        }
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        addr.sin_port = htons(static_cast<u_short>(wakePort));
+        constexpr char wake = 0;
+        sendto(sender, &wake, 1, 0, reinterpret_cast<sockaddr *>(&addr), sizeof(addr));
+        closesocket(sender);
+#else
+        constexpr uint64_t one = 1;
+        [[maybe_unused]] const ssize_t written = write(wakeFd, &one, sizeof(one));
+#endif
+    }
+
+    /**
+     * @brief 等待就绪事件，客户端的事件写入 ready
+     * @param timeout 最长等待时间（毫秒），-1 表示无限期等待
+     * @param acceptReady 输出：监听套接字上是否有待接受的连接
+     * @return bool 等待是否成功，被信号打断视为成功
+     * @note 唤醒事件在这里读出后丢弃，调用方只需检查 stopRequested
+     */
+    bool PollServer::Wait(const int timeout, bool &acceptReady) {
+        ready.clear();
+        acceptReady = false;
+#ifdef _WIN32
+        const int count = WSAPoll(pollFds.data(), static_cast<ULONG>(pollFds.size()), timeout);
+        if (count == SOCKET_ERROR) {
+            return false;
+        }
+        if (count == 0) {
+            return true;
+        }
+        acceptReady = (pollFds[0].revents & POLLRDNORM) != 0;
+        if (pollFds[1].revents & POLLRDNORM) {
+            char wake[16];
+            while (recv(wakeSocket, wake, sizeof(wake), 0) > 0) {
+            }
+        }
+        for (size_t i = 2; i < pollFds.size(); i++) {
+            if (const SHORT events = pollFds[i].revents; events != 0) {
+                ready.push_back(ReadyEvent{clients[i - 2], (events & POLLRDNORM) != 0, (events & POLLWRNORM) != 0,
+                                           (events & (POLLERR | POLLHUP | POLLNVAL)) != 0});
+            }
+        }
+#else
+        epoll_event events[64];
+        const int count = epoll_wait(epollFd, events, 64, timeout);
+        if (count < 0) {
+            return errno == EINTR;
+        }
+        for (int i = 0; i < count; i++) {
+            if (events[i].data.ptr == nullptr) {
+                acceptReady = true;
+            } else if (events[i].data.ptr == &wakeFd) {
+                uint64_t value;
+                [[maybe_unused]] const ssize_t drained = read(wakeFd, &value, sizeof(value));
+            } else {
+                ready.push_back(ReadyEvent{static_cast<Client *>(events[i].data.ptr),
+                                           (events[i].events & EPOLLIN) != 0, (events[i].events & EPOLLOUT) != 0,
+                                           (events[i].events & (EPOLLERR | EPOLLHUP)) != 0});
+            }
+        }
+#endif
+        return true;
+    }
+
+    /**
+     * @brief 服务线程的事件循环
+     */
+    void PollServer::Run() {
+        std::chrono::steady_clock::time_point drainDeadline;
+        size_t drainConnections = 0;
+        while (true) {
+            if (!draining && stopRequested.load()) {
+                drainConnections = clients.size();
+                drainDeadline = std::chrono::steady_clock::now() + options.drainTimeout;
+                BeginDrain();
+            }
+
+            // 没有定时器时无限期等待，空闲的服务器不会被周期性唤醒
+            int timeout = timers.Size() == 0 ? -1 : static_cast<int>(kTimerTick.count());
+            if (draining) {
+                const auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    drainDeadline - std::chrono::steady_clock::now());
+                if (clients.empty() || remaining.count() <= 0) {
+                    break;
+                }
+                timeout = timeout < 0 ? static_cast<int>(remaining.count())
+                                      : std::min(timeout, static_cast<int>(remaining.count()));
+            }
+
+            bool acceptReady = false;
+            if (!Wait(timeout, acceptReady)) {
+                SPDLOG_ERROR("等待就绪事件失败，Socket 服务线程退出");
+                break;
+            }
+
+            for (const ReadyEvent &event : ready) {
+                Client *client = event.client;
+                // 同一轮中先前的事件可能已经关闭了这个客户端
+                if (client->socket == kInvalidSocket) {
+                    continue;
+                }
+                if (client->wantWrite && (event.writable || event.error)) {
+                    OnWritable(client);
+                } else if (event.readable || event.error) {
+                    OnReadable(client);
+                }
+            }
+
+            // 最后接受新连接：本轮关闭的客户端归还的 Client 不会在它剩余的事件处理完之前被复用
+            if (acceptReady && !draining) {
+                AcceptClients();
+            }
+
+            timers.Advance(std::chrono::steady_clock::now(), [this](v2_taskbar_manager::TimerNode *node) {
+                Client *client = static_cast<Client *>(node->owner);
+                SPDLOG_DEBUG("客户端{}超时关闭", client->recvBuffer.empty() ? "等待请求" : "发送请求头");
+                CloseClient(client);
+            });
+        }
+
+        // 期限到达时仍在发送响应的客户端被强制关闭
+        if (draining) {
+            SPDLOG_INFO("停止时存在 {} 个客户端，其中 {} 个没有在期限内发送完响应", drainConnections,
+                        clients.size());
+        }
+        while (!clients.empty()) {
+            CloseClient(clients.back());
+        }
+        if (listenSocket != kInvalidSocket) {
+            CloseSocket(listenSocket);
+            listenSocket = kInvalidSocket;
+        }
+    }
+
+    /**
+     * @brief 接受监听队列中的所有连接
+     * @note 客户端数达到 connectionPoolSize 时按过载策略继续接受并以 503 拒绝，或者暂停接受，新连接在监听队列中等待
+     */
+    void PollServer::AcceptClients() {
+        while (true) {
+            Client *client = pool.Acquire(options.maxRequestHeaderSize);
+            if (client == nullptr && options.overloadPolicy == v2_taskbar_manager::HttpOverloadPolicy::Defer) {
+                SetAcceptPaused(true);
+                return;
+            }
+#ifdef _WIN32
+            // 接受的套接字继承监听套接字的非阻塞模式
+            const SOCKET socket = accept(listenSocket, nullptr, nullptr);
+#else
+            const int socket = accept4(listenSocket, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+#endif
+            if (socket == kInvalidSocket) {
+                if (client != nullptr) {
+                    pool.Release(client);
+                }
+                return;
+            }
+            if (client == nullptr) {
+                RejectClient(socket);
+                continue;
+            }
+
+            client->socket = socket;
+            client->index = clients.size();
+            client->recvBuffer.clear();
+            client->parser.Reset();
+            client->response = {};
+            client->sent = 0;
+            client->wantWrite = false;
+            clients.push_back(client);
+#ifdef _WIN32
+            pollFds.push_back(WSAPOLLFD{socket, POLLRDNORM, 0});
+#else
+            epoll_event event{};
+            event.events = EPOLLIN;
+            event.data.ptr = client;
+            if (epoll_ctl(epollFd, EPOLL_CTL_ADD, socket, &event) < 0) {
+                CloseClient(client);
+                continue;
+            }
+#endif
+            timers.Schedule(&client->timer, std::chrono::steady_clock::now() + options.firstByteTimeout);
+        }
+    }
+
+    /**
+     * @brief 以 503 响应拒绝一个新连接并关闭
+     * @param socket 刚接受的非阻塞连接
+     * @note 先读走已经到达的请求数据，避免关闭时重置连接而丢失响应
+     */
+    void PollServer::RejectClient(const PollSocket socket) const {
+        char discard[2048];
+        for (int i = 0; i < 4 && recv(socket, discard, sizeof(discard), 0) > 0; i++) {
+        }
+        send(socket, overloadedResponse.data(), static_cast<int>(overloadedResponse.size()), kSendFlags);
+        shutdown(socket, kShutdownSend);
+        CloseSocket(socket);
+        SPDLOG_DEBUG("客户端数达到上限 {}，拒绝新连接", options.connectionPoolSize);
+    }
+
+    /**
+     * @brief 读取请求数据，请求完整后选定响应并开始发送
+     * @param client 可读的客户端
+     */
+    void PollServer::OnReadable(Client *client) {
+        char buffer[2048];
+        const auto count = recv(client->socket, buffer, static_cast<int>(sizeof(buffer)), 0);
+        if (count == 0 || (count < 0 && !WouldBlock())) {
+            CloseClient(client);
+            return;
+        }
+        // 已经选定响应后到达的数据不再处理
+        if (count < 0 || !client->response.empty()) {
+            return;
+        }
+
+        // 收到请求的第一个字节时开始计算请求头超时，之后的数据不再延长期限
+        if (client->recvBuffer.empty()) {
+            timers.Schedule(&client->timer, std::chrono::steady_clock::now() + options.headerTimeout);
+        }
+        client->recvBuffer.append(buffer, static_cast<size_t>(count));
+
+        // 解析器从上次停止的位置继续扫描，不再每次从头查找请求头结尾
+        const v2_taskbar_manager::HttpParseResult result = client->parser.Parse(client->recvBuffer);
+        if (result == v2_taskbar_manager::HttpParseResult::Incomplete) {
+            return;
+        }
+        if (result != v2_taskbar_manager::HttpParseResult::Complete) {
+            // 格式错误或请求头过大，直接关闭连接
+            CloseClient(client);
+            return;
+        }
+
+        const v2_taskbar_manager::HttpRequest &request = client->parser.Request();
+        SPDLOG_INFO("收到请求: Method[{}], Path[{}], Protocol[{}]", request.method, request.path, request.protocol);
+        timers.Cancel(&client->timer);
+        if (const auto route = router.Match(request.method, request.path); route.target != nullptr) {
+            client->response = *route.target;
+        } else if (route.pathMatched) {
+            client->response = methodNotAllowedResponse;
+        } else if (request.method == "GET") {
+            client->response = notFoundResponse;
+        } else {
+            client->response = notImplementedResponse;
+        }
+        client->sent = 0;
+        // 多数响应一次即可写入发送缓冲区，不必等待下一轮可写通知
+        OnWritable(client);
+    }
+
+    /**
+     * @brief 继续发送响应，发送完毕后关闭连接
+     * @param client 正在发送响应的客户端
+     */
+    void PollServer::OnWritable(Client *client) {
+        while (client->sent < client->response.size()) {
+            const auto count = send(client->socket, client->response.data() + client->sent,
+                                    static_cast<int>(client->response.size() - client->sent), kSendFlags);
+            if (count < 0) {
+                if (WouldBlock()) {
+                    WatchClient(client, true);
+                } else {
+                    CloseClient(client);
+                }
+                return;
+            }
+            client->sent += static_cast<size_t>(count);
+        }
+        CloseClient(client);
+    }
+
+    /**
+     * @brief 切换客户端关注的事件
+     * @param client 客户端
+     * @param write 为 true 时等待可写，否则等待可读
+     */
+    void PollServer::WatchClient(Client *client, const bool write) {
+        if (client->wantWrite == write) {
+            return;
+        }
+        client->wantWrite = write;
+#ifdef _WIN32
+        pollFds[client->index + 2].events = write ? POLLWRNORM : POLLRDNORM;
+#else
+        epoll_event event{};
+        event.events = write ? EPOLLOUT : EPOLLIN;
+        event.data.ptr = client;
+        epoll_ctl(epollFd, EPOLL_CTL_MOD, client->socket, &event);
+#endif
+    }
+
+    /**
+     * @brief 暂停或恢复接受新连接
+     * @param paused 是否暂停
+     */
+    void PollServer::SetAcceptPaused(const bool paused) {
+        if (acceptPaused == paused || listenSocket == kInvalidSocket) {
+            return;
+        }
+        acceptPaused = paused;
+#ifdef _WIN32
+        // WSAPoll 忽略描述符为负值（INVALID_SOCKET）的项
+        pollFds[0].fd = paused ? INVALID_SOCKET : listenSocket;
+#else
+        epoll_event event{};
+        event.events = paused ? 0u : static_cast<uint32_t>(EPOLLIN);
+        event.data.ptr = nullptr;
+        epoll_ctl(epollFd, EPOLL_CTL_MOD, listenSocket, &event);
+#endif
+    }
+
+    /**
+     * @brief 关闭客户端并归还 Client
+     * @param client 客户端，以 clients 末尾的元素填补它的位置
+     */
+    void PollServer::CloseClient(Client *client) {
+        timers.Cancel(&client->timer);
+        shutdown(client->socket, kShutdownSend);
+        // 关闭套接字时 epoll 自动移除它的登记
+        CloseSocket(client->socket);
+        client->socket = kInvalidSocket;
+
+        const size_t index = client->index;
+        clients[index] = clients.back();
+        clients[index]->index = index;
+        clients.pop_back();
+#ifdef _WIN32
+        pollFds[index + 2] = pollFds.back();
+        pollFds.pop_back();
+#endif
+        pool.Release(client);
+        if (!draining) {
+            SetAcceptPaused(false);
+        }
+    }
+
+    /**
+     * @brief 开始停止：关闭监听套接字，立即关闭还没有收到完整请求的客户端
+     */
+    void PollServer::BeginDrain() {
+        draining = true;
+#ifdef _WIN32
+        pollFds[0].fd = INVALID_SOCKET;
+#endif
+        // 监听队列中尚未接受的连接随监听套接字的关闭被重置，关闭时 epoll 自动移除它的登记
+        CloseSocket(listenSocket);
+        listenSocket = kInvalidSocket;
+
+        std::vector<Client *> waiting;
+        for (Client *client : clients) {
+            if (client->response.empty()) {
+                waiting.push_back(client);
+            }
+        }
+        for (Client *client : waiting) {
+            CloseClient(client);
+        }
+    }
+}
@@ -0,0 +1,80 @@
+#include "ProcessInfoCache.h"
+
+#include <algorithm>
+
+namespace v1_taskbar_manager {
+    ProcessInfoCache::ProcessInfoCache(ProcessInfoSource &source, const size_t capacity)
+        : source(source), capacity(std::max<size_t>(capacity, 1)) {
+    }
+
+    ProcessInfoCache::~ProcessInfoCache() {
+        Clear();
+    }
+
+    /**
+     * @brief 查找进程信息，未缓存或进程已经退出时从进程信息源读取
+     * @param processId 进程 ID
+     * @return const ProcessInfo* 无法打开进程时返回 nullptr（不缓存失败的结果），指针在下一次调用之前有效
+     */
+    const ProcessInfo *ProcessInfoCache::Lookup(const std::uint32_t processId) {
+        if (const auto it = index.find(processId); it != index.end()) {
+            if (!source.HasExited(it->second->token)) {
+                stats.hits++;
+                entries.splice(entries.begin(), entries, it->second);
+                return &entries.front().info;
+            }
+            stats.exits++;
+            Erase(it->second);
+        }
+
+        stats.misses++;
+        Entry entry;
+        if (!source.Open(processId, entry.info, entry.token)) {
+            return nullptr;
+        }
+        entry.info.processId = processId;
+        entries.push_front(std::move(entry));
+        index[processId] = entries.begin();
+        if (entries.size() > capacity) {
+            stats.evictions++;
+            Erase(std::prev(entries.end()));
+        }
+        return &entries.front().info;
+    }
+
+    /**
+     * @brief 移除所有进程已经退出的条目，释放它们持有的进程引用
+     * @return size_t 移除的条目数
+     */
+    size_t ProcessInfoCache::Sweep() {
+        size_t removed = 0;
+        for (auto it = entries.begin(); it != entries.end();) {
+            const auto next = std::next(it);
+            if (source.HasExited(it->token)) {
+                Erase(it);
+                removed++;
+            }
+            it = next;
+        }
+        stats.exits += removed;
+        return removed;
+    }
+
+    void ProcessInfoCache::Clear() {
+        while (!entries.empty()) {
+            Erase(entries.begin());
+        }
+    }
+
+    ProcessInfoCacheStats ProcessInfoCache::Stats() const {
+        ProcessInfoCacheStats result = stats;
+        result.size = entries.size();
+        return result;
+    }
+
+    void ProcessInfoCache::Erase(const std::list<Entry>::iterator entry) {
+        source.Close(entry->token);
+        index.erase(entry->info.processId);
+        entries.erase(entry);
+    }
+}
@@ -0,0 +1,101 @@
+#include "ScriptedWindowEventSource.h"
+
+#include <cstdio>
+
+namespace v1_taskbar_manager {
+    /**
+     * @brief 创建一个窗口
+     * @param record 窗口信息，handle 为 0 时分配一个新句柄，handleText 由句柄生成
+     * @param shown 是否可见，只有可见且有标题的窗口才应在任务栏显示
+     * @param notify 是否投递 Created 事件
+     * @return WindowHandle 窗口句柄
+     */
+    WindowHandle ScriptedWindowEventSource::Create(WindowRecord record, const bool shown, const bool notify) {
+        if (record.handle == 0) {
+            record.handle = nextHandle;
+            nextHandle += 0x10;
+        }
+        char text[2 + sizeof(WindowHandle) * 2 + 1];
+        std::snprintf(text, sizeof(text), "0x%llX", static_cast<unsigned long long>(record.handle));
+        record.handleText = text;
+        const WindowHandle handle = record.handle;
+        windows[handle] = Window{std::move(record), shown};
+        Notify(WindowEventKind::Created, handle, notify);
+        return handle;
+    }
+
+    void ScriptedWindowEventSource::Destroy(const WindowHandle handle, const bool notify) {
+        windows.erase(handle);
+        Notify(WindowEventKind::Destroyed, handle, notify);
+    }
+
+    void ScriptedWindowEventSource::Show(const WindowHandle handle, const bool notify) {
+        if (const auto it = windows.find(handle); it != windows.end()) {
+            it->second.shown = true;
+        }
+        Notify(WindowEventKind::Shown, handle, notify);
+    }
+
+    void ScriptedWindowEventSource::Hide(const WindowHandle handle, const bool notify) {
+        if (const auto it = windows.find(handle); it != windows.end()) {
+            it->second.shown = false;
+        }
+        Notify(WindowEventKind::Hidden, handle, notify);
+    }
+
+    void ScriptedWindowEventSource::Rename(const WindowHandle handle, std::string title, const bool notify) {
+        if (const auto it = windows.find(handle); it != windows.end()) {
+            it->second.record.title = std::move(title);
+        }
+        Notify(WindowEventKind::NameChanged, handle, notify);
+    }
+
+    void ScriptedWindowEventSource::SetMinimized(const WindowHandle handle, const bool minimized, const bool notify) {
+        if (const auto it = windows.find(handle); it != windows.end()) {
+            it->second.record.isMinimized = minimized;
+        }
+        Notify(WindowEventKind::StateChanged, handle, notify);
+    }
+
+    void ScriptedWindowEventSource::Emit(const WindowEvent &event) const {
+        if (sink) {
+            sink(event);
+        }
+    }
+
+    std::vector<WindowRecord> ScriptedWindowEventSource::Snapshot() {
+        std::vector<WindowRecord> records;
+        for (const auto &[handle, window] : windows) {
+            if (window.shown && !window.record.title.empty()) {
+                records.push_back(window.record);
+            }
+        }
+        return records;
+    }
+
+    bool ScriptedWindowEventSource::Describe(const WindowHandle handle, WindowRecord &record) {
+        describeCalls++;
+        const auto it = windows.find(handle);
+        if (it == windows.end() || !it->second.shown || it->second.record.title.empty()) {
+            return false;
+        }
+        record = it->second.record;
+        return true;
+    }
+
+    bool ScriptedWindowEventSource::Subscribe(Sink sink) {
+        this->sink = std::move(sink);
+        return true;
+    }
+
+    void ScriptedWindowEventSource::Unsubscribe() {
+        sink = nullptr;
+    }
+
+    void ScriptedWindowEventSource::Notify(const WindowEventKind kind, const WindowHandle handle,
+                                           const bool notify) const {
+        if (notify) {
+            Emit(WindowEvent{kind, handle});
+        }
+    }
+}
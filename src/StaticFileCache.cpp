@@ -0,0 +1,258 @@
+#include "StaticFileCache.h"
+
+#include <cstdio>
+#include <system_error>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "HttpRequestParser.h"
+#include "spdlog/spdlog.h"
+
+namespace v2_taskbar_manager {
+    namespace {
+        // 缓存的文件超过该时间未检查时，重新读取文件属性判断是否已变化
+        constexpr std::chrono::seconds kRevalidateInterval{1};
+        // 缓存的文件数上限，超过时清空缓存（前端资源通常远少于此数量）
+        constexpr size_t kMaxEntries = 256;
+
+        struct MimeType {
+            std::string_view extension;
+            std::string_view contentType;
+        };
+
+        constexpr MimeType kMimeTypes[] = {
+            {".html", "text/html; charset=utf-8"},
+            {".htm", "text/html; charset=utf-8"},
+            {".js", "text/javascript; charset=utf-8"},
+            {".mjs", "text/javascript; charset=utf-8"},
+            {".css", "text/css; charset=utf-8"},
+            {".json", "application/json; charset=utf-8"},
+            {".map", "application/json; charset=utf-8"},
+            {".txt", "text/plain; charset=utf-8"},
+            {".svg", "image/svg+xml"},
+            {".png", "image/png"},
+            {".jpg", "image/jpeg"},
+            {".jpeg", "image/jpeg"},
+            {".gif", "image/gif"},
+            {".webp", "image/webp"},
+            {".ico", "image/x-icon"},
+            {".woff", "font/woff"},
+            {".woff2", "font/woff2"},
+            {".ttf", "font/ttf"},
+            {".wasm", "application/wasm"},
+        };
+
+        /**
+         * @brief 根据扩展名获取 Content-Type
+         * @param path 请求路径
+         * @return std::string_view 未知扩展名返回 application/octet-stream
+         */
+        std::string_view ContentTypeOf(std::string_view path) {
+            const size_t slash = path.rfind('/');
+            const size_t dot = path.rfind('.');
+            if (dot != std::string_view::npos && (slash == std::string_view::npos || dot > slash)) {
+                const std::string_view extension = path.substr(dot);
+                for (const MimeType &mime : kMimeTypes) {
+                    if (EqualsIgnoreCase(extension, mime.extension)) {
+                        return mime.contentType;
+                    }
+                }
+            }
+            return "application/octet-stream";
+        }
+
+        /**
+         * @brief 检查请求路径是否只会访问资源目录内的文件
+         * @note 拒绝 ".." 路径段、反斜杠、盘符与控制字符；不做百分号解码
+         */
+        bool IsSafePath(std::string_view path) {
+            if (path.empty() || path.front() != '/') {
+                return false;
+            }
+            for (const char c : path) {
+                if (c == '\\' || c == ':' || static_cast<unsigned char>(c) < 0x20) {
+                    return false;
+                }
+            }
+            while (!path.empty()) {
+                path.remove_prefix(1);
+                const size_t next = path.find('/');
+                if (path.substr(0, next) == "..") {
+                    return false;
+                }
+                path = next == std::string_view::npos ? std::string_view() : path.substr(next);
+            }
+            return true;
+        }
+    }
+
+    StaticFile::~StaticFile() {
+#ifdef _WIN32
+        if (view != nullptr) {
+            UnmapViewOfFile(view);
+        }
+        if (mapping != nullptr) {
+            CloseHandle(mapping);
+        }
+        if (handle != nullptr) {
+            CloseHandle(handle);
+        }
+#else
+        if (view != nullptr) {
+            munmap(const_cast<char *>(view), size);
+        }
+        if (fd != -1) {
+            close(fd);
+        }
+#endif
+    }
+
+    /**
+     * @param root 资源目录
+     * @param cacheControl 完整的 Cache-Control 头部行，以 CRLF 结尾
+     * @param zeroCopyThreshold 不小于该大小的文件不做内存映射，以 TransmitFile/sendfile 发送
+     */
+    StaticFileCache::StaticFileCache(std::filesystem::path root, std::string cacheControl,
+                                     const size_t zeroCopyThreshold)
+        : root(std::move(root)), cacheControl(std::move(cacheControl)), zeroCopyThreshold(zeroCopyThreshold) {
+    }
+
+    /**
+     * @brief 查找请求路径对应的文件
+     * @param path 请求路径，查询字符串会被忽略，以 "/" 结尾时查找目录下的 index.html
+     * @return std::shared_ptr<const StaticFile> 文件不存在、不是普通文件或路径不安全时返回 nullptr
+     */
+    std::shared_ptr<const StaticFile> StaticFileCache::Lookup(std::string_view path) {
+        path = path.substr(0, path.find('?'));
+        if (!IsSafePath(path)) {
+            return nullptr;
+        }
+
+        // 每个线程复用同一个键缓冲区，命中缓存时不产生分配
+        thread_local std::string key;
+        key.assign(path.data(), path.size());
+        if (key.back() == '/') {
+            key += "index.html";
+        }
+
+        const auto now = std::chrono::steady_clock::now();
+        std::shared_ptr<const StaticFile> cached;
+        {
+            std::lock_guard lock(mutex);
+            if (const auto it = entries.find(key); it != entries.end()) {
+                if (now - it->second.checkedAt < kRevalidateInterval) {
+                    return it->second.file;
+                }
+                cached = it->second.file;
+            }
+        }
+
+        // 文件属性的读取与文件的打开都在锁外进行，避免阻塞其他连接的缓存命中
+        const std::filesystem::path fullPath = root / std::filesystem::u8path(key.substr(1));
+        std::error_code error;
+        const auto lastWriteTime = std::filesystem::last_write_time(fullPath, error);
+        const uint64_t size = error ? 0 : std::filesystem::file_size(fullPath, error);
+        std::shared_ptr<const StaticFile> file;
+        if (error) {
+            file = nullptr;
+        } else if (cached && cached->lastWriteTime == lastWriteTime && cached->size == size) {
+            file = std::move(cached);
+        } else {
+            file = Open(fullPath, key);
+        }
+
+        std::lock_guard lock(mutex);
+        if (!file) {
+            entries.erase(key);
+            return nullptr;
+        }
+        if (entries.size() >= kMaxEntries && entries.find(key) == entries.end()) {
+            entries.clear();
+        }
+        entries[key] = Entry{file, now};
+        return file;
+    }
+
+    /**
+     * @brief 打开文件，小文件映射到内存，并构建响应头部
+     * @param fullPath 文件的完整路径
+     * @param path 请求路径，用于确定 Content-Type
+     * @return std::shared_ptr<const StaticFile> 打开失败或不是普通文件时返回 nullptr
+     */
+    std::shared_ptr<const StaticFile> StaticFileCache::Open(const std::filesystem::path &fullPath,
+                                                            std::string_view path) const {
+        std::error_code error;
+        if (!std::filesystem::is_regular_file(fullPath, error)) {
+            return nullptr;
+        }
+
+        auto file = std::make_shared<StaticFile>();
+        file->lastWriteTime = std::filesystem::last_write_time(fullPath, error);
+#ifdef _WIN32
+        const HANDLE handle = CreateFileW(fullPath.c_str(), GENERIC_READ,
+                                          FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr,
+                                          OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (handle == INVALID_HANDLE_VALUE) {
+            return nullptr;
+        }
+        file->handle = handle;
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(handle, &size)) {
+            return nullptr;
+        }
+        file->size = static_cast<uint64_t>(size.QuadPart);
+        if (file->size > 0 && file->size < zeroCopyThreshold) {
+            file->mapping = CreateFileMappingW(handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (file->mapping == nullptr) {
+                return nullptr;
+            }
+            file->view = static_cast<const char *>(MapViewOfFile(file->mapping, FILE_MAP_READ, 0, 0, 0));
+            if (file->view == nullptr) {
+                return nullptr;
+            }
+        }
+#else
+        file->fd = open(fullPath.c_str(), O_RDONLY | O_CLOEXEC);
+        if (file->fd == -1) {
+            return nullptr;
+        }
+        struct stat status{};
+        if (fstat(file->fd, &status) == -1) {
+            return nullptr;
+        }
+        file->size = static_cast<uint64_t>(status.st_size);
+        if (file->size > 0 && file->size < zeroCopyThreshold) {
+            void *view = mmap(nullptr, file->size, PROT_READ, MAP_PRIVATE, file->fd, 0);
+            if (view == MAP_FAILED) {
+                return nullptr;
+            }
+            file->view = static_cast<const char *>(view);
+        }
+#endif
+
+        // 弱实体标签由大小与修改时间组成，文件替换后自然失效
+        char etag[64];
+        std::snprintf(etag, sizeof(etag), "W/\"%llx-%llx\"", static_cast<unsigned long long>(file->size),
+                      static_cast<unsigned long long>(file->lastWriteTime.time_since_epoch().count()));
+        file->etag = etag;
+
+        const std::string validators = "ETag: " + file->etag + "\r\n" + cacheControl;
+        const std::string ok = "HTTP/1.1 200 OK\r\nContent-Type: " + std::string(ContentTypeOf(path)) +
+                               "\r\nContent-Length: " + std::to_string(file->size) + "\r\n" + validators;
+        const std::string notModified = "HTTP/1.1 304 Not Modified\r\n" + validators;
+        file->keepAliveHeader = ok + "Connection: keep-alive\r\n\r\n";
+        file->closeHeader = ok + "Connection: close\r\n\r\n";
+        file->notModifiedKeepAliveHeader = notModified + "Connection: keep-alive\r\n\r\n";
+        file->notModifiedCloseHeader = notModified + "Connection: close\r\n\r\n";
+
+        SPDLOG_DEBUG("打开静态文件: {}, {} 字节, {}", path, file->size, file->IsMapped() ? "内存映射" : "零拷贝发送");
+        return file;
+    }
+}
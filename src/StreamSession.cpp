@@ -0,0 +1,78 @@
+#include "StreamSession.h"
+
+namespace v2_taskbar_manager {
+    /**
+     * @brief 尝试成为发送者，把排队的数据编码到 writing
+     * @return 没有待发送的数据或已有发送者时返回 false
+     */
+    bool StreamSession::BeginWrite() {
+        std::lock_guard lock(mutex);
+        notified = false;
+        if (sending || !HasPendingLocked()) {
+            return false;
+        }
+        FillLocked();
+        sending = true;
+        return true;
+    }
+
+    /**
+     * @brief 记录发送进度
+     * @param bytes 本次发送的字节数
+     * @return 还有数据需要发送时返回 true（包括发送期间新排队的数据），否则放弃发送者身份并返回 false
+     */
+    bool StreamSession::OnWritten(const size_t bytes) {
+        written += bytes;
+        if (written < writing.size()) {
+            return true;
+        }
+        writing.clear();
+        written = 0;
+
+        std::lock_guard lock(mutex);
+        if (closeInWriting) {
+            closeSent = true;
+            sending = false;
+            return false;
+        }
+        if (HasPendingLocked()) {
+            FillLocked();
+            return true;
+        }
+        sending = false;
+        return false;
+    }
+
+    /**
+     * @brief 获取订阅时登记的所属对象（后端的连接上下文）
+     * @return void* 已分离时返回 nullptr
+     */
+    void *StreamSession::Owner() const {
+        std::lock_guard lock(mutex);
+        return owner;
+    }
+
+    /**
+     * @brief 从广播中心移除，连接关闭时调用
+     * @note 返回之后不会再调用通知回调
+     */
+    void StreamSession::Detach() {
+        Unsubscribe();
+        std::lock_guard lock(mutex);
+        owner = nullptr;
+        notify = nullptr;
+        closing = true;
+        ClearLocked();
+    }
+
+    /**
+     * @brief 有数据待发送且没有发送者时通知后端，调用方持有 mutex
+     * @note 在下一次 BeginWrite 之前只通知一次
+     */
+    void StreamSession::NotifyLocked() {
+        if (!sending && !notified && notify) {
+            notified = true;
+            notify(*this);
+        }
+    }
+}
@@ -0,0 +1,49 @@
+#include "StringPool.h"
+
+#include <algorithm>
+#include <functional>
+
+namespace v1_taskbar_manager {
+    /**
+     * @brief 取得字符串的下标，池中没有时追加
+     * @param value 字符串
+     * @return uint32_t 下标，相同的字符串得到相同的下标，在 Clear 之前有效
+     */
+    uint32_t StringPool::Intern(const std::string_view value) {
+        // 负载不超过一半，探测序列保持很短
+        if ((Size() + 1) * 2 > slots.size()) {
+            Grow();
+        }
+        const size_t mask = slots.size() - 1;
+        size_t slot = std::hash<std::string_view>{}(value) & mask;
+        while (slots[slot] != 0) {
+            if (const uint32_t id = slots[slot] - 1; Get(id) == value) {
+                return id;
+            }
+            slot = (slot + 1) & mask;
+        }
+        const auto id = static_cast<uint32_t>(Size());
+        text.append(value);
+        offsets.push_back(static_cast<uint32_t>(text.size()));
+        slots[slot] = id + 1;
+        return id;
+    }
+
+    void StringPool::Clear() {
+        text.clear();
+        offsets.resize(1);
+        std::fill(slots.begin(), slots.end(), 0);
+    }
+
+    void StringPool::Grow() {
+        slots.assign(std::max<size_t>(slots.size() * 2, 16), 0);
+        const size_t mask = slots.size() - 1;
+        for (uint32_t id = 0; id < Size(); id++) {
+            size_t slot = std::hash<std::string_view>{}(Get(id)) & mask;
+            while (slots[slot] != 0) {
+                slot = (slot + 1) & mask;
+            }
+            slots[slot] = id + 1;
+        }
+    }
+}
@@ -0,0 +1,252 @@
+#include "SyntheticWindowSource.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace v1_taskbar_manager {
+    namespace {
+        // WS_OVERLAPPEDWINDOW 与 WS_VISIBLE
+        constexpr std::uint32_t kOverlappedWindow = 0x00CF0000;
+        constexpr std::uint32_t kVisible = 0x10000000;
+
+        const char *const kClassNames[] = {
+            "Chrome_WidgetWin_1", "CabinetWClass", "Notepad", "ConsoleWindowClass", "OpusApp", "XLMAIN",
+            "PPTFrameClass", "MozillaWindowClass", "SunAwtFrame", "Qt5152QWindowIcon",
+            "WindowsForms10.Window.8.app.0.141b42a_r6_ad1", "HwndWrapper[DefaultDomain;;]", "TscShellContainerClass",
+            "CASCADIA_HOSTING_WINDOW_CLASS", "WeChatMainWndForPC",
+            // 以下两个系统窗口类被任务栏过滤排除，只在 systemClassRatio 命中时使用
+            "Windows.UI.Core.CoreWindow", "ApplicationFrameWindow",
+        };
+        constexpr size_t kSystemClassCount = 2;
+        constexpr size_t kClassCount = sizeof(kClassNames) / sizeof(kClassNames[0]) - kSystemClassCount;
+
+        const char *const kProcessNames[] = {
+            "chrome.exe", "msedge.exe", "explorer.exe", "notepad.exe", "WINWORD.EXE", "EXCEL.EXE", "POWERPNT.EXE",
+            "firefox.exe", "idea64.exe", "clion64.exe", "Code.exe", "WindowsTerminal.exe", "mstsc.exe", "WeChat.exe",
+            "QQ.exe", "DingTalk.exe", "Feishu.exe", "Typora.exe", "obs64.exe", "vlc.exe",
+        };
+        constexpr size_t kProcessNameCount = sizeof(kProcessNames) / sizeof(kProcessNames[0]);
+
+        const char *const kAsciiWords[] = {
+            "Report", "Inbox", "Pull request", "README.md", "Settings", "Downloads", "main.cpp", "Meeting notes",
+            "Dashboard", "Untitled", "Release", "Invoice",
+        };
+        const char *const kMixedWords[] = {
+            "新建文本文档", "季度报告", "会议纪要", "下载", "設定", "ダウンロード", "보고서", "Документ", "Настройки",
+            "تقرير", "Σύσκεψη", "📁 Projects", "🎵 Playlist", "Report", "Inbox", "README.md",
+        };
+        constexpr size_t kAsciiWordCount = sizeof(kAsciiWords) / sizeof(kAsciiWords[0]);
+        constexpr size_t kMixedWordCount = sizeof(kMixedWords) / sizeof(kMixedWords[0]);
+
+        constexpr std::uint32_t kFirstProcessId = 1000;
+    }
+
+    SyntheticWindowSource::SyntheticWindowSource(const SyntheticWindowOptions &options)
+        : options(options), state(options.seed * 0x9E3779B97F4A7C15ULL | 1) {
+        windows.reserve(options.windowCount);
+        index.reserve(options.windowCount);
+        for (size_t position = 0; position < options.windowCount; position++) {
+            windows.push_back(MakeWindow(position));
+            index.emplace(windows.back().handle, position);
+        }
+    }
+
+    /**
+     * @brief 按 churnRate 随机修改一批窗口
+     * @return size_t 修改的窗口数
+     * @note 替换的窗口在原来的 Z 序位置上以新句柄出现，相当于旧窗口销毁、新窗口创建
+     */
+    size_t SyntheticWindowSource::Churn() {
+        if (windows.empty() || options.churnRate <= 0) {
+            return 0;
+        }
+        const auto changes = std::max<size_t>(
+            1, static_cast<size_t>(std::lround(options.churnRate * static_cast<double>(windows.size()))));
+        for (size_t i = 0; i < changes; i++) {
+            const size_t position = Next() % windows.size();
+            Window &window = windows[position];
+            switch (Next() % 4) {
+                case 0:
+                case 1:
+                    index.erase(window.handle);
+                    window = MakeWindow(position);
+                    index.emplace(window.handle, position);
+                    break;
+                case 2:
+                    window.title = MakeTitle();
+                    break;
+                default:
+                    window.minimized = !window.minimized;
+                    break;
+            }
+        }
+        return changes;
+    }
+
+    bool SyntheticWindowSource::EnumerateTopLevel(const Visitor &visitor) {
+        for (const Window &window : windows) {
+            if (!visitor(window.handle)) {
+                break;
+            }
+        }
+        return true;
+    }
+
+    bool SyntheticWindowSource::IsWindow(const WindowHandle handle) {
+        return Find(handle) != nullptr;
+    }
+
+    bool SyntheticWindowSource::IsVisible(const WindowHandle handle) {
+        const Window *window = Find(handle);
+        return window != nullptr && window->visible;
+    }
+
+    bool SyntheticWindowSource::Styles(const WindowHandle handle, std::uint32_t &style, std::uint32_t &exStyle) {
+        const Window *window = Find(handle);
+        if (window == nullptr) {
+            return false;
+        }
+        style = window->style;
+        exStyle = window->exStyle;
+        return true;
+    }
+
+    WindowHandle SyntheticWindowSource::Parent(const WindowHandle handle) {
+        // 与 GetParent 一致：有拥有者的弹出窗口返回拥有者
+        const Window *window = Find(handle);
+        return window == nullptr ? 0 : window->owner;
+    }
+
+    WindowHandle SyntheticWindowSource::Owner(const WindowHandle handle) {
+        const Window *window = Find(handle);
+        return window == nullptr ? 0 : window->owner;
+    }
+
+    size_t SyntheticWindowSource::TitleLength(const WindowHandle handle) {
+        const Window *window = Find(handle);
+        return window == nullptr ? 0 : window->title.size();
+    }
+
+    std::string SyntheticWindowSource::Title(const WindowHandle handle) {
+        const Window *window = Find(handle);
+        return window == nullptr ? std::string() : window->title;
+    }
+
+    std::string SyntheticWindowSource::ClassName(const WindowHandle handle) {
+        const Window *window = Find(handle);
+        return window == nullptr ? std::string() : kClassNames[window->className];
+    }
+
+    bool SyntheticWindowSource::IsMinimized(const WindowHandle handle) {
+        const Window *window = Find(handle);
+        return window != nullptr && window->minimized;
+    }
+
+    bool SyntheticWindowSource::IsMaximized(const WindowHandle handle) {
+        const Window *window = Find(handle);
+        return window != nullptr && window->maximized;
+    }
+
+    std::uint32_t SyntheticWindowSource::ProcessId(const WindowHandle handle) {
+        const Window *window = Find(handle);
+        return window == nullptr ? 0 : window->processId;
+    }
+
+    std::string SyntheticWindowSource::ProcessName(const std::uint32_t processId) {
+        processOpens++;
+        const std::uint32_t process = (processId - kFirstProcessId) / 4;
+        if (processId < kFirstProcessId || process >= options.processCount) {
+            return "Unknown";
+        }
+        return kProcessNames[process % kProcessNameCount];
+    }
+
+    bool SyntheticWindowSource::Open(const std::uint32_t processId, ProcessInfo &info, std::uintptr_t &token) {
+        processOpens++;
+        const std::uint32_t process = (processId - kFirstProcessId) / 4;
+        if (processId < kFirstProcessId || process >= options.processCount) {
+            return false;
+        }
+        info.processId = processId;
+        info.creationTime = 0x01DB000000000000ULL + process;
+        info.name = kProcessNames[process % kProcessNameCount];
+        token = processId;
+        return true;
+    }
+
+    bool SyntheticWindowSource::HasExited(std::uintptr_t) {
+        return false;
+    }
+
+    void SyntheticWindowSource::Close(std::uintptr_t) {
+    }
+
+    // xorshift64，结果只取决于种子与调用顺序
+    std::uint64_t SyntheticWindowSource::Next() {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    }
+
+    bool SyntheticWindowSource::Chance(const double ratio) {
+        return static_cast<double>(Next() >> 11) * 0x1.0p-53 < ratio;
+    }
+
+    const SyntheticWindowSource::Window *SyntheticWindowSource::Find(const WindowHandle handle) const {
+        const auto it = index.find(handle);
+        return it == index.end() ? nullptr : &windows[it->second];
+    }
+
+    /**
+     * @brief 生成一个窗口
+     * @param position 窗口在 Z 序中的位置，拥有者只从它之前的窗口中选取
+     */
+    SyntheticWindowSource::Window SyntheticWindowSource::MakeWindow(const size_t position) {
+        Window window;
+        window.handle = nextHandle;
+        nextHandle += 0x1A;
+        window.visible = !Chance(options.hiddenRatio);
+        window.style = kOverlappedWindow | (window.visible ? kVisible : 0);
+        if (Chance(options.toolWindowRatio)) {
+            window.exStyle |= WindowExStyleToolWindow;
+        }
+        if (Chance(options.appWindowRatio)) {
+            window.exStyle |= WindowExStyleAppWindow;
+        }
+        if (Chance(options.noActivateRatio)) {
+            window.exStyle |= WindowExStyleNoActivate;
+        }
+        if (position > 0 && Chance(options.ownedRatio)) {
+            window.owner = windows[Next() % position].handle;
+        }
+        const size_t processCount = std::max<size_t>(options.processCount, 1);
+        const auto process = static_cast<std::uint32_t>(Next() % processCount);
+        window.processId = kFirstProcessId + process * 4;
+        // 同一进程的窗口大多使用同一个类名
+        window.className = Chance(options.systemClassRatio)
+                               ? static_cast<std::uint32_t>(kClassCount + Next() % kSystemClassCount)
+                               : static_cast<std::uint32_t>((process + Next() % 2) % kClassCount);
+        window.minimized = Chance(options.minimizedRatio);
+        window.maximized = !window.minimized && Chance(options.maximizedRatio);
+        if (!Chance(options.untitledRatio)) {
+            window.title = MakeTitle();
+        }
+        return window;
+    }
+
+    std::string SyntheticWindowSource::MakeTitle() {
+        std::string title;
+        const size_t words = 1 + Next() % 3;
+        for (size_t i = 0; i < words; i++) {
+            if (i > 0) {
+                title.push_back(' ');
+            }
+            title.append(options.mixedScripts ? kMixedWords[Next() % kMixedWordCount]
+                                              : kAsciiWords[Next() % kAsciiWordCount]);
+        }
+        // 序号使标题基本不重复
+        title.append(" (").append(std::to_string(++titleSerial)).append(")");
+        return title;
+    }
+}
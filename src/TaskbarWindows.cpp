@@ -0,0 +1,134 @@
+#include "TaskbarWindows.h"
+
+#include <cstdio>
+
+#include "spdlog/spdlog.h"
+
+namespace v1_taskbar_manager {
+    /**
+     * @brief 枚举所有任务栏窗口
+     * @param source 窗口源
+     * @param processes 进程信息缓存，为空时每个窗口都重新读取进程名
+     * @return 按枚举顺序（Z 序）排列的任务栏窗口
+     */
+    std::vector<WindowRecord> TaskbarWindows::GetTaskbarWindows(WindowSource &source, ProcessInfoCache *processes) {
+        std::vector<WindowRecord> windows;
+        const bool enumerated = source.EnumerateTopLevel([&](const WindowHandle handle) {
+            if (WindowRecord record; QueryWindow(source, handle, record, processes)) {
+                windows.push_back(std::move(record));
+            }
+            return true;
+        });
+        if (!enumerated) {
+            SPDLOG_ERROR("枚举窗口失败");
+        }
+        return windows;
+    }
+
+    /**
+     * @brief 读取一个窗口的信息
+     * @param source 窗口源
+     * @param handle 窗口句柄
+     * @param record 输出：窗口信息
+     * @param processes 进程信息缓存，同一进程的多个窗口只读取一次进程名；为空时每次重新读取
+     * @return 窗口应在任务栏显示时返回 true，否则返回 false 且不修改 record
+     * @note 枚举与窗口事件源共用
+     */
+    bool TaskbarWindows::QueryWindow(WindowSource &source, const WindowHandle handle, WindowRecord &record,
+                                     ProcessInfoCache *processes) {
+        // 检查是否应该在任务栏显示
+        if (!ShouldShowInTaskbar(source, handle)) {
+            return false;
+        }
+
+        record.handle = handle;
+        char handleText[2 + sizeof(WindowHandle) * 2 + 1];
+        std::snprintf(handleText, sizeof(handleText), "0x%llX", static_cast<unsigned long long>(handle));
+        record.handleText = handleText;
+
+        // 获取窗口标题
+        record.title = source.TitleLength(handle) > 0 ? source.Title(handle) : "(无标题)";
+
+        // 获取窗口类名
+        record.className = source.ClassName(handle);
+
+        // 获取窗口状态
+        record.isMinimized = source.IsMinimized(handle);
+        record.isMaximized = source.IsMaximized(handle);
+
+        // 获取进程ID和进程名
+        record.processId = source.ProcessId(handle);
+        if (processes == nullptr) {
+            record.processName = source.ProcessName(record.processId);
+        } else if (const ProcessInfo *process = processes->Lookup(record.processId); process != nullptr) {
+            record.processName = process->name;
+        } else {
+            record.processName = "Unknown";
+        }
+        return true;
+    }
+
+    /**
+     * @brief 判断窗口是否应该在任务栏显示
+     * @param source 窗口源
+     * @param handle 窗口句柄
+     * @return 若窗口应该在任务栏显示则返回true，否则返回false
+     * @note 考虑窗口可见性、样式、父窗口等因素
+     */
+    bool TaskbarWindows::ShouldShowInTaskbar(WindowSource &source, const WindowHandle handle) {
+        // 基本有效性检查
+        if (handle == 0 || !source.IsWindow(handle)) {
+            return false;
+        }
+
+        // 检查窗口是否可见
+        if (!source.IsVisible(handle)) {
+            return false;
+        }
+
+        // 获取窗口样式
+        std::uint32_t style, exStyle;
+        if (!source.Styles(handle, style, exStyle)) {
+            return false;
+        }
+
+        // 排除工具窗口（除非有 WS_EX_APPWINDOW 样式）
+        if (exStyle & WindowExStyleToolWindow && !(exStyle & WindowExStyleAppWindow)) {
+            return false;
+        }
+
+        // 排除 NoActivate 窗口（通常是通知、弹出窗口等）
+        if (exStyle & WindowExStyleNoActivate) {
+            return false;
+        }
+
+        // 检查是否有父窗口（排除子窗口和拥有者窗口）
+        const WindowHandle parent = source.Parent(handle);
+        if (parent != 0 && parent != source.Desktop()) {
+            return false;
+        }
+
+        // 如果有拥有者窗口且没有 WS_EX_APPWINDOW 样式，通常不在任务栏显示
+        if (source.Owner(handle) != 0 && !(exStyle & WindowExStyleAppWindow)) {
+            return false;
+        }
+
+        // 如果有 WS_EX_APPWINDOW 样式，即使没有标题也显示
+        if (exStyle & WindowExStyleAppWindow) {
+            return true;
+        }
+
+        // 必须有标题才显示
+        if (source.TitleLength(handle) == 0) {
+            return false;
+        }
+
+        // 排除一些系统窗口类
+        const std::string className = source.ClassName(handle);
+        if (className == "Windows.UI.Core.CoreWindow" || className == "ApplicationFrameWindow") {
+            return false;
+        }
+
+        return true;
+    }
+}
@@ -0,0 +1,1115 @@
+#ifdef __linux__
+#include "UringBackend.h"
+
+#include <algorithm>
+#include <arpa/inet.h>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include "spdlog/spdlog.h"
+
+namespace v2_taskbar_manager {
+    namespace {
+        // 超时定时器的精度，也是有定时器时等待完成事件的最长时间
+        constexpr std::chrono::milliseconds kTimerTick{250};
+        // 提交队列的深度，写满时先提交再继续
+        constexpr unsigned kQueueDepth = 256;
+        // 接收缓冲区环的缓冲区数量（必须是 2 的幂）与单个缓冲区的大小，由事件循环的所有连接共享
+        constexpr unsigned kBufferCount = 256;
+        constexpr unsigned kBufferSize = 2048;
+        constexpr uint16_t kBufferGroup = 0;
+        // 单次 splice 的上限，不超过管道的默认容量，保证一次送入的数据可以被一次取出
+        constexpr size_t kSpliceChunk = 64 * 1024;
+        // 文件描述符耗尽时暂停接受连接的时长，期间有连接关闭时提前恢复；按定时器刻度检查，实际间隔向上取整到刻度
+        constexpr std::chrono::milliseconds kAcceptRetryDelay{100};
+        // 为监听套接字、io_uring、eventfd、splice 管道、静态文件与日志等保留的文件描述符数
+        constexpr size_t kReservedDescriptors = 64;
+
+        /**
+         * @brief 按进程的文件描述符上限（RLIMIT_NOFILE）限制连接上下文池的容量
+         * @param poolSize 配置的连接上下文池容量
+         * @return size_t 不超过上限减去保留数的容量，至少为 1
+         */
+        size_t LimitPoolToDescriptors(const size_t poolSize) {
+            rlimit limit{};
+            if (getrlimit(RLIMIT_NOFILE, &limit) < 0 || limit.rlim_cur == RLIM_INFINITY ||
+                poolSize + kReservedDescriptors <= limit.rlim_cur) {
+                return poolSize;
+            }
+            const size_t capped = limit.rlim_cur > kReservedDescriptors + 1 ? limit.rlim_cur - kReservedDescriptors : 1;
+            SPDLOG_WARN("连接上下文池容量 {} 超过文件描述符上限 {}，调整为 {}", poolSize, limit.rlim_cur, capped);
+            return capped;
+        }
+
+        /**
+         * @brief 判断接受操作的错误是否因为文件描述符或内核内存耗尽
+         * @param error 取反之后的 cqe.res
+         * @return bool 是否需要暂停接受连接：这些错误不会从监听队列中取走连接，立即重新提交只会空转
+         */
+        bool IsDescriptorShortage(const int error) {
+            return error == EMFILE || error == ENFILE || error == ENOBUFS || error == ENOMEM;
+        }
+
+        /**
+         * @brief 读取监听队列中已完成握手、等待被接受的连接数
+         * @param socket 监听套接字
+         * @return size_t 监听状态的套接字在 tcpi_unacked 中报告当前的接受队列长度
+         */
+        size_t ListenBacklog(const int socket) {
+            tcp_info info{};
+            socklen_t length = sizeof(info);
+            if (socket < 0 || getsockopt(socket, IPPROTO_TCP, TCP_INFO, &info, &length) < 0) {
+                return 0;
+            }
+            return info.tcpi_unacked;
+        }
+
+        /**
+         * @brief 以 503 响应拒绝一个新连接并关闭
+         * @param socket 刚接受的连接
+         * @param response 处理器预先生成的 503 响应
+         * @note 先读走已经到达的请求数据：关闭时接收队列中留有数据会使内核发送 RST，客户端可能收不到响应
+         */
+        void RejectConnection(const int socket, std::string_view response) {
+            char discard[2048];
+            for (int i = 0; i < 4 && recv(socket, discard, sizeof(discard), MSG_DONTWAIT) > 0; i++) {
+            }
+            send(socket, response.data(), response.size(), MSG_DONTWAIT | MSG_NOSIGNAL);
+            shutdown(socket, SHUT_WR);
+            close(socket);
+        }
+    }
+
+    UringBackend::UringContext::~UringContext() {
+        for (const int fd : pipe) {
+            if (fd >= 0) {
+                ::close(fd);
+            }
+        }
+    }
+
+    /**
+     * @brief 从池中取出之后重置上下文的状态
+     * @param acceptSocket 新接受的连接
+     */
+    void UringBackend::UringContext::Reset(const int acceptSocket) {
+        socket = acceptSocket;
+        pending = 0;
+        spliceLength = 0;
+        ioPending = false;
+        pushPending = false;
+        closing = false;
+        closeSubmitted = false;
+        connection.Reset();
+    }
+
+    UringBackend::UringBackend(const HttpRequestHandler &handler, const HttpServerOptions &options)
+        : handler(handler), options(options) {
+    }
+
+    /**
+     * @brief 启动 io_uring 后端
+     * @param port 端口号，为 0 时由系统分配
+     * @return int 实际监听的端口号，失败返回 -1（包括内核不支持 io_uring 或所需特性的情况）
+     * @note 与 EpollBackend 相同：第一个事件循环确定实际端口，其余事件循环通过 SO_REUSEPORT 绑定到同一端口
+     */
+    int UringBackend::Start(const int port) {
+        const size_t workerCount = options.ResolveWorkerThreads();
+        const size_t poolCapacity = (LimitPoolToDescriptors(options.connectionPoolSize) + workerCount - 1) / workerCount;
+        int actualPort = port;
+        for (size_t i = 0; i < workerCount; i++) {
+            auto loop = std::make_unique<EventLoop>(poolCapacity, kTimerTick);
+            actualPort = OpenLoop(*loop, actualPort);
+            loops.push_back(std::move(loop));
+            if (actualPort == -1) {
+                Stop();
+                return -1;
+            }
+        }
+
+        isRunning.store(true);
+        for (const auto &loop : loops) {
+            loop->thread = std::thread(&UringBackend::WorkerThread, this, std::ref(*loop));
+        }
+        SPDLOG_INFO("io_uring Worker 线程数: {}", workerCount);
+        return actualPort;
+    }
+
+    /**
+     * @brief 停止 io_uring 后端
+     * @return HttpShutdownReport 停止所用的时间与连接的关闭情况
+     * @note 通过 eventfd 唤醒每个事件循环，由事件循环自己停止接受并关闭连接，线程在连接全部关闭或到达期限之后结束；
+     * 之后关闭剩余的连接与 io_uring 实例。线程退出时内核取消它提交的所有操作，之后释放缓冲区是安全的
+     */
+    HttpShutdownReport UringBackend::Stop() {
+        const auto start = std::chrono::steady_clock::now();
+        drainDeadline = start + options.drainTimeout;
+        draining.store(true);
+
+        for (const auto &loop : loops) {
+            if (loop->wakeupFd >= 0) {
+                constexpr uint64_t one = 1;
+                [[maybe_unused]] const ssize_t ignored = write(loop->wakeupFd, &one, sizeof(one));
+            }
+        }
+
+        SPDLOG_INFO("等待 Worker 线程结束");
+        HttpShutdownReport report;
+        for (const auto &loop : loops) {
+            if (loop->thread.joinable()) {
+                loop->thread.join();
+            }
+            report.connections += loop->drainConnections;
+            report.aborted += loop->contexts.size();
+            CloseLoop(*loop);
+        }
+        loops.clear();
+        isRunning.store(false);
+        report.duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+        return report;
+    }
+
+    /**
+     * @brief 获取运行时计数器
+     * @return HttpServerStats 所有事件循环的计数器之和
+     */
+    HttpServerStats UringBackend::GetStats() const {
+        HttpServerStats stats;
+        for (const auto &loop : loops) {
+            stats.poolCapacity += loop->pool.Capacity();
+            stats.poolInUse += loop->pool.InUse();
+            stats.poolPeak += loop->pool.Peak();
+            stats.poolExhausted += loop->pool.Exhausted();
+            stats.connectionsRejected += loop->connectionsRejected.load();
+            stats.connectionsDeferred += loop->connectionsDeferred.load();
+            stats.acceptBacklog += ListenBacklog(loop->listenSocket);
+            stats.firstByteTimeouts += loop->timeouts[static_cast<size_t>(HttpWaitPhase::FirstByte)].load();
+            stats.headerTimeouts += loop->timeouts[static_cast<size_t>(HttpWaitPhase::Header)].load();
+            stats.idleTimeouts += loop->timeouts[static_cast<size_t>(HttpWaitPhase::Idle)].load();
+        }
+        return stats;
+    }
+
+    /**
+     * @brief 创建事件循环的监听套接字、唤醒描述符、io_uring 实例与接收缓冲区环
+     * @param loop 事件循环
+     * @param port 端口号，为 0 时由系统分配
+     * @return int 实际监听的端口号，失败返回 -1
+     * @note 套接字保持阻塞模式，由 io_uring 在数据未就绪时内部挂起操作，完成时才产生完成事件
+     */
+    int UringBackend::OpenLoop(EventLoop &loop, const int port) const {
+        loop.listenSocket = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, IPPROTO_TCP);
+        if (loop.listenSocket < 0) {
+            return -1;
+        }
+
+        // 设置套接字选项以允许地址重用，多个事件循环共享同一端口
+        constexpr int reuse = 1;
+        setsockopt(loop.listenSocket, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+        setsockopt(loop.listenSocket, SOL_SOCKET, SO_REUSEPORT, &reuse, sizeof(reuse));
+        // 握手完成之后等到第一段请求数据到达才完成接受，与接受一同提交的接收通常可以立即完成
+        if (options.acceptWithFirstRead) {
+            const int seconds = static_cast<int>(std::max<long long>(
+                std::chrono::duration_cast<std::chrono::seconds>(options.firstByteTimeout).count(), 1));
+            setsockopt(loop.listenSocket, IPPROTO_TCP, TCP_DEFER_ACCEPT, &seconds, sizeof(seconds));
+        }
+
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        address.sin_port = htons(port);
+
+        // 获取实际分配的端口号
+        sockaddr_in actualAddr{};
+        socklen_t len = sizeof(actualAddr);
+        if (bind(loop.listenSocket, reinterpret_cast<sockaddr *>(&address), sizeof(address)) < 0 ||
+            getsockname(loop.listenSocket, reinterpret_cast<sockaddr *>(&actualAddr), &len) < 0 ||
+            listen(loop.listenSocket, SOMAXCONN) < 0) {
+            return -1;
+        }
+
+        loop.wakeupFd = eventfd(0, EFD_CLOEXEC);
+        if (loop.wakeupFd < 0) {
+            return -1;
+        }
+
+        // 每个连接同时最多挂起接收、推送、splice 与关闭四个操作，完成队列按此预留，避免频繁进入溢出路径
+        const auto completionEntries = static_cast<unsigned>(
+            std::max<size_t>(kQueueDepth * 2, loop.pool.Capacity() * 4));
+        if (!SetupRing(loop.ring, kQueueDepth, completionEntries)) {
+            SPDLOG_WARN("io_uring 不可用: {}", std::strerror(errno));
+            return -1;
+        }
+        if (!SetupBuffers(loop)) {
+            SPDLOG_WARN("io_uring 接收缓冲区环注册失败: {}", std::strerror(errno));
+            return -1;
+        }
+
+        loop.acceptOperation.op = UringOperation::OP_ACCEPT;
+        loop.wakeupOperation.op = UringOperation::OP_WAKEUP;
+        loop.timeoutOperation.op = UringOperation::OP_TIMEOUT;
+        loop.timeout.tv_sec = 0;
+        loop.timeout.tv_nsec = std::chrono::duration_cast<std::chrono::nanoseconds>(kTimerTick).count();
+
+        return ntohs(actualAddr.sin_port);
+    }
+
+    /**
+     * @brief 创建 io_uring 实例并映射提交队列与完成队列
+     * @param ring 队列
+     * @param entries 提交队列的深度
+     * @param completionEntries 完成队列的深度
+     * @return 内核不支持 io_uring 或不支持 IORING_FEAT_NODROP 时返回 false
+     */
+    bool UringBackend::SetupRing(Ring &ring, const unsigned entries, const unsigned completionEntries) {
+        io_uring_params params{};
+        params.flags = IORING_SETUP_CQSIZE | IORING_SETUP_CLAMP;
+        params.cq_entries = completionEntries;
+        ring.fd = static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+        if (ring.fd < 0) {
+            return false;
+        }
+        // 完成队列已满时内核暂存完成事件而不是丢弃，连接的操作计数依赖每个操作都有完成事件
+        if (!(params.features & IORING_FEAT_NODROP)) {
+            errno = ENOTSUP;
+            return false;
+        }
+
+        ring.sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        ring.cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        const bool singleMmap = params.features & IORING_FEAT_SINGLE_MMAP;
+        if (singleMmap) {
+            ring.sqRingSize = ring.cqRingSize = std::max(ring.sqRingSize, ring.cqRingSize);
+        }
+
+        void *sqRing = mmap(nullptr, ring.sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                            ring.fd, IORING_OFF_SQ_RING);
+        if (sqRing == MAP_FAILED) {
+            return false;
+        }
+        ring.sqRing = sqRing;
+        if (singleMmap) {
+            ring.cqRing = sqRing;
+        } else {
+            void *cqRing = mmap(nullptr, ring.cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                                ring.fd, IORING_OFF_CQ_RING);
+            if (cqRing == MAP_FAILED) {
+                return false;
+            }
+            ring.cqRing = cqRing;
+        }
+        ring.sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+        void *sqes = mmap(nullptr, ring.sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                          ring.fd, IORING_OFF_SQES);
+        if (sqes == MAP_FAILED) {
+            return false;
+        }
+        ring.sqes = static_cast<io_uring_sqe *>(sqes);
+
+        auto *sq = static_cast<char *>(ring.sqRing);
+        ring.sqHead = reinterpret_cast<unsigned *>(sq + params.sq_off.head);
+        ring.sqTail = reinterpret_cast<unsigned *>(sq + params.sq_off.tail);
+        ring.sqArray = reinterpret_cast<unsigned *>(sq + params.sq_off.array);
+        ring.sqMask = *reinterpret_cast<unsigned *>(sq + params.sq_off.ring_mask);
+        ring.sqEntries = params.sq_entries;
+
+        auto *cq = static_cast<char *>(ring.cqRing);
+        ring.cqHead = reinterpret_cast<unsigned *>(cq + params.cq_off.head);
+        ring.cqTail = reinterpret_cast<unsigned *>(cq + params.cq_off.tail);
+        ring.cqMask = *reinterpret_cast<unsigned *>(cq + params.cq_off.ring_mask);
+        ring.cqes = reinterpret_cast<io_uring_cqe *>(cq + params.cq_off.cqes);
+        return true;
+    }
+
+    /**
+     * @brief 分配接收缓冲区并以缓冲区环的形式注册到内核
+     * @param loop 事件循环
+     * @return 内核不支持 IORING_REGISTER_PBUF_RING（5.19 之前）时返回 false
+     * @note 接收操作提交时不指定缓冲区，数据到达时内核才从环中取出一个，空闲连接不占用接收缓冲区
+     */
+    bool UringBackend::SetupBuffers(EventLoop &loop) {
+        loop.bufferRingSize = kBufferCount * sizeof(io_uring_buf);
+        void *bufferRing = mmap(nullptr, loop.bufferRingSize, PROT_READ | PROT_WRITE,
+                                MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (bufferRing == MAP_FAILED) {
+            return false;
+        }
+        loop.bufferRing = static_cast<io_uring_buf_ring *>(bufferRing);
+        void *buffers = mmap(nullptr, kBufferCount * kBufferSize, PROT_READ | PROT_WRITE,
+                             MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (buffers == MAP_FAILED) {
+            return false;
+        }
+        loop.buffers = static_cast<char *>(buffers);
+
+        io_uring_buf_reg registration{};
+        registration.ring_addr = reinterpret_cast<uint64_t>(bufferRing);
+        registration.ring_entries = kBufferCount;
+        registration.bgid = kBufferGroup;
+        if (syscall(__NR_io_uring_register, loop.ring.fd, IORING_REGISTER_PBUF_RING, &registration, 1) < 0) {
+            return false;
+        }
+        for (unsigned i = 0; i < kBufferCount; i++) {
+            RecycleBuffer(loop, static_cast<uint16_t>(i));
+        }
+        return true;
+    }
+
+    /**
+     * @brief 取得下一个空闲的提交队列项
+     * @param ring 队列
+     * @return io_uring_sqe* 已清零的提交队列项
+     * @note 不使用 SQPOLL，内核只在 io_uring_enter 时读取提交队列，因此可以先发布尾指针再填写内容
+     */
+    io_uring_sqe *UringBackend::NextSqe(Ring &ring) {
+        const unsigned tail = *ring.sqTail;
+        if (tail - __atomic_load_n(ring.sqHead, __ATOMIC_ACQUIRE) >= ring.sqEntries) {
+            Enter(ring, 0);
+        }
+        const unsigned index = tail & ring.sqMask;
+        io_uring_sqe *sqe = &ring.sqes[index];
+        std::memset(sqe, 0, sizeof(*sqe));
+        ring.sqArray[index] = index;
+        __atomic_store_n(ring.sqTail, tail + 1, __ATOMIC_RELEASE);
+        ring.unsubmitted++;
+        return sqe;
+    }
+
+    /**
+     * @brief 提交所有尚未提交的操作，并等待完成事件
+     * @param ring 队列
+     * @param waitCount 至少等待的完成事件数，为 0 时只提交
+     * @return int io_uring_enter 的返回值，失败返回 -1 并设置 errno
+     */
+    int UringBackend::Enter(Ring &ring, const unsigned waitCount) {
+        if (ring.unsubmitted == 0 && waitCount == 0) {
+            return 0;
+        }
+        const unsigned flags = waitCount > 0 ? IORING_ENTER_GETEVENTS : 0;
+        const auto result = static_cast<int>(
+            syscall(__NR_io_uring_enter, ring.fd, ring.unsubmitted, waitCount, flags, nullptr, 0));
+        if (result > 0) {
+            ring.unsubmitted -= std::min(ring.unsubmitted, static_cast<unsigned>(result));
+        }
+        return result;
+    }
+
+    /**
+     * @brief 把接收缓冲区归还到缓冲区环
+     * @param loop 事件循环
+     * @param bufferId 缓冲区编号
+     */
+    void UringBackend::RecycleBuffer(EventLoop &loop, const uint16_t bufferId) {
+        // 环的首项与 tail 共享同一位置；内核头文件的柔性数组在 C++ 中会多出一个空结构体的偏移，因此直接按 io_uring_buf 数组访问
+        io_uring_buf &buffer = reinterpret_cast<io_uring_buf *>(loop.bufferRing)[loop.bufferTail & (kBufferCount - 1)];
+        buffer.addr = reinterpret_cast<uint64_t>(loop.buffers + static_cast<size_t>(bufferId) * kBufferSize);
+        buffer.len = kBufferSize;
+        buffer.bid = bufferId;
+        loop.bufferTail++;
+        __atomic_store_n(&loop.bufferRing->tail, loop.bufferTail, __ATOMIC_RELEASE);
+    }
+
+    /**
+     * @brief 提交多次接受操作，每个新连接产生一个完成事件，直到被取消或出错
+     * @param loop 事件循环
+     */
+    void UringBackend::ArmAccept(EventLoop &loop) {
+        io_uring_sqe *sqe = NextSqe(loop.ring);
+        sqe->opcode = IORING_OP_ACCEPT;
+        sqe->fd = loop.listenSocket;
+        sqe->ioprio = IORING_ACCEPT_MULTISHOT;
+        sqe->accept_flags = SOCK_CLOEXEC;
+        sqe->user_data = reinterpret_cast<uint64_t>(&loop.acceptOperation);
+        loop.acceptArmed = true;
+    }
+
+    /**
+     * @brief 提交对唤醒描述符的读取，其他线程写入 eventfd 时完成
+     * @param loop 事件循环
+     */
+    void UringBackend::ArmWakeup(EventLoop &loop) {
+        io_uring_sqe *sqe = NextSqe(loop.ring);
+        sqe->opcode = IORING_OP_READ;
+        sqe->fd = loop.wakeupFd;
+        sqe->addr = reinterpret_cast<uint64_t>(&loop.wakeupValue);
+        sqe->len = sizeof(loop.wakeupValue);
+        sqe->user_data = reinterpret_cast<uint64_t>(&loop.wakeupOperation);
+    }
+
+    /**
+     * @brief 提交一个时间轮刻度的超时操作，使有定时器时等待不会无限期阻塞
+     * @param loop 事件循环
+     */
+    void UringBackend::ArmTimeout(EventLoop &loop) {
+        io_uring_sqe *sqe = NextSqe(loop.ring);
+        sqe->opcode = IORING_OP_TIMEOUT;
+        sqe->addr = reinterpret_cast<uint64_t>(&loop.timeout);
+        sqe->len = 1;
+        sqe->user_data = reinterpret_cast<uint64_t>(&loop.timeoutOperation);
+        loop.timeoutArmed = true;
+    }
+
+    /**
+     * @brief 取消一个挂起的操作，被取消的操作以 -ECANCELED 完成
+     * @param loop 事件循环
+     * @param operation 要取消的操作
+     * @note 取消操作自身的 user_data 为 0，其完成事件被忽略
+     */
+    void UringBackend::SubmitCancel(EventLoop &loop, const UringOperation &operation) {
+        io_uring_sqe *sqe = NextSqe(loop.ring);
+        sqe->opcode = IORING_OP_ASYNC_CANCEL;
+        sqe->addr = reinterpret_cast<uint64_t>(&operation);
+        sqe->user_data = 0;
+    }
+
+    /**
+     * @brief 处理一个完成事件
+     * @param loop 事件循环
+     * @param cqe 完成事件的副本，完成队列的位置已经归还给内核
+     */
+    void UringBackend::HandleCompletion(EventLoop &loop, const io_uring_cqe &cqe) {
+        const auto *operation = reinterpret_cast<const UringOperation *>(cqe.user_data);
+        if (operation == nullptr) {
+            return;
+        }
+        switch (operation->op) {
+            case UringOperation::OP_ACCEPT:
+                HandleAccept(loop, cqe);
+                break;
+            case UringOperation::OP_WAKEUP:
+                FlushReadySessions(loop);
+                if (isRunning) {
+                    ArmWakeup(loop);
+                }
+                break;
+            case UringOperation::OP_TIMEOUT:
+                // 到期的连接在每轮循环末尾统一处理
+                loop.timeoutArmed = false;
+                break;
+            default:
+                HandleContextCompletion(loop, operation->context, operation->op, cqe);
+                break;
+        }
+    }
+
+    /**
+     * @brief 处理多次接受操作的完成事件
+     * @param loop 事件循环
+     * @param cqe 完成事件，res 为新连接的套接字
+     * @note 池耗尽时按过载策略处理：Reject 以 503 拒绝这个连接并保持多次接受；
+     * Defer 暂存这个连接并取消多次接受，之后的连接留在监听队列中，直到有连接上下文归还，
+     * 取消生效之前内核可能已经接受了更多连接，它们无处存放，只能以 503 拒绝。
+     * 文件描述符耗尽时同样暂停，等有连接关闭或 kAcceptRetryDelay 之后再重新提交
+     */
+    void UringBackend::HandleAccept(EventLoop &loop, const io_uring_cqe &cqe) {
+        if (!(cqe.flags & IORING_CQE_F_MORE)) {
+            loop.acceptArmed = false;
+        }
+        // 取消生效之前接受的连接在停止期间不再处理
+        if (loop.draining) {
+            if (cqe.res >= 0) {
+                close(cqe.res);
+            }
+            return;
+        }
+        if (cqe.res >= 0) {
+            const bool reject = options.overloadPolicy == HttpOverloadPolicy::Reject;
+            UringContext *context = loop.acceptPaused ? nullptr : loop.pool.Acquire(options);
+            if (context != nullptr) {
+                OpenContext(loop, context, cqe.res);
+            } else if (!reject && loop.parkedSocket < 0) {
+                loop.parkedSocket = cqe.res;
+            } else {
+                RejectConnection(cqe.res, handler.OverloadedResponse());
+                loop.connectionsRejected.fetch_add(1, std::memory_order_relaxed);
+            }
+            if (context == nullptr && !reject && !loop.acceptPaused) {
+                loop.connectionsDeferred.fetch_add(1, std::memory_order_relaxed);
+                loop.acceptPaused = true;
+                if (loop.acceptArmed) {
+                    SubmitCancel(loop, loop.acceptOperation);
+                }
+            }
+        } else if (IsDescriptorShortage(-cqe.res) && !loop.acceptPaused) {
+            SPDLOG_WARN("接受连接失败: {}，暂停 {} 毫秒", std::strerror(-cqe.res), kAcceptRetryDelay.count());
+            loop.acceptPaused = true;
+            loop.acceptRetryAt = std::chrono::steady_clock::now() + kAcceptRetryDelay;
+            if (loop.acceptArmed) {
+                SubmitCancel(loop, loop.acceptOperation);
+            }
+        }
+        if (!loop.acceptArmed && !loop.acceptPaused && isRunning) {
+            ArmAccept(loop);
+        }
+    }
+
+    /**
+     * @brief 用新接受的连接初始化连接上下文，并提交第一个接收
+     * @param loop 事件循环
+     * @param context 从池中取出的连接上下文
+     * @param socket 新接受的连接
+     */
+    void UringBackend::OpenContext(EventLoop &loop, UringContext *context, const int socket) {
+        context->Reset(socket);
+        loop.contexts.insert(context);
+        SubmitRecv(loop, context);
+    }
+
+    /**
+     * @brief 处理连接上的操作的完成事件
+     * @param loop 事件循环
+     * @param context 连接上下文
+     * @param op 操作类型
+     * @param cqe 完成事件
+     * @note 与 IOCP 后端的 OnCompleted 对应：正在关闭的连接只做计数，所有操作完成之后才提交关闭
+     */
+    void UringBackend::HandleContextCompletion(EventLoop &loop, UringContext *context, const int op,
+                                               const io_uring_cqe &cqe) {
+        if (op == UringOperation::OP_CLOSE) {
+            // 与发送链接的关闭在发送失败时以 -ECANCELED 完成，套接字仍需关闭
+            if (cqe.res < 0) {
+                close(context->socket);
+            }
+            context->socket = -1;
+            ReleaseContext(loop, context);
+            return;
+        }
+
+        context->pending--;
+        if (op == UringOperation::OP_RECV || op == UringOperation::OP_SEND) {
+            context->ioPending = false;
+        } else if (op == UringOperation::OP_PUSH) {
+            context->pushPending = false;
+        }
+        const char *data = nullptr;
+        uint16_t bufferId = 0;
+        if (op == UringOperation::OP_RECV && cqe.flags & IORING_CQE_F_BUFFER) {
+            bufferId = static_cast<uint16_t>(cqe.flags >> IORING_CQE_BUFFER_SHIFT);
+            data = loop.buffers + static_cast<size_t>(bufferId) * kBufferSize;
+        }
+
+        if (context->closing) {
+            if (data != nullptr) {
+                RecycleBuffer(loop, bufferId);
+            }
+            if (context->pending == 0 && !context->closeSubmitted) {
+                SubmitClose(loop, context);
+            }
+            return;
+        }
+
+        switch (op) {
+            case UringOperation::OP_RECV: {
+                // 所有接收缓冲区都在使用中，重新提交等待缓冲区归还
+                if (cqe.res == -ENOBUFS) {
+                    SubmitRecv(loop, context);
+                    return;
+                }
+                if (cqe.res < 0) {
+                    CloseContext(loop, context);
+                    return;
+                }
+                // 连接状态机会拷贝或解析完数据，处理之后缓冲区即可归还
+                const HttpAction action = context->connection.OnReceived(data, static_cast<size_t>(cqe.res), handler);
+                if (data != nullptr) {
+                    RecycleBuffer(loop, bufferId);
+                }
+                Dispatch(loop, context, action);
+                break;
+            }
+            case UringOperation::OP_SPLICE:
+                // 文件到管道的 splice 失败时，与它链接的发送以 -ECANCELED 完成并关闭连接
+                break;
+            case UringOperation::OP_SEND:
+                if (cqe.res <= 0 ||
+                    (context->spliceLength > 0 && static_cast<size_t>(cqe.res) < context->spliceLength)) {
+                    CloseContext(loop, context);
+                    return;
+                }
+                Dispatch(loop, context, context->connection.OnSent(static_cast<size_t>(cqe.res), handler));
+                break;
+            case UringOperation::OP_PUSH: {
+                if (cqe.res < 0) {
+                    CloseContext(loop, context);
+                    return;
+                }
+                StreamSession *session = context->connection.Stream();
+                if (session->OnWritten(static_cast<size_t>(cqe.res))) {
+                    SubmitPush(loop, context);
+                } else if (session->IsCloseSent()) {
+                    // 最后的数据（回复对端的 Close 帧、积压过多的事件流的结尾）发送完毕之后关闭连接
+                    CloseContext(loop, context);
+                }
+                break;
+            }
+            default:
+                break;
+        }
+    }
+
+    /**
+     * @brief 提交接收操作，由内核在数据到达时从缓冲区环中选取缓冲区
+     * @param loop 事件循环
+     * @param context 连接上下文
+     * @note 每次等待请求数据都按连接所处阶段重新设置截止时间；推送连接不受等待请求的超时约束。
+     * 连接状态机一次处理一个请求，与 IOCP 一样使用单次接收而不是多次接收
+     */
+    void UringBackend::SubmitRecv(EventLoop &loop, UringContext *context) {
+        if (context->connection.Stream() == nullptr) {
+            loop.timers.Schedule(&context->timer, context->connection.ReceiveDeadline());
+        }
+        io_uring_sqe *sqe = NextSqe(loop.ring);
+        sqe->opcode = IORING_OP_RECV;
+        sqe->fd = context->socket;
+        sqe->len = kBufferSize;
+        sqe->flags = IOSQE_BUFFER_SELECT;
+        sqe->buf_group = kBufferGroup;
+        sqe->user_data = reinterpret_cast<uint64_t>(&context->io);
+        context->io.op = UringOperation::OP_RECV;
+        context->ioPending = true;
+        context->pending++;
+    }
+
+    /**
+     * @brief 提交响应的发送
+     * @param loop 事件循环
+     * @param context 连接上下文
+     * @note 头部与内存中的正文以 sendmsg 一次发送，MSG_WAITALL 使内核发送完所有数据才完成；
+     * 不保持连接的最后一个响应与关闭操作链接提交，发送完成后内核直接关闭套接字，不需要再回到用户态提交。
+     * 资源目录中的大文件以两个链接的 splice 经管道从页缓存送入套接字，不经过用户态
+     */
+    void UringBackend::SubmitSend(EventLoop &loop, UringContext *context) {
+        loop.timers.Cancel(&context->timer);
+
+        std::string_view pending[2];
+        const size_t count = context->connection.PendingBuffers(pending);
+        if (count > 0) {
+            size_t bytes = 0;
+            for (size_t i = 0; i < count; i++) {
+                context->sendVectors[i].iov_base = const_cast<char *>(pending[i].data());
+                context->sendVectors[i].iov_len = pending[i].size();
+                bytes += pending[i].size();
+            }
+            context->message = {};
+            context->message.msg_iov = context->sendVectors;
+            context->message.msg_iovlen = count;
+            context->spliceLength = 0;
+
+            io_uring_sqe *sqe = NextSqe(loop.ring);
+            sqe->opcode = IORING_OP_SENDMSG;
+            sqe->fd = context->socket;
+            sqe->addr = reinterpret_cast<uint64_t>(&context->message);
+            sqe->len = 1;
+            sqe->msg_flags = MSG_NOSIGNAL | MSG_WAITALL;
+            sqe->user_data = reinterpret_cast<uint64_t>(&context->io);
+            context->io.op = UringOperation::OP_SEND;
+            context->ioPending = true;
+            context->pending++;
+
+            if (context->connection.ClosesAfterResponse() && bytes == context->connection.PendingSize()) {
+                sqe->flags |= IOSQE_IO_LINK;
+                context->closing = true;
+                context->connection.Close();
+                SubmitClose(loop, context);
+            }
+            return;
+        }
+
+        uint64_t offset = 0;
+        size_t length = 0;
+        const StaticFile *file = context->connection.PendingFile(offset, length);
+        if (file == nullptr || (context->pipe[0] < 0 && pipe2(context->pipe, O_CLOEXEC) < 0)) {
+            CloseContext(loop, context);
+            return;
+        }
+        const auto chunk = static_cast<unsigned>(std::min(length, kSpliceChunk));
+        context->spliceLength = chunk;
+
+        io_uring_sqe *sqe = NextSqe(loop.ring);
+        sqe->opcode = IORING_OP_SPLICE;
+        sqe->fd = context->pipe[1];
+        sqe->off = static_cast<uint64_t>(-1);
+        sqe->splice_fd_in = file->fd;
+        sqe->splice_off_in = offset;
+        sqe->len = chunk;
+        sqe->splice_flags = SPLICE_F_MOVE;
+        sqe->flags = IOSQE_IO_LINK;
+        sqe->user_data = reinterpret_cast<uint64_t>(&context->splice);
+        context->splice.op = UringOperation::OP_SPLICE;
+        context->pending++;
+
+        sqe = NextSqe(loop.ring);
+        sqe->opcode = IORING_OP_SPLICE;
+        sqe->fd = context->socket;
+        sqe->off = static_cast<uint64_t>(-1);
+        sqe->splice_fd_in = context->pipe[0];
+        sqe->splice_off_in = static_cast<uint64_t>(-1);
+        sqe->len = chunk;
+        sqe->splice_flags = SPLICE_F_MOVE;
+        sqe->user_data = reinterpret_cast<uint64_t>(&context->io);
+        context->io.op = UringOperation::OP_SEND;
+        context->ioPending = true;
+        context->pending++;
+    }
+
+    /**
+     * @brief 提交推送会话中尚未发送的数据
+     * @param loop 事件循环
+     * @param context 连接上下文，本线程已是会话的发送者
+     */
+    void UringBackend::SubmitPush(EventLoop &loop, UringContext *context) {
+        const std::string_view unsent = context->connection.Stream()->Unsent();
+        io_uring_sqe *sqe = NextSqe(loop.ring);
+        sqe->opcode = IORING_OP_SEND;
+        sqe->fd = context->socket;
+        sqe->addr = reinterpret_cast<uint64_t>(unsent.data());
+        sqe->len = static_cast<uint32_t>(unsent.size());
+        sqe->msg_flags = MSG_NOSIGNAL | MSG_WAITALL;
+        sqe->user_data = reinterpret_cast<uint64_t>(&context->push);
+        context->push.op = UringOperation::OP_PUSH;
+        context->pushPending = true;
+        context->pending++;
+    }
+
+    /**
+     * @brief 根据连接状态机给出的动作提交下一个操作
+     * @param loop 事件循环
+     * @param context 连接上下文
+     * @param action 下一个动作
+     */
+    void UringBackend::Dispatch(EventLoop &loop, UringContext *context, const HttpAction action) {
+        switch (action) {
+            case HttpAction::Receive:
+                // 停止期间响应发送完毕的连接不再等待下一个请求
+                if (loop.draining) {
+                    CloseContext(loop, context);
+                } else {
+                    SubmitRecv(loop, context);
+                }
+                break;
+            case HttpAction::Send:
+                SubmitSend(loop, context);
+                break;
+            case HttpAction::Upgrade:
+                UpgradeContext(loop, context);
+                break;
+            case HttpAction::Close:
+                CloseContext(loop, context);
+                break;
+            case HttpAction::Wait:
+                WaitReply(loop, context);
+                break;
+        }
+    }
+
+    /**
+     * @brief 握手响应（或事件流的响应头）发送完毕后把连接切换为推送连接
+     * @param loop 事件循环
+     * @param context 连接上下文
+     * @note 订阅时排队的数据通过唤醒路径发送，接收操作与推送操作同时挂起
+     */
+    void UringBackend::UpgradeContext(EventLoop &loop, UringContext *context) {
+        loop.timers.Cancel(&context->timer);
+        context->connection.Stream()->Subscribe(context, [&loop](StreamSession &session) {
+            {
+                std::lock_guard lock(loop.readyMutex);
+                loop.readySessions.push_back(session.shared_from_this());
+            }
+            constexpr uint64_t one = 1;
+            [[maybe_unused]] const ssize_t ignored = write(loop.wakeupFd, &one, sizeof(one));
+        });
+        SubmitRecv(loop, context);
+    }
+
+    /**
+     * @brief 等待其他线程完成 API 响应，期间不提交任何操作
+     * @param loop 事件循环
+     * @param context 连接上下文
+     * @note 完成的通知与推送会话共用 wakeupFd，超时由时间轮以 503 结束
+     */
+    void UringBackend::WaitReply(EventLoop &loop, UringContext *context) {
+        loop.timers.Schedule(&context->timer, context->connection.ReplyDeadline());
+        const bool watching = context->connection.Reply()->Watch(context, [&loop](HttpApiReply &reply) {
+            {
+                std::lock_guard lock(loop.readyMutex);
+                loop.readyReplies.push_back(reply.shared_from_this());
+            }
+            constexpr uint64_t one = 1;
+            [[maybe_unused]] const ssize_t ignored = write(loop.wakeupFd, &one, sizeof(one));
+        });
+        // 处理函数返回之后、登记之前已经完成
+        if (!watching) {
+            FinishReply(loop, context);
+        }
+    }
+
+    /**
+     * @brief 发送已完成（或已超时）的 API 响应
+     * @param loop 事件循环
+     * @param context 连接上下文
+     */
+    void UringBackend::FinishReply(EventLoop &loop, UringContext *context) {
+        loop.timers.Cancel(&context->timer);
+        Dispatch(loop, context, context->connection.OnReplied(handler));
+    }
+
+    /**
+     * @brief 为所有被唤醒的推送会话提交推送，发送已完成的 API 响应
+     * @param loop 事件循环
+     * @note 唤醒之后连接可能已经关闭（或 API 响应已经超时），已分离的会话与响应 Owner() 为 nullptr，直接跳过
+     */
+    void UringBackend::FlushReadySessions(EventLoop &loop) {
+        std::vector<std::shared_ptr<StreamSession>> sessions;
+        std::vector<std::shared_ptr<HttpApiReply>> replies;
+        {
+            std::lock_guard lock(loop.readyMutex);
+            sessions.swap(loop.readySessions);
+            replies.swap(loop.readyReplies);
+        }
+        for (const std::shared_ptr<StreamSession> &session : sessions) {
+            auto *context = static_cast<UringContext *>(session->Owner());
+            if (context != nullptr && !context->closing && session->BeginWrite()) {
+                SubmitPush(loop, context);
+            }
+        }
+        for (const std::shared_ptr<HttpApiReply> &reply : replies) {
+            auto *context = static_cast<UringContext *>(reply->Owner());
+            if (context != nullptr && !context->closing) {
+                FinishReply(loop, context);
+            }
+        }
+    }
+
+    /**
+     * @brief 开始关闭连接
+     * @param loop 事件循环
+     * @param context 连接上下文
+     * @note 挂起的接收与推送被取消，全部完成之后再提交关闭，避免关闭后复用的描述符收到旧操作的数据
+     */
+    void UringBackend::CloseContext(EventLoop &loop, UringContext *context) {
+        if (context->closing) {
+            return;
+        }
+        context->closing = true;
+        loop.timers.Cancel(&context->timer);
+        context->connection.Close();
+        if (context->ioPending) {
+            SubmitCancel(loop, context->io);
+        }
+        if (context->pushPending) {
+            SubmitCancel(loop, context->push);
+        }
+        if (context->pending == 0) {
+            SubmitClose(loop, context);
+        }
+    }
+
+    /**
+     * @brief 提交套接字的关闭，完成时归还连接上下文
+     * @param loop 事件循环
+     * @param context 连接上下文
+     */
+    void UringBackend::SubmitClose(EventLoop &loop, UringContext *context) {
+        io_uring_sqe *sqe = NextSqe(loop.ring);
+        sqe->opcode = IORING_OP_CLOSE;
+        sqe->fd = context->socket;
+        sqe->user_data = reinterpret_cast<uint64_t>(&context->close);
+        context->close.op = UringOperation::OP_CLOSE;
+        context->closeSubmitted = true;
+    }
+
+    /**
+     * @brief 把连接上下文归还到池中，接受因池耗尽而暂停时恢复
+     * @param loop 事件循环
+     * @param context 连接上下文
+     * @note 暂存的连接直接复用归还的上下文
+     */
+    void UringBackend::ReleaseContext(EventLoop &loop, UringContext *context) {
+        loop.contexts.erase(context);
+        if (loop.parkedSocket >= 0) {
+            OpenContext(loop, context, loop.parkedSocket);
+            loop.parkedSocket = -1;
+            return;
+        }
+        loop.pool.Release(context);
+        if (loop.acceptPaused && !loop.draining) {
+            loop.acceptPaused = false;
+            loop.acceptRetryAt = {};
+            if (!loop.acceptArmed) {
+                ArmAccept(loop);
+            }
+        }
+    }
+
+    /**
+     * @brief 开始停止事件循环：取消多次接受并关闭监听套接字，关闭等待请求的连接
+     * @param loop 事件循环
+     * @note 正在发送响应的连接在发送完毕后关闭；推送连接在结束标记发送完毕后关闭；
+     * 等待 API 结果的连接不再等待，立即以 503 响应之后关闭
+     */
+    void UringBackend::BeginDrain(EventLoop &loop) {
+        loop.draining = true;
+        loop.drainConnections = loop.contexts.size();
+        if (loop.acceptArmed) {
+            SubmitCancel(loop, loop.acceptOperation);
+        }
+        // 挂起的多次接受持有监听套接字的引用，取消生效之后监听队列中的连接才随套接字一起被重置
+        close(loop.listenSocket);
+        loop.listenSocket = -1;
+        if (loop.parkedSocket >= 0) {
+            close(loop.parkedSocket);
+            loop.parkedSocket = -1;
+        }
+
+        std::vector<UringContext *> waiting;
+        std::vector<UringContext *> replies;
+        for (UringContext *context : loop.contexts) {
+            if (!context->closing && context->connection.Stream() == nullptr && context->ioPending &&
+                context->io.op == UringOperation::OP_RECV) {
+                waiting.push_back(context);
+            } else if (!context->closing && context->connection.Reply() != nullptr) {
+                replies.push_back(context);
+            }
+        }
+        for (UringContext *context : waiting) {
+            CloseContext(loop, context);
+        }
+        for (UringContext *context : replies) {
+            FinishReply(loop, context);
+        }
+    }
+
+    /**
+     * @brief 关闭事件循环中仍然存活的连接以及事件循环自身的描述符与映射
+     * @param loop 事件循环
+     * @note 在工作线程结束之后调用，此时内核已取消该线程提交的所有操作
+     */
+    void UringBackend::CloseLoop(EventLoop &loop) {
+        for (UringContext *context : loop.contexts) {
+            context->connection.Close();
+            if (context->socket >= 0) {
+                close(context->socket);
+                context->socket = -1;
+            }
+            loop.pool.Release(context);
+        }
+        loop.contexts.clear();
+
+        for (int *fd : {&loop.parkedSocket, &loop.listenSocket, &loop.wakeupFd, &loop.ring.fd}) {
+            if (*fd >= 0) {
+                close(*fd);
+                *fd = -1;
+            }
+        }
+        Ring &ring = loop.ring;
+        if (ring.sqes != nullptr) {
+            munmap(ring.sqes, ring.sqesSize);
+        }
+        if (ring.cqRing != nullptr && ring.cqRing != ring.sqRing) {
+            munmap(ring.cqRing, ring.cqRingSize);
+        }
+        if (ring.sqRing != nullptr) {
+            munmap(ring.sqRing, ring.sqRingSize);
+        }
+        ring = Ring{};
+        if (loop.bufferRing != nullptr) {
+            munmap(loop.bufferRing, loop.bufferRingSize);
+            loop.bufferRing = nullptr;
+        }
+        if (loop.buffers != nullptr) {
+            munmap(loop.buffers, kBufferCount * kBufferSize);
+            loop.buffers = nullptr;
+        }
+    }
+
+    /**
+     * @brief 推进时间轮，关闭等待请求数据超时的连接，以 503 结束等待 API 结果超时的连接
+     * @param loop 事件循环
+     * @note 只访问到期的定时器，开销与连接总数无关；超时的 API 响应在推进完毕之后发送，回调中不能重新设置定时器
+     */
+    void UringBackend::CloseExpiredConnections(EventLoop &loop) {
+        std::vector<UringContext *> replies;
+        loop.timers.Advance(std::chrono::steady_clock::now(), [&loop, &replies](TimerNode *node) {
+            auto *context = static_cast<UringContext *>(node->owner);
+            if (context->connection.Reply() != nullptr) {
+                SPDLOG_WARN("API 处理超时");
+                replies.push_back(context);
+                return;
+            }
+            const HttpWaitPhase phase = context->connection.WaitPhase();
+            loop.timeouts[static_cast<size_t>(phase)].fetch_add(1, std::memory_order_relaxed);
+            SPDLOG_DEBUG("连接超时关闭, 阶段: {}", static_cast<int>(phase));
+            CloseContext(loop, context);
+        });
+        for (UringContext *context : replies) {
+            FinishReply(loop, context);
+        }
+    }
+
+    /**
+     * @brief 文件描述符耗尽时的暂停到期后重新提交多次接受
+     * @param loop 事件循环
+     * @note 耗尽可能来自进程中的其他描述符，不一定有连接会关闭，只等待归还的上下文可能一直不恢复
+     */
+    void UringBackend::ResumeAccept(EventLoop &loop) {
+        if (loop.acceptRetryAt == std::chrono::steady_clock::time_point{} ||
+            std::chrono::steady_clock::now() < loop.acceptRetryAt) {
+            return;
+        }
+        loop.acceptRetryAt = {};
+        if (loop.acceptPaused && !loop.draining) {
+            loop.acceptPaused = false;
+            if (!loop.acceptArmed) {
+                ArmAccept(loop);
+            }
+        }
+    }
+
+    void UringBackend::WorkerThread(EventLoop &loop) {
+        ArmAccept(loop);
+        ArmWakeup(loop);
+        while (true) {
+            if (draining.load()) {
+                if (!loop.draining) {
+                    BeginDrain(loop);
+                }
+                if (loop.contexts.empty() || std::chrono::steady_clock::now() >= drainDeadline) {
+                    break;
+                }
+            }
+            // 没有定时器时无需定时唤醒；停止期间每个刻度检查一次期限
+            if (!loop.timeoutArmed &&
+                (loop.timers.Size() > 0 || loop.draining || loop.acceptRetryAt != std::chrono::steady_clock::time_point{})) {
+                ArmTimeout(loop);
+            }
+            // 一次系统调用同时提交上一轮产生的所有操作并等待完成事件
+            if (Enter(loop.ring, 1) < 0 && errno != EINTR && errno != EAGAIN && errno != EBUSY) {
+                SPDLOG_ERROR("io_uring_enter 失败: {}", std::strerror(errno));
+                break;
+            }
+
+            unsigned head = *loop.ring.cqHead;
+            const unsigned tail = __atomic_load_n(loop.ring.cqTail, __ATOMIC_ACQUIRE);
+            while (head != tail) {
+                const io_uring_cqe cqe = loop.ring.cqes[head & loop.ring.cqMask];
+                head++;
+                __atomic_store_n(loop.ring.cqHead, head, __ATOMIC_RELEASE);
+                HandleCompletion(loop, cqe);
+            }
+
+            CloseExpiredConnections(loop);
+            ResumeAccept(loop);
+        }
+    }
+}
+#endif
@@ -268,6 +268,27 @@ namespace v1_taskbar_manager {
         return StringToWString(str);
     }
 
+    /**
+     * @brief 从资源中加载原始字节
+     * @param id 资源ID
+     * @param type 资源类型
+     * @return 资源内容，资源不存在时返回空字符串
+     * @note 用于加载构建时生成的压缩资源等二进制数据，不做编码转换
+     */
+    std::string Utils::LoadBytesFromResource(const int id, const int type) {
+        const HRSRC hRes = FindResource(nullptr,MAKEINTRESOURCE(id), MAKEINTRESOURCE(type));
+        if (hRes == nullptr) {
+            return {};
+        }
+        const DWORD size = SizeofResource(GetModuleHandle(nullptr), hRes);
+        const HGLOBAL hGlobal = LoadResource(GetModuleHandle(nullptr), hRes);
+        if (hGlobal == nullptr) {
+            return {};
+        }
+        const char *data = static_cast<const char *>(LockResource(hGlobal));
+        return data == nullptr ? std::string() : std::string(data, size);
+    }
+
     /**
      * @brief 将端口号保存到Windows注册表
      * @param port 要保存的端口号(1024-65535)
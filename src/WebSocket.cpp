@@ -0,0 +1,198 @@
+#include "WebSocket.h"
+
+namespace v2_taskbar_manager {
+    namespace {
+        // RFC 6455 规定的握手 GUID
+        constexpr std::string_view kHandshakeGuid = "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
+
+        uint32_t RotateLeft(const uint32_t value, const int bits) {
+            return (value << bits) | (value >> (32 - bits));
+        }
+
+        /**
+         * @brief 计算 SHA-1 摘要，只用于生成握手的 Sec-WebSocket-Accept，不用于任何安全目的
+         * @param data 输入数据
+         * @param digest [输出] 20 字节摘要
+         */
+        void Sha1(std::string_view data, unsigned char (&digest)[20]) {
+            uint32_t h[5] = {0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0};
+
+            // 追加 0x80、补零到 56 字节（模 64），再追加 64 位大端的比特长度
+            std::string message(data);
+            const uint64_t bitLength = static_cast<uint64_t>(data.size()) * 8;
+            message.push_back(static_cast<char>(0x80));
+            while (message.size() % 64 != 56) {
+                message.push_back('\0');
+            }
+            for (int i = 7; i >= 0; i--) {
+                message.push_back(static_cast<char>(bitLength >> (i * 8)));
+            }
+
+            for (size_t chunk = 0; chunk < message.size(); chunk += 64) {
+                uint32_t w[80];
+                for (int i = 0; i < 16; i++) {
+                    const auto *p = reinterpret_cast<const unsigned char *>(message.data() + chunk + i * 4);
+                    w[i] = static_cast<uint32_t>(p[0]) << 24 | static_cast<uint32_t>(p[1]) << 16 |
+                           static_cast<uint32_t>(p[2]) << 8 | static_cast<uint32_t>(p[3]);
+                }
+                for (int i = 16; i < 80; i++) {
+                    w[i] = RotateLeft(w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16], 1);
+                }
+
+                uint32_t a = h[0], b = h[1], c = h[2], d = h[3], e = h[4];
+                for (int i = 0; i < 80; i++) {
+                    uint32_t f;
+                    uint32_t k;
+                    if (i < 20) {
+                        f = (b & c) | (~b & d);
+                        k = 0x5A827999;
+                    } else if (i < 40) {
+                        f = b ^ c ^ d;
+                        k = 0x6ED9EBA1;
+                    } else if (i < 60) {
+                        f = (b & c) | (b & d) | (c & d);
+                        k = 0x8F1BBCDC;
+                    } else {
+                        f = b ^ c ^ d;
+                        k = 0xCA62C1D6;
+                    }
+                    const uint32_t temp = RotateLeft(a, 5) + f + e + k + w[i];
+                    e = d;
+                    d = c;
+                    c = RotateLeft(b, 30);
+                    b = a;
+                    a = temp;
+                }
+                h[0] += a;
+                h[1] += b;
+                h[2] += c;
+                h[3] += d;
+                h[4] += e;
+            }
+
+            for (int i = 0; i < 5; i++) {
+                digest[i * 4] = static_cast<unsigned char>(h[i] >> 24);
+                digest[i * 4 + 1] = static_cast<unsigned char>(h[i] >> 16);
+                digest[i * 4 + 2] = static_cast<unsigned char>(h[i] >> 8);
+                digest[i * 4 + 3] = static_cast<unsigned char>(h[i]);
+            }
+        }
+
+        std::string Base64Encode(const unsigned char *data, const size_t length) {
+            constexpr char table[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+            std::string encoded;
+            encoded.reserve((length + 2) / 3 * 4);
+            for (size_t i = 0; i < length; i += 3) {
+                const uint32_t triple = static_cast<uint32_t>(data[i]) << 16 |
+                                        (i + 1 < length ? static_cast<uint32_t>(data[i + 1]) << 8 : 0) |
+                                        (i + 2 < length ? static_cast<uint32_t>(data[i + 2]) : 0);
+                encoded.push_back(table[triple >> 18 & 0x3F]);
+                encoded.push_back(table[triple >> 12 & 0x3F]);
+                encoded.push_back(i + 1 < length ? table[triple >> 6 & 0x3F] : '=');
+                encoded.push_back(i + 2 < length ? table[triple & 0x3F] : '=');
+            }
+            return encoded;
+        }
+    }
+
+    /**
+     * @brief 根据客户端的 Sec-WebSocket-Key 计算握手响应中的 Sec-WebSocket-Accept
+     * @param clientKey Sec-WebSocket-Key 头部的值
+     * @return std::string base64(SHA-1(clientKey + GUID))
+     */
+    std::string WebSocketAcceptKey(std::string_view clientKey) {
+        std::string input(clientKey);
+        input += kHandshakeGuid;
+        unsigned char digest[20];
+        Sha1(input, digest);
+        return Base64Encode(digest, sizeof(digest));
+    }
+
+    /**
+     * @brief 解析缓冲区开头的一个客户端帧，并在原处去除负载的掩码
+     * @param data 接收缓冲区
+     * @param length 缓冲区中的数据长度
+     * @param maxPayload 允许的最大负载
+     * @param frame [输出] 解析结果，负载指向 data
+     * @param consumed [输出] 帧的总长度，只在 Complete 时有效
+     * @return WebSocketParseResult 解析结果
+     * @note 客户端发送的帧必须加掩码；控制帧不能分片，负载不超过 125 字节
+     */
+    WebSocketParseResult ParseWebSocketFrame(char *data, const size_t length, const size_t maxPayload,
+                                             WebSocketFrame &frame, size_t &consumed) {
+        if (length < 2) {
+            return WebSocketParseResult::Incomplete;
+        }
+        const auto *bytes = reinterpret_cast<const unsigned char *>(data);
+        if ((bytes[0] & 0x70) != 0 || (bytes[1] & 0x80) == 0) {
+            return WebSocketParseResult::ProtocolError;
+        }
+        frame.fin = (bytes[0] & 0x80) != 0;
+        frame.opcode = static_cast<WebSocketOpcode>(bytes[0] & 0x0F);
+
+        size_t headerLength = 2;
+        uint64_t payloadLength = bytes[1] & 0x7F;
+        if (payloadLength == 126) {
+            headerLength += 2;
+            if (length < headerLength) {
+                return WebSocketParseResult::Incomplete;
+            }
+            payloadLength = static_cast<uint64_t>(bytes[2]) << 8 | bytes[3];
+        } else if (payloadLength == 127) {
+            headerLength += 8;
+            if (length < headerLength) {
+                return WebSocketParseResult::Incomplete;
+            }
+            payloadLength = 0;
+            for (int i = 0; i < 8; i++) {
+                payloadLength = payloadLength << 8 | bytes[2 + i];
+            }
+        }
+
+        if (static_cast<uint8_t>(frame.opcode) >= 0x8 && (!frame.fin || payloadLength > 125)) {
+            return WebSocketParseResult::ProtocolError;
+        }
+        if (payloadLength > maxPayload) {
+            return WebSocketParseResult::TooLarge;
+        }
+
+        const size_t maskOffset = headerLength;
+        headerLength += 4;
+        if (length < headerLength + payloadLength) {
+            return WebSocketParseResult::Incomplete;
+        }
+
+        char *payload = data + headerLength;
+        const char *mask = data + maskOffset;
+        for (size_t i = 0; i < payloadLength; i++) {
+            payload[i] = static_cast<char>(payload[i] ^ mask[i & 3]);
+        }
+        frame.payload = std::string_view(payload, static_cast<size_t>(payloadLength));
+        consumed = headerLength + static_cast<size_t>(payloadLength);
+        return WebSocketParseResult::Complete;
+    }
+
+    /**
+     * @brief 把一个未分片、不加掩码的服务端帧追加到缓冲区
+     * @param out 输出缓冲区
+     * @param opcode 帧类型
+     * @param payload 负载
+     */
+    void AppendWebSocketFrame(std::string &out, const WebSocketOpcode opcode, std::string_view payload) {
+        out.push_back(static_cast<char>(0x80 | static_cast<uint8_t>(opcode)));
+        const uint64_t length = payload.size();
+        if (length < 126) {
+            out.push_back(static_cast<char>(length));
+        } else if (length <= 0xFFFF) {
+            out.push_back(static_cast<char>(126));
+            out.push_back(static_cast<char>(length >> 8));
+            out.push_back(static_cast<char>(length));
+        } else {
+            out.push_back(static_cast<char>(127));
+            for (int i = 7; i >= 0; i--) {
+                out.push_back(static_cast<char>(length >> (i * 8)));
+            }
+        }
+        out.append(payload.data(), payload.size());
+    }
+}
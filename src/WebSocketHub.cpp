@@ -0,0 +1,277 @@
+#include "WebSocketHub.h"
+
+#include <algorithm>
+
+namespace v2_taskbar_manager {
+    namespace {
+        /**
+         * @brief 以 JSON 字符串字面量的形式追加文本
+         */
+        void AppendJsonString(std::string &out, std::string_view value) {
+            out.push_back('"');
+            for (const char c : value) {
+                if (c == '"' || c == '\\') {
+                    out.push_back('\\');
+                    out.push_back(c);
+                } else if (static_cast<unsigned char>(c) < 0x20) {
+                    constexpr char hex[] = "0123456789abcdef";
+                    out += "\\u00";
+                    out.push_back(hex[c >> 4 & 0xF]);
+                    out.push_back(hex[c & 0xF]);
+                } else {
+                    out.push_back(c);
+                }
+            }
+            out.push_back('"');
+        }
+    }
+
+    WebSocketSession::WebSocketSession(WebSocketHub &hub) : hub(&hub) {
+    }
+
+    /**
+     * @param maxPendingBytes 单个客户端允许积压的控制帧字节数上限
+     */
+    WebSocketHub::WebSocketHub(const size_t maxPendingBytes) : maxPendingBytes(maxPendingBytes) {
+    }
+
+    /**
+     * @brief 排队一个控制帧
+     * @param opcode Pong 或 Close
+     * @param payload 负载，Close 帧为状态码
+     * @return bool 积压的控制帧超过 maxPendingBytes 时返回 false，调用方应关闭连接
+     * @note 控制帧先于尚未发送的变化发送；排队 Close 之后丢弃尚未发送的变化，关闭帧发送完毕后由后端关闭连接
+     */
+    bool WebSocketSession::SendControl(const WebSocketOpcode opcode, std::string_view payload) {
+        std::lock_guard lock(mutex);
+        if (closing) {
+            return true;
+        }
+        if (control.size() + payload.size() > hub->maxPendingBytes) {
+            return false;
+        }
+        AppendWebSocketFrame(control, opcode, payload);
+        if (opcode == WebSocketOpcode::Close) {
+            closing = true;
+            pending.clear();
+            reset = false;
+        }
+        NotifyLocked();
+        return true;
+    }
+
+    /**
+     * @brief 订阅广播中心的变化
+     * @param owner 后端的连接上下文
+     * @param notify 有数据待发送时的回调
+     */
+    void WebSocketSession::Subscribe(void *owner, Notify notify) {
+        hub->Subscribe(*this, owner, std::move(notify));
+    }
+
+    void WebSocketSession::Unsubscribe() {
+        hub->Remove(this);
+    }
+
+    /**
+     * @brief 合并一个变化到尚未发送的队列，调用方持有 mutex
+     * @param key 条目的键
+     * @param type 变化类型
+     * @param value 条目的新值（JSON），删除时为空
+     */
+    void WebSocketSession::Merge(std::string_view key, const ChangeType type, std::string_view value) {
+        auto [it, inserted] = pending.try_emplace(std::string(key));
+        Change &change = it->second;
+        if (inserted) {
+            change.type = type;
+            change.value.assign(value.data(), value.size());
+            return;
+        }
+
+        // 客户端尚未看到前一个变化，两次变化合并为一次
+        hub->coalesced.fetch_add(1, std::memory_order_relaxed);
+        switch (type) {
+            case ChangeType::Remove:
+                if (change.type == ChangeType::Add) {
+                    pending.erase(it);
+                } else {
+                    change.type = ChangeType::Remove;
+                    change.value.clear();
+                }
+                break;
+            case ChangeType::Add:
+                change.type = change.type == ChangeType::Remove ? ChangeType::Update : ChangeType::Add;
+                change.value.assign(value.data(), value.size());
+                break;
+            case ChangeType::Update:
+                if (change.type != ChangeType::Add) {
+                    change.type = ChangeType::Update;
+                }
+                change.value.assign(value.data(), value.size());
+                break;
+        }
+    }
+
+    bool WebSocketSession::HasPendingLocked() const {
+        return !control.empty() || reset || !pending.empty();
+    }
+
+    /**
+     * @brief 把控制帧与合并后的变化编码到 writing，调用方持有 mutex
+     * @note 变化编码为一个文本帧：{"reset":true,"add":[...],"update":[...],"remove":["key",...]}，
+     * 空的部分省略
+     */
+    void WebSocketSession::FillLocked() {
+        writing.swap(control);
+        control.clear();
+        if (closing) {
+            closeInWriting = true;
+            return;
+        }
+        if (!reset && pending.empty()) {
+            return;
+        }
+
+        std::string message = "{";
+        if (reset) {
+            message += "\"reset\":true";
+        }
+        constexpr std::pair<ChangeType, std::string_view> sections[] = {
+            {ChangeType::Add, "\"add\":["}, {ChangeType::Update, "\"update\":["}, {ChangeType::Remove, "\"remove\":["}
+        };
+        for (const auto &[type, prefix] : sections) {
+            bool first = true;
+            for (const auto &[key, change] : pending) {
+                if (change.type != type) {
+                    continue;
+                }
+                if (first) {
+                    message += message.size() > 1 ? "," : "";
+                    message += prefix;
+                    first = false;
+                } else {
+                    message.push_back(',');
+                }
+                if (type == ChangeType::Remove) {
+                    AppendJsonString(message, key);
+                } else {
+                    message += change.value;
+                }
+            }
+            if (!first) {
+                message.push_back(']');
+            }
+        }
+        message.push_back('}');
+        AppendWebSocketFrame(writing, WebSocketOpcode::Text, message);
+
+        reset = false;
+        pending.clear();
+        hub->messages.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void WebSocketSession::ClearLocked() {
+        pending.clear();
+        control.clear();
+    }
+
+    /**
+     * @brief 发布完整的键值集合
+     * @param items 条目的键与 JSON 值
+     * @return size_t 增加、更新、删除的条目数
+     * @note 与上一次发布的集合比较，没有变化时不唤醒任何客户端
+     */
+    size_t WebSocketHub::Publish(std::vector<std::pair<std::string, std::string>> items) {
+        std::unordered_map<std::string, std::string> next;
+        next.reserve(items.size());
+        for (auto &[key, value] : items) {
+            next.emplace(std::move(key), std::move(value));
+        }
+
+        std::lock_guard lock(mutex);
+        struct Diff {
+            std::string_view key;
+            WebSocketSession::ChangeType type;
+            std::string_view value;
+        };
+        // 键与值指向 next 与 state 的节点，交换之后依然有效
+        std::vector<Diff> diffs;
+        for (const auto &[key, value] : next) {
+            if (const auto it = state.find(key); it == state.end()) {
+                diffs.push_back({key, WebSocketSession::ChangeType::Add, value});
+            } else if (it->second != value) {
+                diffs.push_back({key, WebSocketSession::ChangeType::Update, value});
+            }
+        }
+        for (const auto &[key, value] : state) {
+            if (next.find(key) == next.end()) {
+                diffs.push_back({key, WebSocketSession::ChangeType::Remove, {}});
+            }
+        }
+        state.swap(next);
+        if (diffs.empty()) {
+            return 0;
+        }
+
+        for (const std::shared_ptr<WebSocketSession> &session : sessions) {
+            std::lock_guard sessionLock(session->mutex);
+            if (session->closing) {
+                continue;
+            }
+            for (const Diff &diff : diffs) {
+                session->Merge(diff.key, diff.type, diff.value);
+            }
+            session->NotifyLocked();
+        }
+        return diffs.size();
+    }
+
+    /**
+     * @brief 订阅变化，并排队当前完整的集合
+     * @param session 会话，必须由 shared_ptr 管理
+     * @param owner 后端的连接上下文，通知时可以通过 Owner() 取回
+     * @param notify 有数据待发送时的回调，在会话的锁内调用，只能做轻量的唤醒操作
+     */
+    void WebSocketHub::Subscribe(WebSocketSession &session, void *owner, StreamSession::Notify notify) {
+        std::lock_guard lock(mutex);
+        std::lock_guard sessionLock(session.mutex);
+        session.owner = owner;
+        session.notify = std::move(notify);
+        session.reset = true;
+        for (const auto &[key, value] : state) {
+            session.Merge(key, WebSocketSession::ChangeType::Add, value);
+        }
+        sessions.push_back(std::static_pointer_cast<WebSocketSession>(session.shared_from_this()));
+        session.NotifyLocked();
+    }
+
+    /**
+     * @brief 向所有客户端发送 Close 帧（1001 Going Away），服务器停止之前调用
+     * @note 关闭帧发送完毕后由后端关闭连接，尚未发送的变化被丢弃
+     */
+    void WebSocketHub::CloseAll() {
+        std::vector<std::shared_ptr<WebSocketSession>> closing;
+        {
+            std::lock_guard lock(mutex);
+            closing = sessions;
+        }
+        constexpr char goingAway[] = {'\x03', '\xE9'};
+        for (const std::shared_ptr<WebSocketSession> &session : closing) {
+            session->SendControl(WebSocketOpcode::Close, std::string_view(goingAway, sizeof(goingAway)));
+        }
+    }
+
+    size_t WebSocketHub::SessionCount() const {
+        std::lock_guard lock(mutex);
+        return sessions.size();
+    }
+
+    void WebSocketHub::Remove(const WebSocketSession *session) {
+        std::lock_guard lock(mutex);
+        const auto it = std::find_if(sessions.begin(), sessions.end(),
+                                     [session](const auto &item) { return item.get() == session; });
+        if (it != sessions.end()) {
+            sessions.erase(it);
+        }
+    }
+}
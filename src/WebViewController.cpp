@@ -10,13 +10,11 @@
 #include "ShlObj.h"
 #include "Shlwapi.h"
 #include "Utils.h"
-#include "WindowManager.h"
 #include "spdlog/spdlog.h"
 
 namespace v1_taskbar_manager {
-    WebViewController::WebViewController(HWND hWnd, const std::weak_ptr<GlobalHotKeyManager> &globalHotKeyManager,
-                                         int port)
-        : hWnd(hWnd), globalHotKeyManager(globalHotKeyManager), port(port) {
+    WebViewController::WebViewController(HWND hWnd, const CommandDispatcher &commandDispatcher, int port)
+        : hWnd(hWnd), commandDispatcher(commandDispatcher), port(port) {
     }
 
     WebViewController::~WebViewController() {
@@ -206,61 +204,11 @@ namespace v1_taskbar_manager {
         if (cmd == "quit") {
             callback(ResultResponse(id, 10000, "操作成功", nullptr));
             PostQuitMessage(0);
+            return;
         }
-        if (cmd == "getWindows") {
-            const std::vector<WindowInfo> windows = WindowManager::GetTaskbarWindows();
-
-            nlohmann::json data;
-            data["windows"] = nlohmann::json::array();
-            for (const auto &info : windows) {
-                nlohmann::json windowJson;
-                if (std::string title = Utils::WStringToString(info.title); !title.empty()) {
-                    windowJson["title"] = title;
-                } else {
-                    windowJson["title"] = "(无标题)";
-                }
-                windowJson["handle"] = Utils::HWndToHexString(info.hWnd);
-                data["windows"].push_back(windowJson);
-            }
-            callback(ResultResponse(id, 10000, "查询成功", data));
-        }
-        if (cmd == "activateWindow") {
-            const std::string handle = args.value("handle", "");
-            WindowManager::ActivateWindow(handle);
-            callback(ResultResponse(id, 10000, "操作成功", nullptr));
-        }
-        if (cmd == "registerHotkey") {
-            const nlohmann::json hotkey =
-                args.contains("hotkey") ? args["hotkey"] : nlohmann::json(nullptr);
-            const bool ctrl = hotkey.value("ctrl", false);
-            const bool shift = hotkey.value("shift", false);
-            const bool alt = hotkey.value("alt", false);
-            const std::string key = hotkey.value("key", "");
-
-            if (auto ghm = globalHotKeyManager.lock()) {
-                HotKeyRegistrationResult result = ghm->RegisterGlobalHotKey(ctrl, shift, alt, key, [this] {
-                    ShowWindow(this->hWnd, SW_RESTORE);
-                    SetForegroundWindow(this->hWnd);
-                });
-
-                if (result.Success()) {
-                    callback(ResultResponse(id, 10000, "操作成功", nullptr));
-                } else {
-                    // 发送详细的错误信息给webview2
-                    nlohmann::json errorData = {{"errorCode", result.errorCode},
-                                                {"errorMessage", result.errorMessage}};
-                    callback(ResultResponse(id, 20000, result.errorMessage, errorData));
-                }
-            } else {
-                callback(ResultResponse(id, 20000, "全局热键管理器不可用", nullptr));
-            }
-        }
-        if (cmd == "clearHotkey") {
-            if (auto ghm = globalHotKeyManager.lock()) {
-                ghm->UnregisterAll();
-                callback(ResultResponse(id, 10000, "操作成功", nullptr));
-            }
-        }
+        // 其余命令与 HTTP API 共用同一个分发层
+        const CommandResult result = commandDispatcher.Dispatch(cmd, args);
+        callback(ResultResponse(id, result.code, result.msg, result.data));
     }
 
     /**
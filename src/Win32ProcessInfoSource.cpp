@@ -0,0 +1,49 @@
+#ifdef _WIN32
+#include "Win32ProcessInfoSource.h"
+
+#include "Utils.h"
+
+namespace v1_taskbar_manager {
+    /**
+     * @brief 打开进程并读取创建时间与映像名
+     * @param processId 进程 ID
+     * @param info 输出：进程信息，映像名无法读取时为 "Unknown"
+     * @param token 输出：进程句柄
+     * @return bool 进程无法打开或已经退出时返回 false
+     */
+    bool Win32ProcessInfoSource::Open(const std::uint32_t processId, ProcessInfo &info, std::uintptr_t &token) {
+        const HANDLE process = OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION | SYNCHRONIZE, FALSE, processId);
+        if (process == nullptr) {
+            return false;
+        }
+
+        FILETIME creation, exit, kernel, user;
+        if (!GetProcessTimes(process, &creation, &exit, &kernel, &user)) {
+            CloseHandle(process);
+            return false;
+        }
+
+        info.processId = processId;
+        info.creationTime = static_cast<std::uint64_t>(creation.dwHighDateTime) << 32 | creation.dwLowDateTime;
+        info.name = "Unknown";
+        wchar_t path[MAX_PATH];
+        DWORD size = MAX_PATH;
+        if (QueryFullProcessImageName(process, 0, path, &size)) {
+            const std::wstring fullPath(path, size);
+            if (const size_t pos = fullPath.find_last_of(L'\\'); pos != std::wstring::npos) {
+                info.name = Utils::WStringToString(fullPath.substr(pos + 1));
+            }
+        }
+        token = reinterpret_cast<std::uintptr_t>(process);
+        return true;
+    }
+
+    bool Win32ProcessInfoSource::HasExited(const std::uintptr_t token) {
+        return WaitForSingleObject(reinterpret_cast<HANDLE>(token), 0) == WAIT_OBJECT_0;
+    }
+
+    void Win32ProcessInfoSource::Close(const std::uintptr_t token) {
+        CloseHandle(reinterpret_cast<HANDLE>(token));
+    }
+}
+#endif
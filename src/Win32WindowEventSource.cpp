@@ -0,0 +1,110 @@
+#ifdef _WIN32
+#include "Win32WindowEventSource.h"
+
+#include "TaskbarWindows.h"
+#include "spdlog/spdlog.h"
+
+namespace v1_taskbar_manager {
+    Win32WindowEventSource *Win32WindowEventSource::subscriber = nullptr;
+
+    Win32WindowEventSource::~Win32WindowEventSource() {
+        Unsubscribe();
+    }
+
+    /**
+     * @brief 枚举当前的任务栏窗口
+     * @return std::vector<WindowRecord> 按 EnumWindows 的顺序（Z 序）排列
+     */
+    std::vector<WindowRecord> Win32WindowEventSource::Snapshot() {
+        return TaskbarWindows::GetTaskbarWindows(windows, &processes);
+    }
+
+    bool Win32WindowEventSource::Describe(const WindowHandle handle, WindowRecord &record) {
+        return TaskbarWindows::QueryWindow(windows, handle, record, &processes);
+    }
+
+    /**
+     * @brief 安装窗口事件钩子
+     * @param sink 事件的接收者，在 UI 线程上调用
+     * @return bool 所有钩子是否安装成功，失败时不投递任何事件
+     */
+    bool Win32WindowEventSource::Subscribe(Sink sink) {
+        if (subscriber != nullptr && subscriber != this) {
+            SPDLOG_ERROR("已有其他窗口事件源在订阅");
+            return false;
+        }
+        Unsubscribe();
+        // 分成三段，避开 EVENT_OBJECT_LOCATIONCHANGE 等与任务栏无关的高频事件
+        constexpr std::pair<DWORD, DWORD> ranges[] = {
+            {EVENT_OBJECT_CREATE, EVENT_OBJECT_HIDE},
+            {EVENT_OBJECT_NAMECHANGE, EVENT_OBJECT_NAMECHANGE},
+            {EVENT_SYSTEM_MINIMIZESTART, EVENT_SYSTEM_MINIMIZEEND},
+        };
+        for (const auto &[first, last] : ranges) {
+            const HWINEVENTHOOK hook =
+                SetWinEventHook(first, last, nullptr, WinEventProc, 0, 0, WINEVENT_OUTOFCONTEXT);
+            if (hook == nullptr) {
+                SPDLOG_ERROR("安装窗口事件钩子失败: 0x{:X}-0x{:X}", first, last);
+                Unsubscribe();
+                return false;
+            }
+            hooks.push_back(hook);
+        }
+        this->sink = std::move(sink);
+        subscriber = this;
+        return true;
+    }
+
+    void Win32WindowEventSource::Unsubscribe() {
+        for (const HWINEVENTHOOK hook : hooks) {
+            UnhookWinEvent(hook);
+        }
+        hooks.clear();
+        sink = nullptr;
+        if (subscriber == this) {
+            subscriber = nullptr;
+        }
+    }
+
+    /**
+     * @brief 窗口事件钩子的回调，由 UI 线程的消息循环调用
+     * @note 只转发窗口对象本身（OBJID_WINDOW、CHILDID_SELF）的事件；除销毁外只转发顶层窗口的事件，
+     * 窗口销毁之后已经无法判断它是否曾是顶层窗口，由注册表忽略不在模型中的句柄
+     */
+    void CALLBACK Win32WindowEventSource::WinEventProc(HWINEVENTHOOK, const DWORD event, HWND hWnd,
+                                                      const LONG idObject, const LONG idChild, DWORD, DWORD) {
+        if (subscriber == nullptr || !subscriber->sink || hWnd == nullptr || idObject != OBJID_WINDOW ||
+            idChild != CHILDID_SELF) {
+            return;
+        }
+        WindowEventKind kind;
+        switch (event) {
+            case EVENT_OBJECT_CREATE:
+                kind = WindowEventKind::Created;
+                break;
+            case EVENT_OBJECT_DESTROY:
+                kind = WindowEventKind::Destroyed;
+                break;
+            case EVENT_OBJECT_SHOW:
+                kind = WindowEventKind::Shown;
+                break;
+            case EVENT_OBJECT_HIDE:
+                kind = WindowEventKind::Hidden;
+                break;
+            case EVENT_OBJECT_NAMECHANGE:
+                kind = WindowEventKind::NameChanged;
+                break;
+            case EVENT_SYSTEM_MINIMIZESTART:
+            case EVENT_SYSTEM_MINIMIZEEND:
+                kind = WindowEventKind::StateChanged;
+                break;
+            default:
+                return;
+        }
+        if (kind != WindowEventKind::Destroyed && GetAncestor(hWnd, GA_PARENT) != GetDesktopWindow()) {
+            return;
+        }
+        subscriber->sink(WindowEvent{kind, reinterpret_cast<WindowHandle>(hWnd)});
+    }
+}
+#endif
@@ -0,0 +1,106 @@
+#ifdef _WIN32
+#include "Win32WindowSource.h"
+
+#include <vector>
+
+#include "Utils.h"
+
+namespace v1_taskbar_manager {
+    namespace {
+        HWND ToHWnd(const WindowHandle handle) {
+            return reinterpret_cast<HWND>(handle);
+        }
+
+        WindowHandle ToHandle(HWND hWnd) {
+            return reinterpret_cast<WindowHandle>(hWnd);
+        }
+    }
+
+    /**
+     * @brief 按 Z 序枚举顶层窗口
+     * @param visitor 对每个窗口调用，返回 false 时停止枚举
+     * @return bool EnumWindows 失败时返回 false；visitor 主动停止不算失败
+     */
+    bool Win32WindowSource::EnumerateTopLevel(const Visitor &visitor) {
+        SetLastError(0);
+        if (EnumWindows(EnumWindowsProc, reinterpret_cast<LPARAM>(&visitor))) {
+            return true;
+        }
+        // 回调返回 FALSE 时 EnumWindows 也返回 FALSE，此时没有错误码
+        return GetLastError() == 0;
+    }
+
+    bool Win32WindowSource::IsWindow(const WindowHandle handle) {
+        return ::IsWindow(ToHWnd(handle));
+    }
+
+    bool Win32WindowSource::IsVisible(const WindowHandle handle) {
+        return IsWindowVisible(ToHWnd(handle));
+    }
+
+    bool Win32WindowSource::Styles(const WindowHandle handle, std::uint32_t &style, std::uint32_t &exStyle) {
+        SetLastError(0);
+        style = static_cast<std::uint32_t>(GetWindowLong(ToHWnd(handle), GWL_STYLE));
+        exStyle = static_cast<std::uint32_t>(GetWindowLong(ToHWnd(handle), GWL_EXSTYLE));
+        return style != 0 || GetLastError() == 0;
+    }
+
+    WindowHandle Win32WindowSource::Parent(const WindowHandle handle) {
+        return ToHandle(GetParent(ToHWnd(handle)));
+    }
+
+    WindowHandle Win32WindowSource::Owner(const WindowHandle handle) {
+        return ToHandle(GetWindow(ToHWnd(handle), GW_OWNER));
+    }
+
+    WindowHandle Win32WindowSource::Desktop() {
+        return ToHandle(GetDesktopWindow());
+    }
+
+    size_t Win32WindowSource::TitleLength(const WindowHandle handle) {
+        const int length = GetWindowTextLength(ToHWnd(handle));
+        return length > 0 ? static_cast<size_t>(length) : 0;
+    }
+
+    std::string Win32WindowSource::Title(const WindowHandle handle) {
+        const size_t length = TitleLength(handle);
+        if (length == 0) {
+            return {};
+        }
+        std::vector<wchar_t> buffer(length + 1);
+        GetWindowText(ToHWnd(handle), buffer.data(), static_cast<int>(buffer.size()));
+        return Utils::WStringToString(std::wstring(buffer.data()));
+    }
+
+    std::string Win32WindowSource::ClassName(const WindowHandle handle) {
+        wchar_t className[256];
+        if (!GetClassName(ToHWnd(handle), className, sizeof(className) / sizeof(wchar_t))) {
+            return {};
+        }
+        return Utils::WStringToString(className);
+    }
+
+    bool Win32WindowSource::IsMinimized(const WindowHandle handle) {
+        return IsIconic(ToHWnd(handle));
+    }
+
+    bool Win32WindowSource::IsMaximized(const WindowHandle handle) {
+        return IsZoomed(ToHWnd(handle));
+    }
+
+    std::uint32_t Win32WindowSource::ProcessId(const WindowHandle handle) {
+        DWORD processId = 0;
+        GetWindowThreadProcessId(ToHWnd(handle), &processId);
+        return processId;
+    }
+
+    std::string Win32WindowSource::ProcessName(const std::uint32_t processId) {
+        return Utils::WStringToString(Utils::GetProcessName(processId));
+    }
+
+    BOOL CALLBACK Win32WindowSource::EnumWindowsProc(HWND hWnd, const LPARAM lParam) {
+        const auto *visitor = reinterpret_cast<const Visitor *>(lParam);
+        return (*visitor)(ToHandle(hWnd)) ? TRUE : FALSE;
+    }
+}
+#endif
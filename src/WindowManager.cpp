@@ -7,16 +7,15 @@
 
 namespace v1_taskbar_manager {
     /**
-     * @brief 枚举所有任务栏窗口
-     * @return 包含所有任务栏窗口信息的向量
-     * @note 仅枚举可见窗口，且窗口类名不是"ApplicationFrameWindow"的窗口
+     * @brief 把窗口注册表中的窗口转换为页面使用的 JSON
+     * @param record 窗口信息
+     * @return nlohmann::json 包含 title 与 handle，getWindows 与 WebSocket 推送共用
      */
-    std::vector<WindowInfo> WindowManager::GetTaskbarWindows() {
-        std::vector<WindowInfo> windows;
-        if (!EnumWindows(EnumWindowsProc, reinterpret_cast<LPARAM>(&windows))) {
-            SPDLOG_ERROR("枚举窗口失败");
-        }
-        return windows;
+    nlohmann::json WindowManager::WindowToJson(const WindowRecord &record) {
+        nlohmann::json windowJson;
+        windowJson["title"] = record.title.empty() ? "(无标题)" : record.title;
+        windowJson["handle"] = record.handleText;
+        return windowJson;
     }
 
     /**
@@ -34,131 +33,4 @@ namespace v1_taskbar_manager {
 
         SetForegroundWindow(hWnd);
     }
-
-    /**
-     * @brief 判断窗口是否应该在任务栏显示
-     * @param hWnd 窗口句柄
-     * @return 若窗口应该在任务栏显示则返回true，否则返回false
-     * @note 考虑窗口可见性、样式、父窗口等因素
-     */
-    bool WindowManager::ShouldShowInTaskbar(HWND hWnd) {
-        // 基本有效性检查
-        if (!hWnd || !IsWindow(hWnd)) {
-            return false;
-        }
-
-        // 检查窗口是否可见
-        if (!IsWindowVisible(hWnd)) {
-            return false;
-        }
-
-        // 获取窗口样式
-        LONG style = GetWindowLong(hWnd, GWL_STYLE);
-        LONG exStyle = GetWindowLong(hWnd, GWL_EXSTYLE);
-
-        if (style == 0 && GetLastError() != 0) {
-            return false;
-        }
-
-        // 排除工具窗口（除非有 WS_EX_APPWINDOW 样式）
-        if (exStyle & WS_EX_TOOLWINDOW && !(exStyle & WS_EX_APPWINDOW)) {
-            return false;
-        }
-
-        // 排除 NoActivate 窗口（通常是通知、弹出窗口等）
-        if (exStyle & WS_EX_NOACTIVATE) {
-            return false;
-        }
-
-        // 检查是否有父窗口（排除子窗口和拥有者窗口）
-        HWND parent = GetParent(hWnd);
-        HWND owner = GetWindow(hWnd, GW_OWNER);
-
-        if (parent != nullptr && parent != GetDesktopWindow()) {
-            return false;
-        }
-
-        // 如果有拥有者窗口且没有 WS_EX_APPWINDOW 样式，通常不在任务栏显示
-        if (owner != nullptr && !(exStyle & WS_EX_APPWINDOW)) {
-            return false;
-        }
-
-        // 检查窗口是否有标题
-        int titleLength = GetWindowTextLength(hWnd);
-
-        // 如果有 WS_EX_APPWINDOW 样式，即使没有标题也显示
-        if (exStyle & WS_EX_APPWINDOW) {
-            return true;
-        }
-
-        // 必须有标题才显示
-        if (titleLength == 0) {
-            return false;
-        }
-
-        // 排除一些特殊的窗口类
-        wchar_t className[256];
-        GetClassName(hWnd, className, sizeof(className) / sizeof(wchar_t));
-        std::wstring classNameStr(className);
-
-        // 排除一些系统窗口类
-        if (classNameStr == L"Windows.UI.Core.CoreWindow" ||
-            classNameStr == L"ApplicationFrameWindow") {
-            return false;
-        }
-
-        return true;
-    }
-
-    /**
-     * @brief 枚举窗口回调函数，用于获取任务栏窗口信息
-     * @param hWnd 窗口句柄
-     * @param lParam 指向窗口信息向量的指针
-     * @return 继续枚举返回TRUE，停止枚举返回FALSE
-     * @note 内部调用ShouldShowInTaskbar判断是否应包含窗口
-     */
-    BOOL CALLBACK WindowManager::EnumWindowsProc(HWND hWnd, LPARAM lParam) {
-        if (!lParam) {
-            return FALSE;
-        }
-
-        auto *windows = reinterpret_cast<std::vector<WindowInfo> *>(lParam);
-
-        // 检查是否应该在任务栏显示
-        if (!ShouldShowInTaskbar(hWnd)) {
-            return TRUE;
-        }
-
-        WindowInfo info;
-        info.hWnd = hWnd;
-
-        // 获取窗口标题
-        int titleLength = GetWindowTextLength(hWnd);
-        if (titleLength > 0) {
-            std::vector<wchar_t> titleBuffer(titleLength + 1);
-            GetWindowText(hWnd, titleBuffer.data(), titleLength + 1);
-            info.title = std::wstring(titleBuffer.data());
-        } else {
-            info.title = L"(无标题)";
-        }
-
-        // 获取窗口类名
-        wchar_t className[256];
-        if (GetClassName(hWnd, className, sizeof(className) / sizeof(wchar_t))) {
-            info.className = std::wstring(className);
-        }
-
-        // 获取窗口状态
-        info.isVisible = IsWindowVisible(hWnd);
-        info.isMinimized = IsIconic(hWnd);
-        info.isMaximized = IsZoomed(hWnd);
-
-        // 获取进程ID和进程名
-        GetWindowThreadProcessId(hWnd, &info.processId);
-        info.processName = Utils::GetProcessName(info.processId);
-
-        windows->push_back(info);
-
-        return TRUE;
-    }
-}
\ No newline at end of file
+}
@@ -0,0 +1,144 @@
+#include "WindowRegistry.h"
+
+#include "spdlog/spdlog.h"
+
+namespace v1_taskbar_manager {
+    WindowRegistry::WindowRegistry(WindowEventSource &source) : source(source) {
+    }
+
+    WindowRegistry::~WindowRegistry() {
+        Stop();
+    }
+
+    /**
+     * @brief 订阅窗口事件并建立初始模型
+     * @return bool 事件源是否订阅成功，失败时模型只包含启动时的枚举结果
+     * @note 先订阅再枚举，枚举期间发生的变化不会丢失（重复的事件只会重新读取一次窗口）
+     */
+    bool WindowRegistry::Start() {
+        subscribed = source.Subscribe([this](const WindowEvent &event) { OnEvent(event); });
+        if (!subscribed) {
+            SPDLOG_ERROR("订阅窗口事件失败");
+        }
+        Resync();
+        return subscribed;
+    }
+
+    void WindowRegistry::Stop() {
+        if (subscribed) {
+            source.Unsubscribe();
+            subscribed = false;
+        }
+    }
+
+    /**
+     * @brief 按事件源的完整枚举重建模型
+     * @note 保留仍然存在的窗口的先后顺序，新窗口追加在末尾；只有内容变化时版本号才增加
+     */
+    void WindowRegistry::Resync() {
+        std::vector<WindowRecord> snapshot = source.Snapshot();
+        std::unordered_map<WindowHandle, size_t> positions;
+        positions.reserve(snapshot.size());
+        for (size_t i = 0; i < snapshot.size(); i++) {
+            positions.emplace(snapshot[i].handle, i);
+        }
+
+        std::vector<WindowRecord> next;
+        next.reserve(snapshot.size());
+        std::vector<bool> taken(snapshot.size(), false);
+        for (const WindowRecord &window : windows) {
+            if (const auto it = positions.find(window.handle); it != positions.end()) {
+                next.push_back(std::move(snapshot[it->second]));
+                taken[it->second] = true;
+            }
+        }
+        for (size_t i = 0; i < snapshot.size(); i++) {
+            if (!taken[i]) {
+                next.push_back(std::move(snapshot[i]));
+            }
+        }
+
+        if (next == windows) {
+            return;
+        }
+        windows = std::move(next);
+        index.clear();
+        for (size_t i = 0; i < windows.size(); i++) {
+            index.emplace(windows[i].handle, i);
+        }
+        version++;
+    }
+
+    /**
+     * @brief 处理一个窗口事件
+     * @param event 窗口事件
+     * @note 销毁事件直接移除窗口；其他事件重新读取窗口，之后不应显示的窗口（隐藏、失去标题等）被移除
+     */
+    void WindowRegistry::OnEvent(const WindowEvent &event) {
+        events++;
+        if (event.kind == WindowEventKind::Destroyed) {
+            Remove(event.handle);
+        } else {
+            Refresh(event.handle);
+        }
+    }
+
+    /**
+     * @brief 查找模型中的窗口
+     * @param handle 窗口句柄
+     * @return const WindowRecord* 不在模型中时返回 nullptr，指针在下一次变化之前有效
+     */
+    const WindowRecord *WindowRegistry::Find(const WindowHandle handle) const {
+        const auto it = index.find(handle);
+        return it == index.end() ? nullptr : &windows[it->second];
+    }
+
+    /**
+     * @brief 当前列表的列式表示，用于直接序列化
+     * @return const WindowTable& 每个版本只重建一次，在下一次变化之前有效
+     */
+    const WindowTable &WindowRegistry::Table() const {
+        if (tableVersion != version) {
+            table.Clear();
+            table.Reserve(windows.size());
+            for (const WindowRecord &record : windows) {
+                table.Append(record);
+            }
+            tableVersion = version;
+        }
+        return table;
+    }
+
+    void WindowRegistry::Refresh(const WindowHandle handle) {
+        WindowRecord record;
+        if (!source.Describe(handle, record)) {
+            Remove(handle);
+            return;
+        }
+        if (const auto it = index.find(handle); it != index.end()) {
+            if (windows[it->second] != record) {
+                windows[it->second] = std::move(record);
+                version++;
+            }
+            return;
+        }
+        index.emplace(handle, windows.size());
+        windows.push_back(std::move(record));
+        version++;
+    }
+
+    void WindowRegistry::Remove(const WindowHandle handle) {
+        const auto it = index.find(handle);
+        if (it == index.end()) {
+            return;
+        }
+        // 保持其余窗口的先后顺序，之后的窗口位置前移一位
+        const size_t position = it->second;
+        index.erase(it);
+        windows.erase(windows.begin() + static_cast<std::ptrdiff_t>(position));
+        for (size_t i = position; i < windows.size(); i++) {
+            index[windows[i].handle] = i;
+        }
+        version++;
+    }
+}
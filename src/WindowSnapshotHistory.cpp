@@ -0,0 +1,88 @@
+#include "WindowSnapshotHistory.h"
+
+#include <algorithm>
+#include <unordered_map>
+
+namespace v1_taskbar_manager {
+    WindowSnapshotHistory::WindowSnapshotHistory(const size_t capacity) : capacity(std::max<size_t>(capacity, 1)) {
+    }
+
+    /**
+     * @brief 保存返回给客户端的列表
+     * @param version 列表的版本号
+     * @param windows 列表，版本号已经保存过时不重复复制
+     */
+    void WindowSnapshotHistory::Remember(const std::uint64_t version, const std::vector<WindowRecord> &windows) {
+        for (const Snapshot &snapshot : snapshots) {
+            if (snapshot.version == version) {
+                return;
+            }
+        }
+        if (snapshots.size() == capacity) {
+            snapshots.pop_front();
+        }
+        snapshots.push_back(Snapshot{version, windows});
+    }
+
+    /**
+     * @brief 计算从 since 版本到当前列表的变化
+     * @param since 客户端上次看到的版本号
+     * @param current 当前列表
+     * @param delta 输出：变化，在 current 与本对象下一次修改之前有效
+     * @return bool since 版本的快照不在历史中时返回 false，需要返回完整列表
+     * @note 两侧各建立一次句柄索引，时间与窗口数成线性关系
+     */
+    bool WindowSnapshotHistory::Diff(const std::uint64_t since, const std::vector<WindowRecord> &current,
+                                     WindowDelta &delta) const {
+        const auto found = std::find_if(snapshots.begin(), snapshots.end(),
+                                        [since](const Snapshot &snapshot) { return snapshot.version == since; });
+        if (found == snapshots.end()) {
+            return false;
+        }
+        const std::vector<WindowRecord> &previous = found->windows;
+
+        std::unordered_map<WindowHandle, const WindowRecord *> previousByHandle;
+        previousByHandle.reserve(previous.size());
+        for (const WindowRecord &record : previous) {
+            previousByHandle.emplace(record.handle, &record);
+        }
+        std::unordered_map<WindowHandle, bool> currentHandles;
+        currentHandles.reserve(current.size());
+
+        delta.added.clear();
+        delta.changed.clear();
+        delta.removed.clear();
+        for (const WindowRecord &record : current) {
+            currentHandles.emplace(record.handle, true);
+            const auto it = previousByHandle.find(record.handle);
+            if (it == previousByHandle.end()) {
+                delta.added.push_back(&record);
+            } else if (const std::uint32_t fields = ChangedFields(*it->second, record); fields != 0) {
+                delta.changed.push_back(WindowChange{&record, fields});
+            }
+        }
+        for (const WindowRecord &record : previous) {
+            if (currentHandles.find(record.handle) == currentHandles.end()) {
+                delta.removed.push_back(record.handleText);
+            }
+        }
+        return true;
+    }
+
+    std::uint32_t WindowSnapshotHistory::ChangedFields(const WindowRecord &previous, const WindowRecord &current) {
+        std::uint32_t fields = 0;
+        if (previous.title != current.title) {
+            fields |= WindowFieldTitle;
+        }
+        if (previous.className != current.className) {
+            fields |= WindowFieldClassName;
+        }
+        if (previous.processId != current.processId || previous.processName != current.processName) {
+            fields |= WindowFieldProcess;
+        }
+        if (previous.isMinimized != current.isMinimized || previous.isMaximized != current.isMaximized) {
+            fields |= WindowFieldState;
+        }
+        return fields;
+    }
+}
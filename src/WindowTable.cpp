@@ -0,0 +1,136 @@
+#include "WindowTable.h"
+
+#include <cstdio>
+
+namespace v1_taskbar_manager {
+    namespace {
+        // 与 nlohmann::json::dump() 的转义规则一致，输出与 WindowManager::WindowToJson 逐字节相同
+        void AppendJsonString(const std::string_view value, std::string &out) {
+            out.push_back('"');
+            for (const char c : value) {
+                switch (c) {
+                    case '"':
+                        out.append("\\\"");
+                        break;
+                    case '\\':
+                        out.append("\\\\");
+                        break;
+                    case '\b':
+                        out.append("\\b");
+                        break;
+                    case '\f':
+                        out.append("\\f");
+                        break;
+                    case '\n':
+                        out.append("\\n");
+                        break;
+                    case '\r':
+                        out.append("\\r");
+                        break;
+                    case '\t':
+                        out.append("\\t");
+                        break;
+                    default:
+                        if (static_cast<unsigned char>(c) < 0x20) {
+                            char escaped[8];
+                            std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned char>(c));
+                            out.append(escaped);
+                        } else {
+                            out.push_back(c);
+                        }
+                }
+            }
+            out.push_back('"');
+        }
+    }
+
+    void WindowTable::Clear() {
+        handles.clear();
+        processIds.clear();
+        flags.clear();
+        classNames.clear();
+        processNames.clear();
+        titleOffsets.resize(1);
+        titles.clear();
+        strings.Clear();
+    }
+
+    void WindowTable::Reserve(const size_t count) {
+        handles.reserve(count);
+        processIds.reserve(count);
+        flags.reserve(count);
+        classNames.reserve(count);
+        processNames.reserve(count);
+        titleOffsets.reserve(count + 1);
+    }
+
+    /**
+     * @brief 追加一个窗口
+     * @param handle 窗口句柄
+     * @param title UTF-8 标题，为空时序列化为 "(无标题)"
+     * @param className UTF-8 类名，与已有窗口相同时只保存下标
+     * @param processId 进程 ID
+     * @param processName UTF-8 进程名，与已有窗口相同时只保存下标
+     * @param isMinimized 是否最小化
+     * @param isMaximized 是否最大化
+     */
+    void WindowTable::Append(const WindowHandle handle, const std::string_view title, const std::string_view className,
+                             const uint32_t processId, const std::string_view processName, const bool isMinimized,
+                             const bool isMaximized) {
+        handles.push_back(handle);
+        processIds.push_back(processId);
+        flags.push_back(static_cast<uint8_t>((isMinimized ? FlagMinimized : 0) | (isMaximized ? FlagMaximized : 0)));
+        classNames.push_back(strings.Intern(className));
+        processNames.push_back(strings.Intern(processName));
+        titles.append(title);
+        titleOffsets.push_back(static_cast<uint32_t>(titles.size()));
+    }
+
+    void WindowTable::Append(const WindowRecord &record) {
+        Append(record.handle, record.title, record.className, record.processId, record.processName,
+               record.isMinimized, record.isMaximized);
+    }
+
+    /**
+     * @brief 句柄的十六进制文本，与 Utils::HWndToHexString 相同，例如 0x1A2B
+     */
+    std::string WindowTable::HandleText(const size_t row) const {
+        char text[2 + sizeof(WindowHandle) * 2 + 1];
+        const int length = std::snprintf(text, sizeof(text), "0x%llX", static_cast<unsigned long long>(handles[row]));
+        return std::string(text, length);
+    }
+
+    /**
+     * @brief 把一个窗口序列化为页面使用的 JSON，追加到 out
+     * @param row 窗口所在的行
+     * @param out 输出缓冲区
+     * @note 与 WindowManager::WindowToJson(...).dump() 的结果相同：{"handle":"0x1A2B","title":"..."}
+     */
+    void WindowTable::AppendWindowJson(const size_t row, std::string &out) const {
+        // 句柄文本只含十六进制数字，不需要转义，也不生成临时字符串
+        char handle[2 + sizeof(WindowHandle) * 2 + 1];
+        const int length =
+            std::snprintf(handle, sizeof(handle), "0x%llX", static_cast<unsigned long long>(handles[row]));
+        out.append("{\"handle\":\"");
+        out.append(handle, length);
+        out.append("\",\"title\":");
+        const std::string_view title = Title(row);
+        AppendJsonString(title.empty() ? std::string_view("(无标题)") : title, out);
+        out.push_back('}');
+    }
+
+    /**
+     * @brief 把所有窗口序列化为 JSON 数组，追加到 out
+     * @param out 输出缓冲区
+     */
+    void WindowTable::AppendJson(std::string &out) const {
+        out.push_back('[');
+        for (size_t row = 0; row < Size(); row++) {
+            if (row > 0) {
+                out.push_back(',');
+            }
+            AppendWindowJson(row, out);
+        }
+        out.push_back(']');
+    }
+}